@@ -21,6 +21,7 @@
 
 #include "gst_audio_player.h"
 #include "audio_player_stream_handler_impl.h"
+#include "media_cache.h"
 
 namespace {
 constexpr char kInvalidArgument[] = "Invalid argument";
@@ -29,6 +30,14 @@ constexpr char kAudioPreparedEvent[] = "audio.onPrepared";
 constexpr char kAudioSeekCompleteEvent[] = "audio.onSeekComplete";
 constexpr char kAudioCompleteEvent[] = "audio.onComplete";
 constexpr char kAudioLogEvent[] = "audio.onLog";
+constexpr char kCacheDirectoryName[] = "audioplayers_elinux";
+
+const std::map<std::string, GstAudioPlayer::SeekMode> kSeekModes = {
+    {"keyUnit", GstAudioPlayer::SeekMode::kKeyUnit},
+    {"keyUnitSnapBefore", GstAudioPlayer::SeekMode::kKeyUnitSnapBefore},
+    {"keyUnitSnapAfter", GstAudioPlayer::SeekMode::kKeyUnitSnapAfter},
+    {"accurate", GstAudioPlayer::SeekMode::kAccurate},
+};
 
 template <typename T>
 bool GetValueFromEncodableMap(const flutter::EncodableMap* map, const char* key,
@@ -149,6 +158,11 @@ class AudioplayersElinuxPlugin : public flutter::Plugin {
       GetValueFromEncodableMap(arguments, "playbackRate", rate);
       player->SetPlaybackRate(rate);
       result->Success();
+    } else if (method_name == "setPitchCorrection") {
+      bool enabled = true;
+      GetValueFromEncodableMap(arguments, "enabled", enabled);
+      player->SetPitchCorrection(enabled);
+      result->Success();
     } else if (method_name == "setReleaseMode") {
       std::string release_mode = "";
       GetValueFromEncodableMap(arguments, "releaseMode", release_mode);
@@ -169,6 +183,44 @@ class AudioplayersElinuxPlugin : public flutter::Plugin {
       } else {
         result->Success();
       }
+    } else if (method_name == "setSeekMode") {
+      std::string seek_mode;
+      GetValueFromEncodableMap(arguments, "seekMode", seek_mode);
+      auto iter = kSeekModes.find(seek_mode);
+      if (iter == kSeekModes.end()) {
+        result->Error(kInvalidArgument, "Unknown seekMode: " + seek_mode);
+        return;
+      }
+      player->SetSeekMode(iter->second);
+      result->Success();
+    } else if (method_name == "getSeekStats") {
+      auto stats = player->GetSeekStats();
+      flutter::EncodableMap map = {
+          {flutter::EncodableValue("seekCount"),
+           flutter::EncodableValue(stats.seek_count)},
+          {flutter::EncodableValue("coalescedCount"),
+           flutter::EncodableValue(stats.coalesced_count)},
+          {flutter::EncodableValue("lastDuration"),
+           flutter::EncodableValue(stats.last_duration)},
+          {flutter::EncodableValue("maxDuration"),
+           flutter::EncodableValue(stats.max_duration)},
+          {flutter::EncodableValue("totalDuration"),
+           flutter::EncodableValue(stats.total_duration)}};
+      result->Success(flutter::EncodableValue(map));
+    } else if (method_name == "getResourceUsage") {
+      auto usage = player->GetResourceUsage();
+      flutter::EncodableMap map = {
+          {flutter::EncodableValue("queuedBytes"),
+           flutter::EncodableValue(usage.queued_bytes)},
+          {flutter::EncodableValue("queuedBuffers"),
+           flutter::EncodableValue(usage.queued_buffers)},
+          {flutter::EncodableValue("queueCount"),
+           flutter::EncodableValue(usage.queue_count)},
+          {flutter::EncodableValue("streamingThreadCount"),
+           flutter::EncodableValue(usage.streaming_thread_count)},
+          {flutter::EncodableValue("decoder"),
+           flutter::EncodableValue(usage.decoder)}};
+      result->Success(flutter::EncodableValue(map));
     } else if (method_name == "setBalance") {
       double balance = 0;
       GetValueFromEncodableMap(arguments, "balance", balance);
@@ -197,7 +249,56 @@ class AudioplayersElinuxPlugin : public flutter::Plugin {
       const flutter::MethodCall<flutter::EncodableValue>& method_call,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
     const std::string &method_name = method_call.method_name();
-    if (method_name == "setAudioContext") {
+    if (method_name == "setCacheConfig") {
+      const auto* arguments =
+          std::get_if<flutter::EncodableMap>(method_call.arguments());
+      if (!arguments) {
+        result->Error(kInvalidArgument, "No arguments provided.");
+        return;
+      }
+      int64_t max_size = 0;
+      int32_t max_size_int32 = 0;
+      if (GetValueFromEncodableMap(arguments, "maxSize", max_size_int32)) {
+        max_size = max_size_int32;
+      } else {
+        GetValueFromEncodableMap(arguments, "maxSize", max_size);
+      }
+      std::string directory;
+      GetValueFromEncodableMap(arguments, "directory", directory);
+      if (directory.empty()) {
+        directory = MediaCache::GetDefaultDirectory(kCacheDirectoryName);
+      }
+
+      // Applied to the audio players created after this call. The instance
+      // is reused for the same directory
+      if (max_size <= 0) {
+        media_cache_ = nullptr;
+      } else if (media_cache_ && media_cache_->GetDirectory() == directory) {
+        media_cache_->SetMaxSize(max_size);
+      } else {
+        media_cache_ = std::make_shared<MediaCache>(directory, max_size);
+      }
+      result->Success();
+    } else if (method_name == "getCacheStats") {
+      MediaCache::Stats stats;
+      if (media_cache_) {
+        stats = media_cache_->GetStats();
+      }
+      flutter::EncodableMap map = {
+          {flutter::EncodableValue("hitCount"),
+           flutter::EncodableValue(stats.hit_count)},
+          {flutter::EncodableValue("missCount"),
+           flutter::EncodableValue(stats.miss_count)},
+          {flutter::EncodableValue("readBytes"),
+           flutter::EncodableValue(stats.read_bytes)},
+          {flutter::EncodableValue("writtenBytes"),
+           flutter::EncodableValue(stats.written_bytes)},
+          {flutter::EncodableValue("evictionCount"),
+           flutter::EncodableValue(stats.eviction_count)},
+          {flutter::EncodableValue("totalSize"),
+           flutter::EncodableValue(stats.total_size)}};
+      result->Success(flutter::EncodableValue(map));
+    } else if (method_name == "setAudioContext") {
       result->NotImplemented();
     } else if (method_name == "emitLog") {
       result->NotImplemented();
@@ -285,11 +386,13 @@ class AudioplayersElinuxPlugin : public flutter::Plugin {
         event_sinks_[player_id]->Success(flutter::EncodableValue(map));
       });
 
-    auto player =
-        std::make_unique<GstAudioPlayer>(player_id, std::move(player_handler));
+    auto player = std::make_unique<GstAudioPlayer>(
+        player_id, std::move(player_handler), media_cache_);
     audio_players_[player_id] = std::move(player);
   }
 
+  // Declared before the players to outlive them.
+  std::shared_ptr<MediaCache> media_cache_;
   std::map<std::string, std::unique_ptr<GstAudioPlayer>> audio_players_;
   std::map<std::string,
       std::unique_ptr<flutter::EventSink<flutter::EncodableValue>>>
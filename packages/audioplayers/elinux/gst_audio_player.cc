@@ -4,17 +4,32 @@
 
 #include "gst_audio_player.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace {
+// Size of the buffers pushed from a cache entry.
+constexpr int64_t kCacheChunkSize = 64 * 1024;
+
+// Releases the cache entry referenced by a buffer wrapping it
+void ReleaseCacheReader(gpointer data) {
+  delete reinterpret_cast<std::shared_ptr<MediaCache::Reader>*>(data);
+}
+}  // namespace
+
 GstAudioPlayer::GstAudioPlayer(
     const std::string &player_id,
-    std::unique_ptr<AudioPlayerStreamHandler> handler)
+    std::unique_ptr<AudioPlayerStreamHandler> handler,
+    std::shared_ptr<MediaCache> cache)
     : player_id_(player_id),
-    stream_handler_(std::move(handler)) {
+    stream_handler_(std::move(handler)),
+    cache_(std::move(cache)) {
   gst_.playbin = nullptr;
   gst_.bus = nullptr;
   gst_.source = nullptr;
   gst_.panorama = nullptr;
+  gst_.tempoconvert = nullptr;
+  gst_.scaletempo = nullptr;
   gst_.audiobin = nullptr;
   gst_.audiosink = nullptr;
   gst_.panoramasinkpad = nullptr;
@@ -62,11 +77,31 @@ bool GstAudioPlayer::CreatePipeline() {
 
     g_object_set(G_OBJECT(gst_.playbin), "audio-sink", gst_.audiobin, NULL);
     g_object_set(G_OBJECT(gst_.panorama), "method", 1, NULL);
+
+    // Setup pitch correction, which is linked in front of audiopanorama only
+    // while the rate isn't 1.0 so that normal playback pays nothing for it.
+    // $ [audioconvert ! scaletempo !] audiopanorama ! autoaudiosink
+    gst_.tempoconvert = gst_element_factory_make("audioconvert", NULL);
+    gst_.scaletempo = gst_element_factory_make("scaletempo", NULL);
+    if (gst_.tempoconvert && gst_.scaletempo) {
+      gst_bin_add_many(GST_BIN(gst_.audiobin), gst_.tempoconvert,
+                       gst_.scaletempo, NULL);
+      gst_element_link(gst_.tempoconvert, gst_.scaletempo);
+    } else {
+      std::cerr << "Failed to create a scaletempo stage" << std::endl;
+      for (auto* element : {gst_.tempoconvert, gst_.scaletempo}) {
+        if (element) {
+          gst_object_unref(element);
+        }
+      }
+      gst_.tempoconvert = nullptr;
+      gst_.scaletempo = nullptr;
+    }
   }
 
   // Setup source options
   g_signal_connect(gst_.playbin, "source-setup",
-                   G_CALLBACK(GstAudioPlayer::SourceSetup), &gst_.source);
+                   G_CALLBACK(GstAudioPlayer::SourceSetup), this);
 
   // Watch bus messages for one time events
   gst_.bus = gst_pipeline_get_bus(GST_PIPELINE(gst_.playbin));
@@ -78,12 +113,150 @@ bool GstAudioPlayer::CreatePipeline() {
 // static
 void GstAudioPlayer::SourceSetup(GstElement* playbin,
                                  GstElement* source,
-                                 GstElement** p_src) {
+                                 gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+
   // Allow sources from unencrypted / misconfigured connections
   if (g_object_class_find_property(
       G_OBJECT_GET_CLASS(source), "ssl-strict") != 0) {
     g_object_set(G_OBJECT(source), "ssl-strict", FALSE, NULL);
   }
+
+  // Serve the stream from the cache, or store the downloaded bytes to it
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  if (self->cache_reader_) {
+    gst_util_set_object_arg(G_OBJECT(source), "stream-type", "random-access");
+    g_object_set(G_OBJECT(source), "format", GST_FORMAT_BYTES, "size",
+                 static_cast<gint64>(self->cache_reader_->GetSize()), NULL);
+    g_signal_connect(G_OBJECT(source), "need-data",
+                     G_CALLBACK(GstAudioPlayer::CacheNeedDataHandler), self);
+    g_signal_connect(G_OBJECT(source), "seek-data",
+                     G_CALLBACK(GstAudioPlayer::CacheSeekDataHandler), self);
+  } else if (self->cache_writer_) {
+    GstPad* src_pad = gst_element_get_static_pad(source, "src");
+    if (src_pad) {
+      gst_pad_add_probe(src_pad,
+                        static_cast<GstPadProbeType>(
+                            GST_PAD_PROBE_TYPE_BUFFER |
+                            GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM),
+                        GstAudioPlayer::CacheWriteProbe, self, NULL);
+      gst_object_unref(GST_OBJECT(src_pad));
+    }
+  }
+}
+
+// static
+void GstAudioPlayer::CacheNeedDataHandler(GstElement* appsrc, guint length,
+                                          gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  const auto& reader = self->cache_reader_;
+  GstFlowReturn ret;
+  if (!reader || self->cache_read_offset_ >= reader->GetSize()) {
+    g_signal_emit_by_name(appsrc, "end-of-stream", &ret);
+    return;
+  }
+
+  auto size = std::min<int64_t>(kCacheChunkSize,
+                                reader->GetSize() - self->cache_read_offset_);
+  if (length > 0 && length < size) {
+    size = length;
+  }
+
+  // Wrap the memory-mapped file without copying it. The buffer keeps the
+  // entry mapped while it's queued downstream
+  GstBuffer* buffer = gst_buffer_new_wrapped_full(
+      GST_MEMORY_FLAG_READONLY, const_cast<uint8_t*>(reader->GetData()),
+      reader->GetSize(), self->cache_read_offset_, size,
+      new std::shared_ptr<MediaCache::Reader>(reader), ReleaseCacheReader);
+  GST_BUFFER_OFFSET(buffer) = self->cache_read_offset_;
+  g_signal_emit_by_name(appsrc, "push-buffer", buffer, &ret);
+  gst_buffer_unref(buffer);
+
+  self->cache_read_offset_ += size;
+  reader->NotifyRead(size);
+}
+
+// static
+gboolean GstAudioPlayer::CacheSeekDataHandler(GstElement* appsrc,
+                                              guint64 offset,
+                                              gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  if (!self->cache_reader_ ||
+      static_cast<int64_t>(offset) > self->cache_reader_->GetSize()) {
+    return FALSE;
+  }
+  self->cache_read_offset_ = offset;
+  return TRUE;
+}
+
+// static
+GstPadProbeReturn GstAudioPlayer::CacheWriteProbe(GstPad* pad,
+                                                  GstPadProbeInfo* info,
+                                                  gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  auto& writer = self->cache_writer_;
+  if (!writer) {
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  // Range requests after seeking start a new segment in bytes
+  if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    GstEvent* event = GST_PAD_PROBE_INFO_EVENT(info);
+    if (GST_EVENT_TYPE(event) == GST_EVENT_SEGMENT) {
+      const GstSegment* segment;
+      gst_event_parse_segment(event, &segment);
+      if (segment->format == GST_FORMAT_BYTES) {
+        self->cache_write_offset_ = segment->start;
+      }
+    } else if (GST_EVENT_TYPE(event) == GST_EVENT_CAPS) {
+      GstCaps* caps;
+      gst_event_parse_caps(event, &caps);
+      GstStructure* structure = gst_caps_get_structure(caps, 0);
+      if (structure) {
+        writer->SetContentType(gst_structure_get_name(structure));
+      }
+    }
+  } else {
+    if (writer->GetContentLength() < 0) {
+      gint64 length;
+      if (gst_pad_query_duration(pad, GST_FORMAT_BYTES, &length)) {
+        writer->SetContentLength(length);
+      }
+    }
+
+    GstBuffer* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    int64_t offset = GST_BUFFER_OFFSET_IS_VALID(buffer)
+                         ? GST_BUFFER_OFFSET(buffer)
+                         : self->cache_write_offset_;
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      writer->Write(offset, map.data, map.size);
+      gst_buffer_unmap(buffer, &map);
+    }
+    self->cache_write_offset_ = offset + gst_buffer_get_size(buffer);
+  }
+
+  // The writer is released once the entry is committed or discarded, e.g.
+  // for the playlists of adaptive streams
+  if (writer->IsClosed()) {
+    writer = nullptr;
+    return GST_PAD_PROBE_REMOVE;
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+// Must be called while the playbin is in GST_STATE_NULL not to switch the
+// cache entries under the streaming threads. The buffers still queued
+// downstream keep their entries mapped.
+void GstAudioPlayer::ResetCache() {
+  std::lock_guard<std::mutex> lock(mutex_cache_);
+  cache_reader_ = nullptr;
+  cache_writer_ = nullptr;
+  cache_read_offset_ = 0;
+  cache_write_offset_ = 0;
 }
 
 std::string GstAudioPlayer::ParseUri(const std::string& uri) {
@@ -151,28 +324,228 @@ void GstAudioPlayer::Seek(int64_t position) {
   if (!is_initialized_) {
     return;
   }
+  DispatchSeekNotifications();
+
+  // Flushing seeks complete asynchronously only in PAUSED or PLAYING
+  GstState state;
+  gst_element_get_state(gst_.playbin, &state, NULL, 0);
+  if (state >= GST_STATE_PAUSED) {
+    std::unique_lock<std::mutex> lock(mutex_seek_);
+    // Coalesces rapid successive seeks so that only the latest target is
+    // executed after the ongoing seek. They're notified once the seeking
+    // finishes.
+    if (is_seeking_) {
+      if (pending_seek_position_ >= 0) {
+        seek_stats_.coalesced_count++;
+      }
+      pending_seek_position_ = position;
+      coalesced_seek_count_++;
+      return;
+    }
+    is_seeking_ = true;
+    seek_start_time_ = std::chrono::steady_clock::now();
+  }
+
+  if (!ExecuteSeek(position)) {
+    std::lock_guard<std::mutex> lock(mutex_seek_);
+    FinishSeekingLocked();
+    return;
+  }
+  stream_handler_->OnNotifySeekCompleted(player_id_);
+}
+
+GstAudioPlayer::SeekStats GstAudioPlayer::GetSeekStats() {
+  std::lock_guard<std::mutex> lock(mutex_seek_);
+  return seek_stats_;
+}
+
+GstAudioPlayer::ResourceUsage GstAudioPlayer::GetResourceUsage() {
+  ResourceUsage usage;
+  usage.streaming_thread_count = streaming_thread_count_;
+  if (!gst_.playbin) {
+    return usage;
+  }
+
+  // The levels of multiqueue are per pad and aren't exposed as properties, so
+  // only queue and queue2 are accounted.
+  auto* iterator = gst_bin_iterate_recurse(GST_BIN(gst_.playbin));
+  GValue item = G_VALUE_INIT;
+  bool done = false;
+  while (!done) {
+    switch (gst_iterator_next(iterator, &item)) {
+      case GST_ITERATOR_OK: {
+        auto* element = GST_ELEMENT(g_value_get_object(&item));
+        auto* klass = G_OBJECT_GET_CLASS(element);
+        if (g_object_class_find_property(klass, "current-level-bytes") &&
+            g_object_class_find_property(klass, "current-level-buffers")) {
+          guint bytes = 0;
+          guint buffers = 0;
+          g_object_get(element, "current-level-bytes", &bytes,
+                       "current-level-buffers", &buffers, NULL);
+          usage.queued_bytes += bytes;
+          usage.queued_buffers += buffers;
+          usage.queue_count++;
+        }
+        auto* factory = gst_element_get_factory(element);
+        if (usage.decoder.empty() && factory && !GST_IS_BIN(element) &&
+            gst_element_factory_list_is_type(
+                factory, GST_ELEMENT_FACTORY_TYPE_DECODER |
+                             GST_ELEMENT_FACTORY_TYPE_MEDIA_AUDIO)) {
+          usage.decoder = GST_OBJECT_NAME(factory);
+        }
+        g_value_reset(&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync(iterator);
+        usage.queued_bytes = 0;
+        usage.queued_buffers = 0;
+        usage.queue_count = 0;
+        usage.decoder.clear();
+        break;
+      default:
+        done = true;
+        break;
+    }
+  }
+  g_value_unset(&item);
+  gst_iterator_free(iterator);
+
+  return usage;
+}
+
+bool GstAudioPlayer::ExecuteSeek(int64_t position) {
+  int flags = GST_SEEK_FLAG_FLUSH;
+  switch (seek_mode_) {
+    case SeekMode::kKeyUnit:
+      flags |= GST_SEEK_FLAG_KEY_UNIT;
+      break;
+    case SeekMode::kKeyUnitSnapBefore:
+      flags |= GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_BEFORE;
+      break;
+    case SeekMode::kKeyUnitSnapAfter:
+      flags |= GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_AFTER;
+      break;
+    case SeekMode::kAccurate:
+      flags |= GST_SEEK_FLAG_ACCURATE;
+      break;
+  }
+
   auto nanosecond = position * 1000 * 1000;
   if (!gst_element_seek(
           gst_.playbin, playback_rate_, GST_FORMAT_TIME,
-          (GstSeekFlags)(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT),
+          static_cast<GstSeekFlags>(flags),
           GST_SEEK_TYPE_SET, nanosecond, GST_SEEK_TYPE_SET,
           GST_CLOCK_TIME_NONE)) {
     std::cerr << "Failed to seek " << position << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Called when the playbin has prerolled at the new position
+void GstAudioPlayer::CompleteSeek() {
+  std::lock_guard<std::mutex> lock(mutex_seek_);
+  if (!is_seeking_ || is_seek_queued_) {
     return;
   }
-  stream_handler_->OnNotifySeekCompleted(player_id_);
+
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - seek_start_time_).count();
+  seek_stats_.seek_count++;
+  seek_stats_.last_duration = duration;
+  seek_stats_.max_duration = std::max(seek_stats_.max_duration, duration);
+  seek_stats_.total_duration += duration;
+
+  if (pending_seek_position_ < 0) {
+    FinishSeekingLocked();
+    return;
+  }
+
+  // Seeking from the streaming threads may deadlock, so the pending seek is
+  // executed from the thread pool of GStreamer
+  is_seek_queued_ = true;
+  scheduled_seek_calls_++;
+  seek_start_time_ = std::chrono::steady_clock::now();
+  gst_element_call_async(gst_.playbin, GstAudioPlayer::PendingSeekHandler,
+                         this, NULL);
+}
+
+// Drops the pending seek and waits for the scheduled one to finish
+void GstAudioPlayer::CancelPendingSeek() {
+  std::unique_lock<std::mutex> lock(mutex_seek_);
+  pending_seek_position_ = -1;
+  cond_seek_.wait(lock, [this] { return scheduled_seek_calls_ == 0; });
+  FinishSeekingLocked();
+}
+
+void GstAudioPlayer::FinishSeekingLocked() {
+  is_seeking_ = false;
+  finished_seek_count_ += coalesced_seek_count_;
+  coalesced_seek_count_ = 0;
+}
+
+// The seeks finished on the streaming threads are notified from the calls on
+// the platform thread, since the event channel can't be used from the others
+void GstAudioPlayer::DispatchSeekNotifications() {
+  int32_t count;
+  {
+    std::lock_guard<std::mutex> lock(mutex_seek_);
+    count = finished_seek_count_;
+    finished_seek_count_ = 0;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    stream_handler_->OnNotifySeekCompleted(player_id_);
+  }
+}
+
+// static
+void GstAudioPlayer::PendingSeekHandler(GstElement* playbin,
+                                        gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+  std::unique_lock<std::mutex> lock(self->mutex_seek_);
+  auto position = self->pending_seek_position_;
+  self->pending_seek_position_ = -1;
+  self->is_seek_queued_ = false;
+  bool result = false;
+  if (position >= 0) {
+    lock.unlock();
+    result = self->ExecuteSeek(position);
+    lock.lock();
+  }
+
+  if (!result) {
+    self->FinishSeekingLocked();
+  }
+  self->scheduled_seek_calls_--;
+  self->cond_seek_.notify_all();
 }
 
 void GstAudioPlayer::SetSourceUrl(std::string url) {
   if (url_ != url) {
     url_ = url;
 
+    CancelPendingSeek();
+    DispatchSeekNotifications();
+
     // flush unhandled messeges
     gst_bus_set_flushing(gst_.bus, TRUE);
     gst_element_set_state(gst_.playbin, GST_STATE_NULL);
     is_playing_ = false;
+    ResetCache();
     if (!url_.empty()) {
-      g_object_set(GST_OBJECT(gst_.playbin), "uri", url_.c_str(), NULL);
+      std::string playbin_uri = url_;
+      if (cache_ && MediaCache::IsCacheable(url_)) {
+        std::lock_guard<std::mutex> lock(mutex_cache_);
+        cache_reader_ = cache_->OpenReader(url_);
+        if (cache_reader_) {
+          playbin_uri = "appsrc://";
+        } else {
+          cache_writer_ = cache_->OpenWriter(url_);
+        }
+      }
+      g_object_set(GST_OBJECT(gst_.playbin), "uri", playbin_uri.c_str(),
+                   NULL);
       if (gst_.playbin->current_state != GST_STATE_READY) {
         GstStateChangeReturn ret =
             gst_element_set_state(gst_.playbin, GST_STATE_READY);
@@ -220,19 +593,101 @@ void GstAudioPlayer::SetPlaybackRate(double playback_rate) {
   if (!is_initialized_) {
     return;
   }
-  int64_t position = GetCurrentPosition();
-  if (!gst_element_seek(gst_.playbin, playback_rate, GST_FORMAT_TIME,
-                        GST_SEEK_FLAG_FLUSH, GST_SEEK_TYPE_SET,
-                        position * GST_MSECOND, GST_SEEK_TYPE_SET,
-                        GST_CLOCK_TIME_NONE)) {
-    std::cerr << "Failed to set playback rate to " << playback_rate
-              << " (gst_element_seek failed)" << std::endl;
-    return;
+  UpdateScaletempo(playback_rate);
+
+  // scaletempo stretches the audio by the rate of the segment, which isn't
+  // updated by instant rate changes.
+  const bool is_pitch_corrected = gst_.scaletempo && pitch_correction_;
+  if (is_pitch_corrected || !SetInstantPlaybackRate(playback_rate)) {
+    int64_t position = GetCurrentPosition();
+    if (!gst_element_seek(gst_.playbin, playback_rate, GST_FORMAT_TIME,
+                          GST_SEEK_FLAG_FLUSH, GST_SEEK_TYPE_SET,
+                          position * GST_MSECOND, GST_SEEK_TYPE_SET,
+                          GST_CLOCK_TIME_NONE)) {
+      std::cerr << "Failed to set playback rate to " << playback_rate
+                << " (gst_element_seek failed)" << std::endl;
+      return;
+    }
   }
 
   playback_rate_ = playback_rate;
 }
 
+// Changes the rate from the next buffers without flushing the queued data.
+// Returns false if it's not supported by GStreamer or by the demuxer, or if
+// the pipeline hasn't prerolled.
+bool GstAudioPlayer::SetInstantPlaybackRate(double playback_rate) {
+#if GST_CHECK_VERSION(1, 18, 0)
+  GstState state;
+  gst_element_get_state(gst_.playbin, &state, NULL, 0);
+  if (state < GST_STATE_PAUSED) {
+    return false;
+  }
+  return gst_element_seek(gst_.playbin, playback_rate, GST_FORMAT_TIME,
+                          GST_SEEK_FLAG_INSTANT_RATE_CHANGE, GST_SEEK_TYPE_NONE,
+                          0, GST_SEEK_TYPE_NONE, 0);
+#else
+  return false;
+#endif  // GST_CHECK_VERSION(1, 18, 0)
+}
+
+void GstAudioPlayer::SetPitchCorrection(bool enabled) {
+  if (pitch_correction_ == enabled) {
+    return;
+  }
+  pitch_correction_ = enabled;
+  if (playback_rate_ != 1.0) {
+    SetPlaybackRate(playback_rate_);
+  }
+}
+
+// Links or bypasses scaletempo for |playback_rate|. The pads are relinked
+// while no data flows into the audio bin, and the sticky events (caps and
+// segment) are sent again to the new path.
+void GstAudioPlayer::UpdateScaletempo(double playback_rate) {
+  if (!gst_.scaletempo) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_scaletempo_);
+    is_scaletempo_requested_ = pitch_correction_ && playback_rate != 1.0;
+    if (is_scaletempo_requested_ == is_scaletempo_linked_) {
+      return;
+    }
+  }
+  gst_pad_add_probe(gst_.panoramasinkpad, GST_PAD_PROBE_TYPE_IDLE,
+                    ScaletempoSwitchProbe, this, NULL);
+}
+
+// static
+GstPadProbeReturn GstAudioPlayer::ScaletempoSwitchProbe(GstPad* pad,
+                                                        GstPadProbeInfo* info,
+                                                        gpointer user_data) {
+  auto* self = reinterpret_cast<GstAudioPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_scaletempo_);
+  // A later request may have been applied by an earlier probe.
+  if (self->is_scaletempo_requested_ == self->is_scaletempo_linked_) {
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  auto* ghost_pad = GST_GHOST_PAD(pad);
+  if (self->is_scaletempo_requested_) {
+    GstPad* tempo_sinkpad =
+        gst_element_get_static_pad(self->gst_.tempoconvert, "sink");
+    gst_ghost_pad_set_target(ghost_pad, tempo_sinkpad);
+    gst_object_unref(GST_OBJECT(tempo_sinkpad));
+    gst_element_link(self->gst_.scaletempo, self->gst_.panorama);
+  } else {
+    gst_element_unlink(self->gst_.scaletempo, self->gst_.panorama);
+    GstPad* sinkpad = gst_element_get_static_pad(self->gst_.panorama, "sink");
+    gst_ghost_pad_set_target(ghost_pad, sinkpad);
+    gst_object_unref(GST_OBJECT(sinkpad));
+  }
+  self->is_scaletempo_linked_ = self->is_scaletempo_requested_;
+  return GST_PAD_PROBE_REMOVE;
+}
+
 void GstAudioPlayer::SetLooping(bool is_looping) {
   is_looping_ = is_looping;
 }
@@ -247,6 +702,8 @@ int64_t GstAudioPlayer::GetDuration() {
 }
 
 int64_t GstAudioPlayer::GetCurrentPosition() {
+  DispatchSeekNotifications();
+
   gint64 position = 0;
   if (!gst_element_query_position(gst_.playbin, GST_FORMAT_TIME, &position)) {
     return -1;
@@ -275,6 +732,8 @@ void GstAudioPlayer::Release() {
   is_playing_ = false;
   is_initialized_ = false;
   url_.clear();
+  CancelPendingSeek();
+  DispatchSeekNotifications();
 
   GstState state;
   gst_element_get_state(gst_.playbin, &state, NULL, GST_CLOCK_TIME_NONE);
@@ -282,6 +741,7 @@ void GstAudioPlayer::Release() {
     gst_bus_set_flushing(gst_.bus, TRUE);
     gst_element_set_state(gst_.playbin, GST_STATE_NULL);
   }
+  ResetCache();
 }
 
 void GstAudioPlayer::Dispose() {
@@ -292,6 +752,12 @@ void GstAudioPlayer::Dispose() {
   is_playing_ = false;
   is_initialized_ = false;
   url_.clear();
+  CancelPendingSeek();
+
+  if (cache_reader_ || cache_writer_) {
+    gst_element_set_state(gst_.playbin, GST_STATE_NULL);
+    ResetCache();
+  }
 
   if (gst_.bus) {
     gst_bus_set_flushing(gst_.bus, TRUE);
@@ -310,6 +776,12 @@ void GstAudioPlayer::Dispose() {
     gst_bin_remove(GST_BIN(gst_.audiobin), gst_.audiosink);
     gst_bin_remove(GST_BIN(gst_.audiobin), gst_.panorama);
     gst_.panorama = nullptr;
+    if (gst_.scaletempo) {
+      gst_bin_remove(GST_BIN(gst_.audiobin), gst_.scaletempo);
+      gst_bin_remove(GST_BIN(gst_.audiobin), gst_.tempoconvert);
+      gst_.scaletempo = nullptr;
+      gst_.tempoconvert = nullptr;
+    }
   }
 
   gst_.playbin = nullptr;
@@ -338,6 +810,22 @@ GstBusSyncReply GstAudioPlayer::HandleGstMessage(GstBus* bus,
     case GST_MESSAGE_EOS:
       self->is_completed_ = true;
       break;
+    case GST_MESSAGE_STREAM_STATUS: {
+      GstStreamStatusType type;
+      GstElement* owner;
+      gst_message_parse_stream_status(message, &type, &owner);
+      if (type == GST_STREAM_STATUS_TYPE_ENTER) {
+        self->streaming_thread_count_++;
+      } else if (type == GST_STREAM_STATUS_TYPE_LEAVE) {
+        self->streaming_thread_count_--;
+      }
+      break;
+    }
+    case GST_MESSAGE_ASYNC_DONE:
+      if (GST_MESSAGE_SRC(message) == GST_OBJECT(self->gst_.playbin)) {
+        self->CompleteSeek();
+      }
+      break;
     case GST_MESSAGE_WARNING: {
       gchar* debug;
       GError* error;
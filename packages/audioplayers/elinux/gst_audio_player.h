@@ -7,6 +7,9 @@
 
 #include <gst/gst.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -14,11 +17,46 @@
 #include <string>
 
 #include "audio_player_stream_handler.h"
+#include "media_cache.h"
 
 class GstAudioPlayer {
  public:
+  // Strategies of seeking
+  enum class SeekMode {
+    // Seeks to the nearest key unit
+    kKeyUnit,
+    // Seeks to the key unit at or before the target
+    kKeyUnitSnapBefore,
+    // Seeks to the key unit at or after the target
+    kKeyUnitSnapAfter,
+    // Decodes up to the exact target
+    kAccurate,
+  };
+
+  // Durations of seeks in msec from the request to the completion of the
+  // preroll at the new position
+  struct SeekStats {
+    int32_t seek_count = 0;
+    int32_t coalesced_count = 0;
+    int64_t last_duration = -1;
+    int64_t max_duration = 0;
+    int64_t total_duration = 0;
+  };
+
+  // Memory and threads held by the pipeline
+  struct ResourceUsage {
+    // Bytes and buffers waiting in the queue and queue2 elements
+    int64_t queued_bytes = 0;
+    int32_t queued_buffers = 0;
+    int32_t queue_count = 0;
+    int32_t streaming_thread_count = 0;
+    // Factory name of the audio decoder, or empty before it's plugged
+    std::string decoder;
+  };
+
   GstAudioPlayer(const std::string &player_id,
-                 std::unique_ptr<AudioPlayerStreamHandler> handler);
+                 std::unique_ptr<AudioPlayerStreamHandler> handler,
+                 std::shared_ptr<MediaCache> cache = nullptr);
   ~GstAudioPlayer();
 
   static void GstLibraryLoad();
@@ -28,11 +66,19 @@ class GstAudioPlayer {
   void Play();
   void Pause();
   void Stop();
-  void Seek(int64_t position); 
+  void Seek(int64_t position);
+  void SetSeekMode(SeekMode mode) { seek_mode_ = mode; }
+  SeekStats GetSeekStats();
+  ResourceUsage GetResourceUsage();
   void SetSourceUrl(std::string url);
   void SetVolume(double volume);
   void SetBalance(double balance);
   void SetPlaybackRate(double playback_rate);
+  // Stretches the audio keeping its pitch at rates other than 1.0 if
+  // scaletempo is available. Disabled by default, since scaletempo follows
+  // only the rate of the segment and every rate change then needs a
+  // flushing seek instead of an instant rate change.
+  void SetPitchCorrection(bool enabled);
   void SetLooping(bool is_looping);
   int64_t GetDuration();
   int64_t GetCurrentPosition();
@@ -45,6 +91,8 @@ class GstAudioPlayer {
     GstBus* bus;
     GstElement* source;
     GstElement* panorama;
+    GstElement* tempoconvert;
+    GstElement* scaletempo;
     GstElement* audiobin;
     GstElement* audiosink;
     GstPad* panoramasinkpad;
@@ -54,7 +102,25 @@ class GstAudioPlayer {
                                           gpointer user_data);
   static void SourceSetup(GstElement* playbin,
                           GstElement* source,
-                          GstElement** p_src);
+                          gpointer user_data);
+  static void CacheNeedDataHandler(GstElement* appsrc, guint length,
+                                   gpointer user_data);
+  static gboolean CacheSeekDataHandler(GstElement* appsrc, guint64 offset,
+                                       gpointer user_data);
+  static GstPadProbeReturn CacheWriteProbe(GstPad* pad, GstPadProbeInfo* info,
+                                           gpointer user_data);
+  static void PendingSeekHandler(GstElement* playbin, gpointer user_data);
+  static GstPadProbeReturn ScaletempoSwitchProbe(GstPad* pad,
+                                                 GstPadProbeInfo* info,
+                                                 gpointer user_data);
+  void UpdateScaletempo(double playback_rate);
+  void ResetCache();
+  bool SetInstantPlaybackRate(double playback_rate);
+  bool ExecuteSeek(int64_t position);
+  void CompleteSeek();
+  void CancelPendingSeek();
+  void FinishSeekingLocked();
+  void DispatchSeekNotifications();
   bool CreatePipeline();
   std::string ParseUri(const std::string& uri);
 
@@ -66,8 +132,37 @@ class GstAudioPlayer {
   bool is_looping_ = false;
   double volume_ = 1.0;
   double playback_rate_ = 1.0;
+  bool pitch_correction_ = false;
+  // Whether scaletempo should be / is linked in front of audiopanorama,
+  // guarded by |mutex_scaletempo_|.
+  bool is_scaletempo_requested_ = false;
+  bool is_scaletempo_linked_ = false;
+  std::mutex mutex_scaletempo_;
   bool is_completed_ = false;
   std::unique_ptr<AudioPlayerStreamHandler> stream_handler_;
+  std::atomic<int32_t> streaming_thread_count_{0};
+
+  SeekMode seek_mode_ = SeekMode::kKeyUnit;
+  bool is_seeking_ = false;
+  bool is_seek_queued_ = false;
+  int32_t scheduled_seek_calls_ = 0;
+  int64_t pending_seek_position_ = -1;
+  // Coalesced seeks to be notified once the seeking finishes, and finished
+  // seeks to be notified on the platform thread
+  int32_t coalesced_seek_count_ = 0;
+  int32_t finished_seek_count_ = 0;
+  std::chrono::steady_clock::time_point seek_start_time_;
+  SeekStats seek_stats_;
+  std::mutex mutex_seek_;
+  std::condition_variable cond_seek_;
+
+  std::shared_ptr<MediaCache> cache_;
+  // Shared with the buffers wrapping the mapped entry.
+  std::shared_ptr<MediaCache::Reader> cache_reader_;
+  std::unique_ptr<MediaCache::Writer> cache_writer_;
+  int64_t cache_read_offset_ = 0;
+  int64_t cache_write_offset_ = 0;
+  std::mutex mutex_cache_;
 };
 
 #endif  // PACKAGES_AUDIOPLAYERS_AUDIOPLAYERS_ELINUX_GST_AUDIO_PLAYER_H_
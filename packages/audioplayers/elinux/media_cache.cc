@@ -0,0 +1,370 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This is a copy of packages/video_player/elinux/media_cache.cc. See the note
+// in media_cache.h.
+
+#include "media_cache.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+constexpr char kPartialFileSuffix[] = ".part";
+constexpr size_t kKeyLength = 64;  // SHA-256 in hex.
+
+constexpr const char* kManifestExtensions[] = {".m3u8", ".mpd"};
+// Manifests of adaptive streams, and Shoutcast/Icecast radio streams which
+// are live.
+constexpr const char* kUncacheableTypes[] = {
+    "application/x-hls", "application/x-mpegurl",
+    "application/vnd.apple.mpegurl", "application/dash+xml",
+    "application/x-icy"};
+// Bytes searched for the root element of DASH manifests.
+constexpr size_t kManifestSniffSize = 512;
+
+bool IsManifest(const uint8_t* data, int64_t size) {
+  const std::string head(
+      reinterpret_cast<const char*>(data),
+      std::min<int64_t>(size, static_cast<int64_t>(kManifestSniffSize)));
+  return head.rfind("#EXTM3U", 0) == 0 ||
+         head.find("<MPD") != std::string::npos;
+}
+}  // namespace
+
+MediaCache::Reader::Reader(MediaCache* cache, const std::string& key,
+                           const uint8_t* data, int64_t size)
+    : cache_(cache), key_(key), data_(data), size_(size) {}
+
+MediaCache::Reader::~Reader() {
+  munmap(const_cast<uint8_t*>(data_), size_);
+  cache_->ReleaseReader(key_);
+}
+
+void MediaCache::Reader::NotifyRead(int64_t bytes) {
+  cache_->AddReadBytes(bytes);
+}
+
+MediaCache::Writer::Writer(MediaCache* cache, const std::string& key, int fd)
+    : cache_(cache), key_(key), fd_(fd) {}
+
+MediaCache::Writer::~Writer() { Discard(); }
+
+void MediaCache::Writer::Discard() {
+  if (closed_) {
+    return;
+  }
+  // The lock on the partial file is held until it has been removed.
+  closed_ = true;
+  cache_->ReleaseWriter(key_, false, 0);
+  close(fd_);
+}
+
+void MediaCache::Writer::SetContentLength(int64_t length) {
+  if (content_length_ < 0 && length > 0) {
+    content_length_ = length;
+    if (content_length_ > cache_->GetMaxSize()) {
+      Discard();
+    }
+  }
+}
+
+void MediaCache::Writer::SetContentType(const std::string& type) {
+  if (!IsCacheableType(type)) {
+    Discard();
+  }
+}
+
+void MediaCache::Writer::Write(int64_t offset, const uint8_t* data,
+                               int64_t size) {
+  if (closed_ || offset < 0 || size <= 0) {
+    return;
+  }
+  // Streams without the length (e.g. live ones) could grow without limit.
+  if (content_length_ < 0 || offset + size > content_length_ ||
+      (offset == 0 && IsManifest(data, size))) {
+    Discard();
+    return;
+  }
+
+  int64_t written = 0;
+  while (written < size) {
+    auto result = pwrite(fd_, data + written, size - written, offset + written);
+    if (result < 0) {
+      std::cerr << "Failed to write a cache entry: " << key_ << std::endl;
+      return;
+    }
+    written += result;
+  }
+  cache_->AddWrittenBytes(size);
+
+  // Merges the new range with the overlapping or adjacent ranges.
+  auto start = offset;
+  auto end = offset + size;
+  auto itr = ranges_.upper_bound(start);
+  if (itr != ranges_.begin() && std::prev(itr)->second >= start) {
+    --itr;
+  }
+  while (itr != ranges_.end() && itr->first <= end) {
+    start = std::min(start, itr->first);
+    end = std::max(end, itr->second);
+    itr = ranges_.erase(itr);
+  }
+  ranges_[start] = end;
+
+  if (IsComplete()) {
+    closed_ = true;
+    fsync(fd_);
+    cache_->ReleaseWriter(key_, true, content_length_);
+    close(fd_);
+  }
+}
+
+bool MediaCache::Writer::IsComplete() const {
+  return content_length_ > 0 && ranges_.size() == 1 &&
+         ranges_.begin()->first == 0 &&
+         ranges_.begin()->second >= content_length_;
+}
+
+MediaCache::MediaCache(const std::string& directory, int64_t max_size)
+    : directory_(directory), max_size_(max_size) {
+  if (g_mkdir_with_parents(directory_.c_str(), 0700) != 0) {
+    std::cerr << "Failed to create the cache directory: " << directory_
+              << std::endl;
+  }
+  LoadIndex();
+}
+
+// static
+std::string MediaCache::GetDefaultDirectory(const std::string& name) {
+  return std::string(g_get_user_cache_dir()) + "/" + name;
+}
+
+// static
+bool MediaCache::IsCacheable(const std::string& uri) {
+  if (uri.rfind("http://", 0) != 0 && uri.rfind("https://", 0) != 0) {
+    return false;
+  }
+  auto* path = g_ascii_strdown(uri.substr(0, uri.find_first_of("?#")).c_str(),
+                               -1);
+  auto is_manifest = false;
+  for (const auto* extension : kManifestExtensions) {
+    is_manifest |= g_str_has_suffix(path, extension);
+  }
+  g_free(path);
+  return !is_manifest;
+}
+
+// static
+bool MediaCache::IsCacheableType(const std::string& type) {
+  for (const auto* uncacheable_type : kUncacheableTypes) {
+    if (g_ascii_strcasecmp(type.c_str(), uncacheable_type) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<MediaCache::Reader> MediaCache::OpenReader(
+    const std::string& uri) {
+  const auto key = GetKey(uri);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto itr = entries_.find(key);
+  if (itr == entries_.end()) {
+    stats_.miss_count++;
+    return nullptr;
+  }
+
+  const auto path = GetPath(key);
+  auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    stats_.total_size -= itr->second.size;
+    entries_.erase(itr);
+    stats_.miss_count++;
+    return nullptr;
+  }
+  auto* data =
+      mmap(nullptr, itr->second.size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Failed to map a cache entry: " << path << std::endl;
+    stats_.miss_count++;
+    return nullptr;
+  }
+
+  // Updates the modified time to keep the LRU order across the sessions.
+  utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+  itr->second.last_access = ++access_count_;
+  itr->second.readers++;
+  stats_.hit_count++;
+  return std::unique_ptr<Reader>(new Reader(
+      this, key, reinterpret_cast<const uint8_t*>(data), itr->second.size));
+}
+
+std::unique_ptr<MediaCache::Writer> MediaCache::OpenWriter(
+    const std::string& uri) {
+  const auto key = GetKey(uri);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (max_size_ <= 0 || entries_.find(key) != entries_.end() ||
+      writing_keys_.find(key) != writing_keys_.end()) {
+    return nullptr;
+  }
+
+  // The partial file is locked while it's written, so that other instances
+  // on the same directory (e.g. after the cache is reconfigured) don't
+  // truncate or remove it.
+  const auto path = GetPath(key) + kPartialFileSuffix;
+  auto fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    std::cerr << "Failed to create a cache entry: " << path << std::endl;
+    return nullptr;
+  }
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0 || ftruncate(fd, 0) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  writing_keys_.insert(key);
+  return std::unique_ptr<Writer>(new Writer(this, key, fd));
+}
+
+MediaCache::Stats MediaCache::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+std::string MediaCache::GetKey(const std::string& uri) const {
+  auto* checksum = g_compute_checksum_for_string(G_CHECKSUM_SHA256,
+                                                 uri.c_str(), uri.size());
+  std::string key(checksum);
+  g_free(checksum);
+  return key;
+}
+
+std::string MediaCache::GetPath(const std::string& key) const {
+  return directory_ + "/" + key;
+}
+
+void MediaCache::LoadIndex() {
+  auto* dir = opendir(directory_.c_str());
+  if (!dir) {
+    return;
+  }
+
+  std::vector<std::pair<time_t, std::string>> files;
+  while (auto* dirent = readdir(dir)) {
+    std::string name(dirent->d_name);
+    const auto path = GetPath(name);
+    if (name.size() == kKeyLength + sizeof(kPartialFileSuffix) - 1 &&
+        name.compare(kKeyLength, std::string::npos, kPartialFileSuffix) == 0) {
+      // Ranges of partial entries aren't persisted. The ones locked by the
+      // writers of other instances are still being written.
+      auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd >= 0) {
+        if (flock(fd, LOCK_EX | LOCK_NB) == 0) {
+          unlink(path.c_str());
+        }
+        close(fd);
+      }
+      continue;
+    }
+    struct stat st;
+    if (name.size() != kKeyLength || stat(path.c_str(), &st) != 0 ||
+        !S_ISREG(st.st_mode) || st.st_size == 0) {
+      continue;
+    }
+    Entry entry;
+    entry.size = st.st_size;
+    entries_[name] = entry;
+    stats_.total_size += entry.size;
+    files.emplace_back(st.st_mtime, name);
+  }
+  closedir(dir);
+
+  std::sort(files.begin(), files.end());
+  for (const auto& file : files) {
+    entries_[file.second].last_access = ++access_count_;
+  }
+  EvictLocked();
+}
+
+void MediaCache::SetMaxSize(int64_t max_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_size_ = max_size;
+  EvictLocked();
+}
+
+int64_t MediaCache::GetMaxSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_size_;
+}
+
+void MediaCache::ReleaseReader(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto itr = entries_.find(key);
+  if (itr != entries_.end()) {
+    itr->second.readers--;
+  }
+  EvictLocked();
+}
+
+void MediaCache::ReleaseWriter(const std::string& key, bool complete,
+                               int64_t size) {
+  const auto partial_path = GetPath(key) + kPartialFileSuffix;
+  std::lock_guard<std::mutex> lock(mutex_);
+  writing_keys_.erase(key);
+
+  if (!complete || size > max_size_ ||
+      rename(partial_path.c_str(), GetPath(key).c_str()) != 0) {
+    unlink(partial_path.c_str());
+    return;
+  }
+
+  Entry entry;
+  entry.size = size;
+  entry.last_access = ++access_count_;
+  entries_[key] = entry;
+  stats_.total_size += size;
+  EvictLocked();
+}
+
+void MediaCache::AddWrittenBytes(int64_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.written_bytes += bytes;
+}
+
+void MediaCache::AddReadBytes(int64_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.read_bytes += bytes;
+}
+
+void MediaCache::EvictLocked() {
+  while (stats_.total_size > max_size_) {
+    auto lru = entries_.end();
+    for (auto itr = entries_.begin(); itr != entries_.end(); ++itr) {
+      if (itr->second.readers == 0 &&
+          (lru == entries_.end() ||
+           itr->second.last_access < lru->second.last_access)) {
+        lru = itr;
+      }
+    }
+    if (lru == entries_.end()) {
+      // All the entries are in use.
+      return;
+    }
+    unlink(GetPath(lru->first).c_str());
+    stats_.total_size -= lru->second.size;
+    stats_.eviction_count++;
+    entries_.erase(lru);
+  }
+}
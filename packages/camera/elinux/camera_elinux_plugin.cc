@@ -51,6 +51,7 @@ constexpr char kCameraChannelApiLockCaptureOrientation[] =
 constexpr char kCameraChannelApiUnlockCaptureOrientation[] =
     "unlockCaptureOrientation";
 constexpr char kCameraChannelApiDispose[] = "dispose";
+constexpr char kCameraChannelApiGetResourceUsage[] = "getResourceUsage";
 
 class CameraPlugin : public flutter::Plugin {
  public:
@@ -113,11 +114,17 @@ class CameraPlugin : public flutter::Plugin {
   void HandleDisposeCall(
       const flutter::EncodableValue* message,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleGetResourceUsageCall(
+      const flutter::EncodableValue* message,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
   flutter::PluginRegistrar* plugin_registrar_;
   flutter::TextureRegistrar* texture_registrar_;
 
   std::unique_ptr<FlutterDesktopPixelBuffer> buffer_;
+#ifdef USE_EGL_IMAGE_DMABUF
+  std::unique_ptr<FlutterDesktopEGLImage> egl_image_;
+#endif  // USE_EGL_IMAGE_DMABUF
   std::unique_ptr<flutter::TextureVariant> texture_;
   std::unique_ptr<GstCamera> camera_ = nullptr;
   int64_t texture_id_;
@@ -203,6 +210,8 @@ void CameraPlugin::HandleMethodCall(
     result->NotImplemented();
   } else if (!method_name.compare(kCameraChannelApiDispose)) {
     HandleDisposeCall(method_call.arguments(), std::move(result));
+  } else if (!method_name.compare(kCameraChannelApiGetResourceUsage)) {
+    HandleGetResourceUsageCall(method_call.arguments(), std::move(result));
   } else {
     result->NotImplemented();
   }
@@ -227,6 +236,29 @@ void CameraPlugin::HandleAvailableCamerasCall(
 void CameraPlugin::HandleCreateCall(
     const flutter::EncodableValue* message,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+#ifdef USE_EGL_IMAGE_DMABUF
+  egl_image_ = std::make_unique<FlutterDesktopEGLImage>();
+  texture_ =
+      std::make_unique<flutter::TextureVariant>(flutter::EGLImageTexture(
+          [this](size_t width, size_t height, void* egl_display,
+                 void* egl_context) -> const FlutterDesktopEGLImage* {
+            egl_image_->width = camera_->GetPreviewWidth();
+            egl_image_->height = camera_->GetPreviewHeight();
+            egl_image_->egl_image =
+                camera_->GetPreviewEGLImage(egl_display, egl_context);
+
+            // TODO: We need to handle this code (event_channel_image_stream_)
+            // in the proper place, but the Camera plugin doesn't have a main
+            // loop.
+            if (event_channel_image_stream_) {
+              event_channel_image_stream_->Send(
+                  egl_image_->width, egl_image_->height,
+                  camera_->GetPreviewFrameBuffer());
+            }
+
+            return egl_image_.get();
+          }));
+#else
   buffer_ = std::make_unique<FlutterDesktopPixelBuffer>();
   texture_ =
       std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
@@ -246,6 +278,7 @@ void CameraPlugin::HandleCreateCall(
 
             return buffer_.get();
           }));
+#endif  // USE_EGL_IMAGE_DMABUF
   auto texture_id = texture_registrar_->RegisterTexture(texture_.get());
   auto stream_handler =
       std::make_unique<CameraStreamHandlerImpl>([texture_id, this]() {
@@ -414,6 +447,26 @@ void CameraPlugin::HandleDisposeCall(
   result->Success();
 }
 
+void CameraPlugin::HandleGetResourceUsageCall(
+    const flutter::EncodableValue* message,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  if (!camera_) {
+    result->Error("Not found an active camera",
+                  "Check for creating a camera device");
+    return;
+  }
+
+  auto usage = camera_->GetResourceUsage();
+  ResourceUsageMessage reply;
+  reply.SetFrameBufferBytes(usage.frame_buffer_bytes);
+  reply.SetQueuedBytes(usage.queued_bytes);
+  reply.SetQueuedBuffers(usage.queued_buffers);
+  reply.SetQueueCount(usage.queue_count);
+  reply.SetStreamingThreadCount(usage.streaming_thread_count);
+  reply.SetDecoder(usage.decoder);
+  result->Success(reply.ToMap());
+}
+
 }  // namespace
 
 void CameraElinuxPluginRegisterWithRegistrar(
@@ -29,6 +29,9 @@ GstCamera::GstCamera(std::unique_ptr<CameraStreamHandler> handler)
 }
 
 GstCamera::~GstCamera() {
+#ifdef USE_EGL_IMAGE_DMABUF
+  UnrefEGLImage();
+#endif  // USE_EGL_IMAGE_DMABUF
   Stop();
   DestroyPipeline();
 }
@@ -121,6 +124,107 @@ const uint8_t* GstCamera::GetPreviewFrameBuffer() {
   return reinterpret_cast<const uint8_t*>(pixels_.get());
 }
 
+GstCamera::ResourceUsage GstCamera::GetResourceUsage() {
+  ResourceUsage usage;
+  {
+    std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+    if (pixels_) {
+      usage.frame_buffer_bytes += static_cast<int64_t>(width_) * height_ * 4;
+    }
+    if (gst_.buffer) {
+      usage.frame_buffer_bytes += gst_buffer_get_size(gst_.buffer);
+    }
+  }
+  usage.streaming_thread_count = streaming_thread_count_;
+  if (!gst_.pipeline) {
+    return usage;
+  }
+
+  auto* iterator = gst_bin_iterate_recurse(GST_BIN(gst_.pipeline));
+  GValue item = G_VALUE_INIT;
+  bool done = false;
+  while (!done) {
+    switch (gst_iterator_next(iterator, &item)) {
+      case GST_ITERATOR_OK: {
+        auto* element = GST_ELEMENT(g_value_get_object(&item));
+        auto* klass = G_OBJECT_GET_CLASS(element);
+        if (g_object_class_find_property(klass, "current-level-bytes") &&
+            g_object_class_find_property(klass, "current-level-buffers")) {
+          guint bytes = 0;
+          guint buffers = 0;
+          g_object_get(element, "current-level-bytes", &bytes,
+                       "current-level-buffers", &buffers, NULL);
+          usage.queued_bytes += bytes;
+          usage.queued_buffers += buffers;
+          usage.queue_count++;
+        }
+        auto* factory = gst_element_get_factory(element);
+        if (usage.decoder.empty() && factory && !GST_IS_BIN(element) &&
+            gst_element_factory_list_is_type(
+                factory, GST_ELEMENT_FACTORY_TYPE_DECODER)) {
+          usage.decoder = GST_OBJECT_NAME(factory);
+        }
+        g_value_reset(&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync(iterator);
+        usage.queued_bytes = 0;
+        usage.queued_buffers = 0;
+        usage.queue_count = 0;
+        usage.decoder.clear();
+        break;
+      default:
+        done = true;
+        break;
+    }
+  }
+  g_value_unset(&item);
+  gst_iterator_free(iterator);
+
+  return usage;
+}
+
+#ifdef USE_EGL_IMAGE_DMABUF
+void* GstCamera::GetPreviewEGLImage(void* egl_display, void* egl_context) {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  if (!gst_.buffer) {
+    return nullptr;
+  }
+
+  GstMemory* memory = gst_buffer_peek_memory(gst_.buffer, 0);
+  if (gst_is_dmabuf_memory(memory)) {
+    UnrefEGLImage();
+
+    gint fd = gst_dmabuf_memory_get_fd(memory);
+    gst_gl_display_egl_ = gst_gl_display_egl_new_with_egl_display(
+        reinterpret_cast<gpointer>(egl_display));
+    gst_gl_ctx_ = gst_gl_context_new_wrapped(
+        GST_GL_DISPLAY_CAST(gst_gl_display_egl_),
+        reinterpret_cast<guintptr>(egl_context), GST_GL_PLATFORM_EGL,
+        GST_GL_API_GLES2);
+
+    gst_gl_context_activate(gst_gl_ctx_, TRUE);
+
+    gst_egl_image_ =
+        gst_egl_image_from_dmabuf(gst_gl_ctx_, fd, &gst_video_info_, 0, 0);
+    return reinterpret_cast<void*>(gst_egl_image_get_image(gst_egl_image_));
+  }
+  return nullptr;
+}
+
+void GstCamera::UnrefEGLImage() {
+  if (gst_egl_image_) {
+    gst_egl_image_unref(gst_egl_image_);
+    gst_object_unref(gst_gl_ctx_);
+    gst_object_unref(gst_gl_display_egl_);
+    gst_egl_image_ = NULL;
+    gst_gl_ctx_ = NULL;
+    gst_gl_display_egl_ = NULL;
+  }
+}
+#endif  // USE_EGL_IMAGE_DMABUF
+
 // Creats a camra pipeline using camerabin.
 // $ gst-launch-1.0 camerabin viewfinder-sink="videoconvert !
 // video/x-raw,format=RGBA ! fakesink"
@@ -181,6 +285,28 @@ bool GstCamera::CreatePipeline() {
   gst_pad_set_active(ghost_sinkpad, TRUE);
   gst_element_add_pad(gst_.output, ghost_sinkpad);
 
+#ifdef USE_EGL_IMAGE_DMABUF
+  // Lets v4l2src export the captured frames as dmabufs so that they can be
+  // imported as EGLImages without copying them to the CPU memory.
+  auto* camera_source =
+      gst_element_factory_make("wrappercamerabinsrc", "camerasrc");
+  auto* video_source = gst_element_factory_make("v4l2src", "v4l2src");
+  if (camera_source && video_source) {
+    gst_util_set_object_arg(G_OBJECT(video_source), "io-mode", "dmabuf");
+    g_object_set(camera_source, "video-source", video_source, NULL);
+    g_object_set(gst_.camerabin, "camera-source", camera_source, NULL);
+  } else {
+    std::cerr << "Failed to create a v4l2src, fallback to the default source"
+              << std::endl;
+    if (camera_source) {
+      gst_object_unref(camera_source);
+    }
+    if (video_source) {
+      gst_object_unref(video_source);
+    }
+  }
+#endif  // USE_EGL_IMAGE_DMABUF
+
   // Sets properties to camerabin.
   g_object_set(gst_.camerabin, "viewfinder-sink", gst_.output, NULL);
   gst_bin_add_many(GST_BIN(gst_.pipeline), gst_.camerabin, NULL);
@@ -272,14 +398,20 @@ void GstCamera::HandoffHandler(GstElement* fakesink, GstBuffer* buf,
   int height;
   gst_structure_get_int(structure, "width", &width);
   gst_structure_get_int(structure, "height", &height);
-  gst_caps_unref(caps);
   if (width != self->width_ || height != self->height_) {
     self->width_ = width;
     self->height_ = height;
     self->pixels_.reset(new uint32_t[width * height]);
     std::cout << "Pixel buffer size: width = " << width
               << ", height = " << height << std::endl;
+#ifdef USE_EGL_IMAGE_DMABUF
+    std::lock_guard<std::shared_mutex> lock(self->mutex_buffer_);
+    if (!gst_video_info_from_caps(&self->gst_video_info_, caps)) {
+      std::cerr << "Failed to get a gst_video_info" << std::endl;
+    }
+#endif  // USE_EGL_IMAGE_DMABUF
   }
+  gst_caps_unref(caps);
 
   std::lock_guard<std::shared_mutex> lock(self->mutex_buffer_);
   if (self->gst_.buffer) {
@@ -307,6 +439,18 @@ GstBusSyncReply GstCamera::HandleGstMessage(GstBus* bus,
       }
       break;
     }
+    case GST_MESSAGE_STREAM_STATUS: {
+      auto* self = reinterpret_cast<GstCamera*>(user_data);
+      GstStreamStatusType type;
+      GstElement* owner;
+      gst_message_parse_stream_status(message, &type, &owner);
+      if (type == GST_STREAM_STATUS_TYPE_ENTER) {
+        self->streaming_thread_count_++;
+      } else if (type == GST_STREAM_STATUS_TYPE_LEAVE) {
+        self->streaming_thread_count_--;
+      }
+      break;
+    }
     case GST_MESSAGE_WARNING: {
       gchar* debug;
       GError* error;
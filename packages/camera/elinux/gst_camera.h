@@ -7,6 +7,14 @@
 
 #include <gst/gst.h>
 
+#ifdef USE_EGL_IMAGE_DMABUF
+#include <gst/allocators/gstdmabuf.h>
+#include <gst/gl/egl/egl.h>
+#include <gst/gl/gl.h>
+#include <gst/video/video.h>
+#endif  // USE_EGL_IMAGE_DMABUF
+
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <shared_mutex>
@@ -19,6 +27,20 @@ class GstCamera {
   using OnNotifyCaptured =
       std::function<void(const std::string& captured_file_path)>;
 
+  // Memory and threads held by the pipeline.
+  struct ResourceUsage {
+    // Bytes of the converted frame buffer and the referenced GstBuffer.
+    int64_t frame_buffer_bytes = 0;
+    // Bytes and buffers waiting in the queue elements.
+    int64_t queued_bytes = 0;
+    int32_t queued_buffers = 0;
+    int32_t queue_count = 0;
+    int32_t streaming_thread_count = 0;
+    // Factory name of the decoder (e.g. jpegdec for MJPEG cameras), or empty
+    // if the camera outputs raw frames.
+    std::string decoder;
+  };
+
   GstCamera(std::unique_ptr<CameraStreamHandler> handler);
   ~GstCamera();
 
@@ -36,9 +58,14 @@ class GstCamera {
   float GetMinZoomLevel() const { return min_zoom_level_; };
 
   const uint8_t* GetPreviewFrameBuffer();
+#ifdef USE_EGL_IMAGE_DMABUF
+  void* GetPreviewEGLImage(void* egl_display, void* egl_context);
+#endif  // USE_EGL_IMAGE_DMABUF
   int32_t GetPreviewWidth() const { return width_; };
   int32_t GetPreviewHeight() const { return height_; };
 
+  ResourceUsage GetResourceUsage();
+
  private:
   struct GstCameraElements {
     GstElement* pipeline;
@@ -59,12 +86,16 @@ class GstCamera {
   void DestroyPipeline();
   void Preroll();
   void GetZoomMaxMinSize(float& max, float& min);
+#ifdef USE_EGL_IMAGE_DMABUF
+  void UnrefEGLImage();
+#endif  // USE_EGL_IMAGE_DMABUF
 
   GstCameraElements gst_;
   std::unique_ptr<uint32_t> pixels_;
   int32_t width_ = -1;
   int32_t height_ = -1;
   std::shared_mutex mutex_buffer_;
+  std::atomic<int32_t> streaming_thread_count_{0};
   std::unique_ptr<CameraStreamHandler> stream_handler_ = nullptr;
   float max_zoom_level_;
   float min_zoom_level_;
@@ -72,6 +103,13 @@ class GstCamera {
   int captured_count_ = 0;
 
   OnNotifyCaptured on_notify_captured_ = nullptr;
+
+#ifdef USE_EGL_IMAGE_DMABUF
+  GstVideoInfo gst_video_info_;
+  GstEGLImage* gst_egl_image_ = NULL;
+  GstGLContext* gst_gl_ctx_ = NULL;
+  GstGLDisplayEGL* gst_gl_display_egl_ = NULL;
+#endif  // USE_EGL_IMAGE_DMABUF
 };
 
 #endif  // PACKAGES_CAMERA_CAMERA_ELINUX_GST_CAMERA_H_
@@ -7,6 +7,7 @@
 
 #include "available_cameras_message.h"
 #include "orientation_message.h"
+#include "resource_usage_message.h"
 #include "texture_message.h"
 #include "zoom_level_message.h"
 
@@ -517,6 +517,24 @@ class ELinuxCamera extends CameraPlatform {
     );
   }
 
+  /// Gets the memory and the threads held by the pipeline of the camera.
+  Future<CameraResourceUsage> getResourceUsage(int cameraId) async {
+    final Map<String, dynamic>? reply =
+        await _channel.invokeMapMethod<String, dynamic>(
+      'getResourceUsage',
+      <String, dynamic>{'cameraId': cameraId},
+    );
+    final String decoder = reply!['decoder']! as String;
+    return CameraResourceUsage(
+      frameBufferBytes: reply['frameBufferBytes']! as int,
+      queuedBytes: reply['queuedBytes']! as int,
+      queuedBuffers: reply['queuedBuffers']! as int,
+      queueCount: reply['queueCount']! as int,
+      streamingThreadCount: reply['streamingThreadCount']! as int,
+      decoder: decoder.isEmpty ? null : decoder,
+    );
+  }
+
   @override
   Widget buildPreview(int cameraId) {
     return Texture(textureId: cameraId);
@@ -643,3 +661,36 @@ class ELinuxCamera extends CameraPlatform {
     return (call.arguments as Map<Object?, Object?>).cast<String, Object?>();
   }
 }
+
+/// Resources held by a camera reported by [ELinuxCamera.getResourceUsage].
+class CameraResourceUsage {
+  /// Creates a [CameraResourceUsage].
+  const CameraResourceUsage({
+    required this.frameBufferBytes,
+    required this.queuedBytes,
+    required this.queuedBuffers,
+    required this.queueCount,
+    required this.streamingThreadCount,
+    this.decoder,
+  });
+
+  /// The bytes of the converted preview frame and the captured frame
+  /// referenced by the camera.
+  final int frameBufferBytes;
+
+  /// The bytes waiting in the queues of the pipeline.
+  final int queuedBytes;
+
+  /// The number of buffers waiting in the queues of the pipeline.
+  final int queuedBuffers;
+
+  /// The number of queues whose levels are accounted.
+  final int queueCount;
+
+  /// The number of running streaming threads of the pipeline.
+  final int streamingThreadCount;
+
+  /// The GStreamer element name of the decoder, such as `jpegdec` for MJPEG
+  /// cameras, or null if the camera outputs raw frames.
+  final String? decoder;
+}
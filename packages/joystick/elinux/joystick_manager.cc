@@ -0,0 +1,325 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "joystick_manager.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <limits>
+
+namespace {
+constexpr char kInputDirectory[] = "/dev/input";
+constexpr char kJoydevPrefix[] = "js";
+constexpr char kEvdevPrefix[] = "event";
+
+// epoll keys of the fds other than the devices. Device ids start from 1.
+constexpr uint64_t kStopKey = std::numeric_limits<uint64_t>::max();
+constexpr uint64_t kInotifyKey = kStopKey - 1;
+
+constexpr int kMaxEpollEvents = 16;
+
+bool HasPrefix(const std::string& str, const char* prefix) {
+  return str.compare(0, strlen(prefix), prefix) == 0;
+}
+
+// evdev nodes are also created for keyboards, mice and so on.
+bool IsEvdevJoystick(int fd) {
+  uint8_t key_bits[KEY_CNT / 8 + 1] = {};
+  if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits) < 0) {
+    return false;
+  }
+  auto test_bit = [&key_bits](int bit) {
+    return key_bits[bit / 8] & (1 << (bit % 8));
+  };
+  return test_bit(BTN_JOYSTICK) || test_bit(BTN_GAMEPAD);
+}
+
+std::string GetDeviceName(int fd, bool is_evdev) {
+  char name[128] = {};
+  auto result = is_evdev ? ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name)
+                         : ioctl(fd, JSIOCGNAME(sizeof(name) - 1), name);
+  return result < 0 ? std::string() : std::string(name);
+}
+}  // namespace
+
+// static
+JoystickManager* JoystickManager::GetInstance() {
+  static JoystickManager instance;
+  return &instance;
+}
+
+bool JoystickManager::Start(bool use_evdev, uint32_t capacity,
+                            DeviceCallback callback) {
+  if (thread_.joinable()) {
+    fprintf(stderr, "The joystick manager has already been started\n");
+    return false;
+  }
+
+  use_evdev_ = use_evdev;
+  capacity_ = capacity;
+  callback_ = std::move(callback);
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  stop_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  inotify_fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+  if (epoll_fd_ < 0 || stop_fd_ < 0 || inotify_fd_ < 0) {
+    fprintf(stderr, "Failed to create the fds of the joystick manager (%d)\n",
+            errno);
+    Stop();
+    return false;
+  }
+
+  // The device nodes may be readable only after udev updates the permissions
+  // following their creation, so IN_ATTRIB is also watched.
+  if (inotify_add_watch(inotify_fd_, kInputDirectory,
+                        IN_CREATE | IN_ATTRIB | IN_DELETE) < 0) {
+    fprintf(stderr, "Failed to watch %s (%d)\n", kInputDirectory, errno);
+    Stop();
+    return false;
+  }
+
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.u64 = kStopKey;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &ev);
+  ev.data.u64 = kInotifyKey;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, inotify_fd_, &ev);
+
+  thread_ = std::thread(&JoystickManager::Run, this);
+  return true;
+}
+
+void JoystickManager::Stop() {
+  if (thread_.joinable()) {
+    uint64_t value = 1;
+    if (write(stop_fd_, &value, sizeof(value)) < 0) {
+      fprintf(stderr, "Failed to stop the joystick manager (%d)\n", errno);
+    }
+    thread_.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [id, device] : devices_) {
+      device.reader->Disconnect();
+    }
+    devices_.clear();
+  }
+  callback_ = nullptr;
+
+  for (auto* fd : {&inotify_fd_, &stop_fd_, &epoll_fd_}) {
+    if (*fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+std::vector<JoystickManager::DeviceInfo> JoystickManager::GetDevices() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<DeviceInfo> devices;
+  for (const auto& [id, device] : devices_) {
+    devices.push_back(device.info);
+  }
+  return devices;
+}
+
+JoystickReader* JoystickManager::AcquireReader(int32_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = devices_.find(id);
+  if (iter == devices_.end()) {
+    return nullptr;
+  }
+  auto* reader = iter->second.reader.get();
+  auto& acquired = acquired_readers_[reader];
+  acquired.first = iter->second.reader;
+  acquired.second++;
+  return reader;
+}
+
+void JoystickManager::ReleaseReader(JoystickReader* reader) {
+  std::shared_ptr<JoystickReader> released;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = acquired_readers_.find(reader);
+    if (iter == acquired_readers_.end()) {
+      return;
+    }
+    if (--iter->second.second == 0) {
+      // Destroys the reader outside the lock.
+      released = std::move(iter->second.first);
+      acquired_readers_.erase(iter);
+    }
+  }
+}
+
+void JoystickManager::Run() {
+  ScanDevices();
+
+  struct epoll_event events[kMaxEpollEvents];
+  while (true) {
+    auto count = epoll_wait(epoll_fd_, events, kMaxEpollEvents, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "Failed to wait for joystick events (%d)\n", errno);
+      return;
+    }
+
+    for (int i = 0; i < count; i++) {
+      const auto key = events[i].data.u64;
+      if (key == kStopKey) {
+        return;
+      }
+      if (key == kInotifyKey) {
+        HandleInotifyEvents();
+        continue;
+      }
+
+      const auto id = static_cast<int32_t>(key);
+      auto iter = devices_.find(id);
+      if (iter == devices_.end()) {
+        continue;
+      }
+      auto* reader = iter->second.reader.get();
+      if (events[i].events & EPOLLIN) {
+        reader->Drain();
+      }
+      if ((events[i].events & (EPOLLERR | EPOLLHUP)) ||
+          !reader->IsConnected()) {
+        CloseDevice(id);
+      }
+    }
+  }
+}
+
+void JoystickManager::ScanDevices() {
+  auto* dir = opendir(kInputDirectory);
+  if (!dir) {
+    fprintf(stderr, "Failed to open %s (%d)\n", kInputDirectory, errno);
+    return;
+  }
+  while (auto* entry = readdir(dir)) {
+    OpenDevice(entry->d_name);
+  }
+  closedir(dir);
+}
+
+void JoystickManager::HandleInotifyEvents() {
+  alignas(struct inotify_event) char buffer[4096];
+  while (true) {
+    auto bytes = read(inotify_fd_, buffer, sizeof(buffer));
+    if (bytes <= 0) {
+      return;
+    }
+    for (char* ptr = buffer; ptr < buffer + bytes;) {
+      const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+      ptr += sizeof(struct inotify_event) + event->len;
+      if (event->len == 0) {
+        continue;
+      }
+
+      const std::string file_name(event->name);
+      if (event->mask & (IN_CREATE | IN_ATTRIB)) {
+        OpenDevice(file_name);
+      } else if (event->mask & IN_DELETE) {
+        const auto path = std::string(kInputDirectory) + "/" + file_name;
+        for (const auto& [id, device] : devices_) {
+          if (device.info.path == path) {
+            CloseDevice(id);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+void JoystickManager::OpenDevice(const std::string& file_name) {
+  if (!IsTargetDevice(file_name)) {
+    return;
+  }
+  const auto path = std::string(kInputDirectory) + "/" + file_name;
+  for (const auto& [id, device] : devices_) {
+    if (device.info.path == path) {
+      return;
+    }
+  }
+
+  // The node may not be accessible yet. It's retried on IN_ATTRIB.
+  int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  }
+  if (fd < 0) {
+    return;
+  }
+  if (use_evdev_ && !IsEvdevJoystick(fd)) {
+    close(fd);
+    return;
+  }
+
+  Device device;
+  device.info.id = next_id_++;
+  device.info.path = path;
+  device.info.name = GetDeviceName(fd, use_evdev_);
+  device.info.is_evdev = use_evdev_;
+  // The fd is closed after the last user of the reader releases it.
+  device.reader = std::shared_ptr<JoystickReader>(
+      new JoystickReader(fd, capacity_), [fd](JoystickReader* reader) {
+        delete reader;
+        close(fd);
+      });
+  device.reader->SyncState();
+
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.u64 = device.info.id;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+    fprintf(stderr, "Failed to watch %s (%d)\n", path.c_str(), errno);
+    return;
+  }
+
+  const auto info = device.info;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_[info.id] = std::move(device);
+  }
+  if (callback_) {
+    callback_(info, true);
+  }
+}
+
+void JoystickManager::CloseDevice(int32_t id) {
+  auto iter = devices_.find(id);
+  if (iter == devices_.end()) {
+    return;
+  }
+
+  auto reader = iter->second.reader;
+  const auto info = iter->second.info;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, reader->fd(), nullptr);
+  reader->Disconnect();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_.erase(iter);
+  }
+  if (callback_) {
+    callback_(info, false);
+  }
+}
+
+bool JoystickManager::IsTargetDevice(const std::string& file_name) const {
+  return HasPrefix(file_name, use_evdev_ ? kEvdevPrefix : kJoydevPrefix);
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_JOYSTICK_ELINUX_JOYSTICK_MANAGER_H_
+#define PACKAGES_JOYSTICK_ELINUX_JOYSTICK_MANAGER_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "joystick_reader.h"
+
+// Watches /dev/input with inotify and opens the joysticks connected to the
+// system. All the open devices are read by one thread multiplexing them with
+// epoll, and the readers are shared with Dart through the FFI API.
+class JoystickManager {
+ public:
+  struct DeviceInfo {
+    int32_t id = 0;
+    std::string path;
+    std::string name;
+    bool is_evdev = false;
+  };
+
+  // Called on the thread of the manager when a device is connected or
+  // disconnected.
+  using DeviceCallback =
+      std::function<void(const DeviceInfo& info, bool is_connected)>;
+
+  static JoystickManager* GetInstance();
+
+  // Prevent copying.
+  JoystickManager(JoystickManager const&) = delete;
+  JoystickManager& operator=(JoystickManager const&) = delete;
+
+  // Starts watching the devices. evdev devices (/dev/input/eventN) are used
+  // if |use_evdev| is true, otherwise joydev devices (/dev/input/jsN). The
+  // devices already connected are notified to |callback| first.
+  bool Start(bool use_evdev, uint32_t capacity, DeviceCallback callback);
+
+  // Stops watching and closes all the devices. The acquired readers are kept
+  // alive until they are released.
+  void Stop();
+
+  std::vector<DeviceInfo> GetDevices();
+
+  // Returns the reader of the device and keeps it alive until
+  // ReleaseReader() is called, even after the device is disconnected.
+  // Returns nullptr if there is no such device.
+  JoystickReader* AcquireReader(int32_t id);
+  void ReleaseReader(JoystickReader* reader);
+
+ private:
+  struct Device {
+    DeviceInfo info;
+    std::shared_ptr<JoystickReader> reader;
+  };
+
+  JoystickManager() = default;
+  ~JoystickManager() = default;
+
+  void Run();
+  void ScanDevices();
+  void HandleInotifyEvents();
+  void OpenDevice(const std::string& file_name);
+  void CloseDevice(int32_t id);
+  bool IsTargetDevice(const std::string& file_name) const;
+
+  int epoll_fd_ = -1;
+  int inotify_fd_ = -1;
+  int stop_fd_ = -1;
+  std::thread thread_;
+  bool use_evdev_ = false;
+  uint32_t capacity_ = 0;
+  DeviceCallback callback_;
+  int32_t next_id_ = 1;
+
+  // Modified only by the thread of the manager.
+  std::map<int32_t, Device> devices_;
+  std::map<JoystickReader*, std::pair<std::shared_ptr<JoystickReader>, int>>
+      acquired_readers_;
+  std::mutex mutex_;
+};
+
+#endif  // PACKAGES_JOYSTICK_ELINUX_JOYSTICK_MANAGER_H_
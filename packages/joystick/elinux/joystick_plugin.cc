@@ -4,32 +4,162 @@
 
 #include "include/joystick/joystick_plugin.h"
 
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
 #include <flutter/plugin_registrar.h>
+#include <flutter/standard_method_codec.h>
 
 #include <memory>
+#include <mutex>
 #include <sstream>
 
+#include "joystick_manager.h"
+
 namespace {
+constexpr char kManagerChannelName[] = "joystick/manager";
+
+constexpr char kStartWatchingMethod[] = "startWatching";
+constexpr char kStopWatchingMethod[] = "stopWatching";
+constexpr char kDrainDeviceEventsMethod[] = "drainDeviceEvents";
+
+constexpr char kConnectedEvent[] = "connected";
+constexpr char kDisconnectedEvent[] = "disconnected";
+
+constexpr int64_t kDefaultReaderCapacity = 256;
+
+template <typename T>
+bool GetValueFromEncodableMap(const flutter::EncodableMap* map,
+                              const char* key, T& out) {
+  auto iter = map->find(flutter::EncodableValue(key));
+  if (iter != map->end() && !iter->second.IsNull()) {
+    if (auto* value = std::get_if<T>(&iter->second)) {
+      out = *value;
+      return true;
+    }
+  }
+  return false;
+}
 
 class JoystickPlugin : public flutter::Plugin {
  public:
   static void RegisterWithRegistrar(flutter::PluginRegistrar *registrar);
 
-  JoystickPlugin();
+  JoystickPlugin(flutter::PluginRegistrar *registrar);
 
   virtual ~JoystickPlugin();
+
+ private:
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  bool StartWatching(const flutter::EncodableValue* arguments);
+  void StopWatching();
+
+  // Called on the thread of JoystickManager. The event is queued until it's
+  // returned by DrainDeviceEvents().
+  void QueueDeviceEvent(const JoystickManager::DeviceInfo& info,
+                        bool is_connected);
+
+  // Returns the queued events as the result of the method call, since the
+  // plugin can't post them to the platform thread by itself.
+  flutter::EncodableList DrainDeviceEvents();
+
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      manager_channel_;
+  flutter::EncodableList pending_device_events_;
+  std::mutex mutex_device_events_;
 };
 
 // static
 void JoystickPlugin::RegisterWithRegistrar(
     flutter::PluginRegistrar *registrar) {
-  auto plugin = std::make_unique<JoystickPlugin>();
+  auto plugin = std::make_unique<JoystickPlugin>(registrar);
   registrar->AddPlugin(std::move(plugin));
 }
 
-JoystickPlugin::JoystickPlugin() {}
+JoystickPlugin::JoystickPlugin(flutter::PluginRegistrar *registrar) {
+  manager_channel_ =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          registrar->messenger(), kManagerChannelName,
+          &flutter::StandardMethodCodec::GetInstance());
+  manager_channel_->SetMethodCallHandler(
+      [this](const auto& call, auto result) {
+        HandleMethodCall(call, std::move(result));
+      });
+}
 
-JoystickPlugin::~JoystickPlugin() {}
+JoystickPlugin::~JoystickPlugin() { JoystickManager::GetInstance()->Stop(); }
+
+bool JoystickPlugin::StartWatching(const flutter::EncodableValue* arguments) {
+  bool use_evdev = false;
+  int64_t capacity = kDefaultReaderCapacity;
+  if (arguments) {
+    if (auto* map = std::get_if<flutter::EncodableMap>(arguments)) {
+      GetValueFromEncodableMap(map, "evdev", use_evdev);
+      int32_t value;
+      if (GetValueFromEncodableMap(map, "capacity", value)) {
+        capacity = value;
+      }
+    }
+  }
+
+  StopWatching();
+  return JoystickManager::GetInstance()->Start(
+      use_evdev, capacity,
+      [this](const JoystickManager::DeviceInfo& info, bool is_connected) {
+        QueueDeviceEvent(info, is_connected);
+      });
+}
+
+void JoystickPlugin::StopWatching() {
+  JoystickManager::GetInstance()->Stop();
+  std::lock_guard<std::mutex> lock(mutex_device_events_);
+  pending_device_events_.clear();
+}
+
+void JoystickPlugin::HandleMethodCall(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto& method_name = method_call.method_name();
+  if (method_name == kStartWatchingMethod) {
+    if (StartWatching(method_call.arguments())) {
+      result->Success();
+    } else {
+      result->Error("JoystickError", "Failed to start watching the joysticks");
+    }
+  } else if (method_name == kStopWatchingMethod) {
+    StopWatching();
+    result->Success();
+  } else if (method_name == kDrainDeviceEventsMethod) {
+    result->Success(flutter::EncodableValue(DrainDeviceEvents()));
+  } else {
+    result->NotImplemented();
+  }
+}
+
+void JoystickPlugin::QueueDeviceEvent(const JoystickManager::DeviceInfo& info,
+                                      bool is_connected) {
+  flutter::EncodableMap map = {
+      {flutter::EncodableValue("event"),
+       flutter::EncodableValue(is_connected ? kConnectedEvent
+                                            : kDisconnectedEvent)},
+      {flutter::EncodableValue("id"), flutter::EncodableValue(info.id)},
+      {flutter::EncodableValue("path"), flutter::EncodableValue(info.path)},
+      {flutter::EncodableValue("name"), flutter::EncodableValue(info.name)},
+      {flutter::EncodableValue("evdev"),
+       flutter::EncodableValue(info.is_evdev)},
+  };
+  std::lock_guard<std::mutex> lock(mutex_device_events_);
+  pending_device_events_.push_back(flutter::EncodableValue(map));
+}
+
+flutter::EncodableList JoystickPlugin::DrainDeviceEvents() {
+  flutter::EncodableList events;
+  std::lock_guard<std::mutex> lock(mutex_device_events_);
+  events.swap(pending_device_events_);
+  return events;
+}
 
 }  // namespace
 
@@ -0,0 +1,515 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "joystick_reader.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Number of events read by one read() call.
+constexpr int kReadBatchSize = 64;
+
+// Range of the axes of the joydev driver.
+constexpr int32_t kJoydevAxisMax = 32767;
+
+uint64_t GetMonotonicTimeUs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t RoundUpToPowerOfTwo(uint32_t value) {
+  uint32_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+bool TestBit(const uint8_t* bits, int bit) {
+  return bits[bit / 8] & (1 << (bit % 8));
+}
+
+// Keeps only the latest value of each axis in |events|. Returns the number of
+// remaining events.
+int32_t CoalesceAxes(joystick_event* events, int32_t count) {
+  int32_t last_axis_event[JOYSTICK_MAX_AXES];
+  std::fill(std::begin(last_axis_event), std::end(last_axis_event), -1);
+  for (int32_t i = 0; i < count; i++) {
+    if ((events[i].type & JS_EVENT_AXIS) &&
+        events[i].number < JOYSTICK_MAX_AXES) {
+      last_axis_event[events[i].number] = i;
+    }
+  }
+
+  int32_t coalesced_count = 0;
+  for (int32_t i = 0; i < count; i++) {
+    if ((events[i].type & JS_EVENT_AXIS) &&
+        (events[i].number >= JOYSTICK_MAX_AXES ||
+         last_axis_event[events[i].number] != i)) {
+      continue;
+    }
+    events[coalesced_count++] = events[i];
+  }
+  return coalesced_count;
+}
+}  // namespace
+
+JoystickReader::JoystickReader(int fd, uint32_t capacity) : fd_(fd) {
+  const auto ring_size = RoundUpToPowerOfTwo(capacity > 0 ? capacity : 1);
+  ring_.reset(new joystick_event[ring_size]);
+  ring_mask_ = ring_size - 1;
+
+  memset(&state_, 0, sizeof(state_));
+  std::fill(std::begin(abs_map_), std::end(abs_map_), -1);
+  std::fill(std::begin(key_map_), std::end(key_map_), -1);
+
+  // EVIOCGVERSION fails on jsN devices.
+  int version;
+  if (ioctl(fd_, EVIOCGVERSION, &version) == 0) {
+    is_evdev_ = true;
+    SetUpEvdev();
+  } else {
+    uint8_t num_axes = 0;
+    uint8_t num_buttons = 0;
+    ioctl(fd_, JSIOCGAXES, &num_axes);
+    ioctl(fd_, JSIOCGBUTTONS, &num_buttons);
+    state_.num_axes = std::min<uint32_t>(num_axes, JOYSTICK_MAX_AXES);
+    state_.num_buttons = num_buttons;
+    for (uint32_t i = 0; i < state_.num_axes; i++) {
+      axes_[i].code = i;
+      axes_[i].minimum = -kJoydevAxisMax;
+      axes_[i].maximum = kJoydevAxisMax;
+    }
+  }
+}
+
+JoystickReader::~JoystickReader() {
+  Stop();
+  if (rumble_effect_id_ >= 0) {
+    ioctl(fd_, EVIOCRMFF, rumble_effect_id_);
+  }
+}
+
+bool JoystickReader::Start() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  stop_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (epoll_fd_ < 0 || stop_fd_ < 0) {
+    fprintf(stderr, "Failed to create an epoll instance (%d)\n", errno);
+    Stop();
+    return false;
+  }
+
+  struct epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.fd = fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd_, &ev) < 0) {
+    fprintf(stderr, "Failed to watch the joystick (%d)\n", errno);
+    Stop();
+    return false;
+  }
+  ev.data.fd = stop_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &ev);
+
+  thread_ = std::thread(&JoystickReader::Run, this);
+  return true;
+}
+
+void JoystickReader::Stop() {
+  if (thread_.joinable()) {
+    uint64_t value = 1;
+    if (write(stop_fd_, &value, sizeof(value)) < 0) {
+      fprintf(stderr, "Failed to stop the joystick reader (%d)\n", errno);
+    }
+    thread_.join();
+  }
+  if (stop_fd_ >= 0) {
+    close(stop_fd_);
+    stop_fd_ = -1;
+  }
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+  }
+}
+
+int32_t JoystickReader::Read(joystick_event* events, int32_t max_events) {
+  auto read_index = read_index_.load(std::memory_order_relaxed);
+  const auto write_index = write_index_.load(std::memory_order_acquire);
+  int32_t count = 0;
+  while (read_index < write_index && count < max_events) {
+    events[count++] = ring_[read_index & ring_mask_];
+    read_index++;
+  }
+  read_index_.store(read_index, std::memory_order_release);
+
+  const auto now = GetMonotonicTimeUs();
+  for (int32_t i = 0; i < count; i++) {
+    if (events[i].type & JS_EVENT_INIT) {
+      continue;
+    }
+    read_to_delivery_.Record(now - events[i].read_time);
+    if (is_evdev_ && events[i].time <= now) {
+      total_latency_.Record(now - events[i].time);
+    }
+  }
+  return count;
+}
+
+void JoystickReader::GetState(joystick_state* state) {
+  std::lock_guard<std::mutex> lock(mutex_state_);
+  *state = state_;
+}
+
+void JoystickReader::GetLatency(joystick_latency* latency) const {
+  kernel_to_read_.GetStats(&latency->kernel_to_read);
+  read_to_delivery_.GetStats(&latency->read_to_delivery);
+  total_latency_.GetStats(&latency->total);
+}
+
+void JoystickReader::ResetLatency() {
+  kernel_to_read_.Reset();
+  read_to_delivery_.Reset();
+  total_latency_.Reset();
+}
+
+bool JoystickReader::Rumble(float strong_magnitude, float weak_magnitude,
+                            uint32_t duration_ms) {
+  if (!has_rumble_) {
+    fprintf(stderr, "The joystick doesn't support rumble\n");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_rumble_);
+  struct ff_effect effect = {};
+  effect.type = FF_RUMBLE;
+  // Updates the uploaded effect instead of uploading a new one every time.
+  effect.id = rumble_effect_id_;
+  effect.u.rumble.strong_magnitude =
+      std::clamp(strong_magnitude, 0.0f, 1.0f) * 0xffff;
+  effect.u.rumble.weak_magnitude =
+      std::clamp(weak_magnitude, 0.0f, 1.0f) * 0xffff;
+  effect.replay.length = std::min<uint32_t>(duration_ms, 0xffff);
+  if (ioctl(fd_, EVIOCSFF, &effect) < 0) {
+    fprintf(stderr, "Failed to upload a rumble effect (%d)\n", errno);
+    return false;
+  }
+  rumble_effect_id_ = effect.id;
+
+  struct input_event play = {};
+  play.type = EV_FF;
+  play.code = effect.id;
+  play.value = 1;
+  if (write(fd_, &play, sizeof(play)) != sizeof(play)) {
+    fprintf(stderr, "Failed to play a rumble effect (%d)\n", errno);
+    return false;
+  }
+  return true;
+}
+
+void JoystickReader::SyncState() {
+  // joydev sends the initial state as JS_EVENT_INIT events by itself.
+  if (is_evdev_) {
+    SyncEvdevState();
+  }
+}
+
+void JoystickReader::Drain() {
+  if (is_evdev_) {
+    DrainEvdev();
+  } else {
+    DrainJoydev();
+  }
+}
+
+void JoystickReader::Run() {
+  SyncState();
+
+  struct epoll_event events[2];
+  while (true) {
+    auto count = epoll_wait(epoll_fd_, events, 2, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "Failed to wait for joystick events (%d)\n", errno);
+      return;
+    }
+    for (int i = 0; i < count; i++) {
+      if (events[i].data.fd == stop_fd_) {
+        return;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        is_connected_ = false;
+        return;
+      }
+    }
+    Drain();
+    if (!is_connected_) {
+      return;
+    }
+  }
+}
+
+void JoystickReader::DrainJoydev() {
+  js_event batch[kReadBatchSize];
+  joystick_event events[kReadBatchSize];
+  while (true) {
+    auto bytes = read(fd_, batch, sizeof(batch));
+    if (bytes < 0) {
+      if (errno == ENODEV) {
+        is_connected_ = false;
+      }
+      // EAGAIN means that all the pending events have been drained.
+      return;
+    }
+    const int32_t count = bytes / sizeof(js_event);
+    if (count == 0) {
+      return;
+    }
+
+    // joydev timestamps are based on jiffies and can't be compared with
+    // CLOCK_MONOTONIC, so the kernel stage isn't measured.
+    const auto read_time = GetMonotonicTimeUs();
+    for (int32_t i = 0; i < count; i++) {
+      auto& event = events[i];
+      event.time = static_cast<uint64_t>(batch[i].time) * 1000;
+      event.read_time = read_time;
+      event.value = batch[i].value;
+      event.type = batch[i].type;
+      event.number = batch[i].number;
+      event.code = batch[i].number;
+      event.normalized = (batch[i].type & JS_EVENT_AXIS)
+                             ? Normalize(batch[i].number, batch[i].value)
+                             : (batch[i].value ? 1.0f : 0.0f);
+    }
+    Publish(events, CoalesceAxes(events, count));
+
+    if (count < kReadBatchSize) {
+      return;
+    }
+  }
+}
+
+void JoystickReader::DrainEvdev() {
+  input_event batch[kReadBatchSize];
+  joystick_event events[kReadBatchSize];
+  while (true) {
+    auto bytes = read(fd_, batch, sizeof(batch));
+    if (bytes < 0) {
+      if (errno == ENODEV) {
+        is_connected_ = false;
+      }
+      return;
+    }
+    const int32_t count = bytes / sizeof(input_event);
+    if (count == 0) {
+      return;
+    }
+
+    const auto read_time = GetMonotonicTimeUs();
+    int32_t event_count = 0;
+    bool needs_sync = false;
+    for (int32_t i = 0; i < count; i++) {
+      const auto& input = batch[i];
+      if (input.type == EV_SYN) {
+        // The kernel buffer overflowed. Discards the events up to the next
+        // SYN_REPORT and reloads the state from the device.
+        if (input.code == SYN_DROPPED) {
+          is_dropping_ = true;
+        } else if (input.code == SYN_REPORT && is_dropping_) {
+          is_dropping_ = false;
+          needs_sync = true;
+        }
+        continue;
+      }
+      if (is_dropping_) {
+        continue;
+      }
+
+      auto& event = events[event_count];
+      event.time = static_cast<uint64_t>(input.input_event_sec) * 1000000 +
+                   input.input_event_usec;
+      event.read_time = read_time;
+      event.value = input.value;
+      event.code = input.code;
+      if (input.type == EV_ABS && input.code < ABS_CNT &&
+          abs_map_[input.code] >= 0) {
+        event.type = JS_EVENT_AXIS;
+        event.number = abs_map_[input.code];
+        event.normalized = Normalize(event.number, input.value);
+        event_count++;
+      } else if (input.type == EV_KEY && input.code < KEY_CNT &&
+                 key_map_[input.code] >= 0 && input.value != 2) {
+        // Value 2 is an autorepeat.
+        event.type = JS_EVENT_BUTTON;
+        event.number = key_map_[input.code];
+        event.normalized = input.value ? 1.0f : 0.0f;
+        event_count++;
+      }
+    }
+    event_count = CoalesceAxes(events, event_count);
+    for (int32_t i = 0; i < event_count; i++) {
+      if (events[i].time <= read_time) {
+        kernel_to_read_.Record(read_time - events[i].time);
+      }
+    }
+    Publish(events, event_count);
+    if (needs_sync) {
+      SyncEvdevState();
+    }
+
+    if (count < kReadBatchSize) {
+      return;
+    }
+  }
+}
+
+// Maps the axes and buttons to numbers in the same order as joydev.
+void JoystickReader::SetUpEvdev() {
+  // Reports the timestamps in the same clock as the state.
+  int clock_id = CLOCK_MONOTONIC;
+  ioctl(fd_, EVIOCSCLOCKID, &clock_id);
+
+  uint8_t abs_bits[ABS_CNT / 8 + 1] = {};
+  uint8_t key_bits[KEY_CNT / 8 + 1] = {};
+  uint8_t ff_bits[FF_CNT / 8 + 1] = {};
+  ioctl(fd_, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits);
+  ioctl(fd_, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits);
+  if (ioctl(fd_, EVIOCGBIT(EV_FF, sizeof(ff_bits)), ff_bits) >= 0) {
+    has_rumble_ = TestBit(ff_bits, FF_RUMBLE);
+  }
+
+  for (int code = 0; code < ABS_CNT; code++) {
+    if (!TestBit(abs_bits, code) || state_.num_axes >= JOYSTICK_MAX_AXES) {
+      continue;
+    }
+    struct input_absinfo info;
+    if (ioctl(fd_, EVIOCGABS(code), &info) < 0) {
+      continue;
+    }
+    auto& axis = axes_[state_.num_axes];
+    axis.code = code;
+    axis.minimum = info.minimum;
+    axis.maximum = info.maximum;
+    axis.flat = info.flat;
+    abs_map_[code] = state_.num_axes++;
+  }
+
+  auto map_key = [this, &key_bits](int code) {
+    if (TestBit(key_bits, code) &&
+        state_.num_buttons < JOYSTICK_MAX_BUTTONS) {
+      button_codes_[state_.num_buttons] = code;
+      key_map_[code] = state_.num_buttons++;
+    }
+  };
+  for (int code = BTN_JOYSTICK; code < KEY_CNT; code++) {
+    map_key(code);
+  }
+  for (int code = BTN_MISC; code < BTN_JOYSTICK; code++) {
+    map_key(code);
+  }
+}
+
+void JoystickReader::SyncEvdevState() {
+  const auto now = GetMonotonicTimeUs();
+  std::unique_ptr<joystick_event[]> events(
+      new joystick_event[state_.num_axes + state_.num_buttons]);
+  int32_t count = 0;
+
+  for (uint32_t i = 0; i < state_.num_axes; i++) {
+    struct input_absinfo info;
+    if (ioctl(fd_, EVIOCGABS(axes_[i].code), &info) < 0) {
+      continue;
+    }
+    auto& event = events[count++];
+    event.time = now;
+    event.read_time = now;
+    event.value = info.value;
+    event.normalized = Normalize(i, info.value);
+    event.type = JS_EVENT_AXIS | JS_EVENT_INIT;
+    event.number = i;
+    event.code = axes_[i].code;
+  }
+
+  uint8_t key_state[KEY_CNT / 8 + 1] = {};
+  if (ioctl(fd_, EVIOCGKEY(sizeof(key_state)), key_state) >= 0) {
+    for (uint32_t i = 0; i < state_.num_buttons; i++) {
+      const auto pressed = TestBit(key_state, button_codes_[i]);
+      auto& event = events[count++];
+      event.time = now;
+      event.read_time = now;
+      event.value = pressed ? 1 : 0;
+      event.normalized = pressed ? 1.0f : 0.0f;
+      event.type = JS_EVENT_BUTTON | JS_EVENT_INIT;
+      event.number = i;
+      event.code = button_codes_[i];
+    }
+  }
+
+  Publish(events.get(), count);
+}
+
+float JoystickReader::Normalize(uint8_t axis, int32_t value) const {
+  if (axis >= JOYSTICK_MAX_AXES) {
+    return 0.0f;
+  }
+  const auto& info = axes_[axis];
+  const auto half_range = (static_cast<float>(info.maximum) - info.minimum) / 2;
+  if (half_range <= info.flat) {
+    return 0.0f;
+  }
+
+  // Values in the flat range around the center are reported as 0, and the
+  // rest is rescaled to keep the output continuous.
+  const auto center = (static_cast<float>(info.maximum) + info.minimum) / 2;
+  const auto offset = value - center;
+  if (std::fabs(offset) <= info.flat) {
+    return 0.0f;
+  }
+  const auto magnitude =
+      std::min((std::fabs(offset) - info.flat) / (half_range - info.flat),
+               1.0f);
+  return offset < 0 ? -magnitude : magnitude;
+}
+
+void JoystickReader::Publish(joystick_event* events, int32_t count) {
+  uint64_t dropped = 0;
+  auto write_index = write_index_.load(std::memory_order_relaxed);
+  const auto read_index = read_index_.load(std::memory_order_acquire);
+  for (int32_t i = 0; i < count; i++) {
+    // Drops the newest events when the consumer falls behind, so that the
+    // consumer never sees a slot being overwritten.
+    if (write_index - read_index > ring_mask_) {
+      dropped += count - i;
+      break;
+    }
+    ring_[write_index & ring_mask_] = events[i];
+    write_index++;
+  }
+  write_index_.store(write_index, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(mutex_state_);
+  for (int32_t i = 0; i < count; i++) {
+    const auto& event = events[i];
+    if ((event.type & JS_EVENT_AXIS) && event.number < JOYSTICK_MAX_AXES) {
+      state_.axes[event.number] = event.value;
+      state_.normalized_axes[event.number] = event.normalized;
+    } else if (event.type & JS_EVENT_BUTTON) {
+      state_.buttons[event.number] = event.value ? 1 : 0;
+    }
+  }
+  state_.dropped += dropped;
+  state_.timestamp = GetMonotonicTimeUs();
+}
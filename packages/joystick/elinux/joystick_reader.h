@@ -0,0 +1,169 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_JOYSTICK_ELINUX_JOYSTICK_READER_H_
+#define PACKAGES_JOYSTICK_ELINUX_JOYSTICK_READER_H_
+
+#include <linux/input.h>
+#include <linux/joystick.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "latency_histogram.h"
+
+#define JOYSTICK_MAX_AXES 64
+#define JOYSTICK_MAX_BUTTONS 256
+
+// An event of a joystick. The layout is shared with Dart.
+struct joystick_event {
+  // Timestamp in microseconds. CLOCK_MONOTONIC for evdev devices, and the
+  // millisecond timestamp of the joydev driver for jsN devices.
+  uint64_t time;
+  // CLOCK_MONOTONIC time when the event was read from the device in
+  // microseconds.
+  uint64_t read_time;
+  // Raw value.
+  int32_t value;
+  // Axis value normalized to [-1.0, 1.0] with the dead zone of the device, or
+  // 0.0 / 1.0 for buttons.
+  float normalized;
+  // JS_EVENT_BUTTON or JS_EVENT_AXIS, with JS_EVENT_INIT for the initial
+  // state.
+  uint8_t type;
+  // Axis or button number.
+  uint8_t number;
+  // ABS_* / BTN_* code of evdev devices. Same as |number| for jsN devices.
+  uint16_t code;
+};
+
+// Current state of all axes and buttons. The layout is shared with Dart.
+struct joystick_state {
+  // CLOCK_MONOTONIC time of the last update in microseconds.
+  uint64_t timestamp;
+  // Number of events dropped because the ring buffer was full.
+  uint64_t dropped;
+  uint32_t num_axes;
+  uint32_t num_buttons;
+  int32_t axes[JOYSTICK_MAX_AXES];
+  float normalized_axes[JOYSTICK_MAX_AXES];
+  uint8_t buttons[JOYSTICK_MAX_BUTTONS];
+};
+
+// Latencies of the events delivered to the consumer. The layout is shared
+// with Dart.
+struct joystick_latency {
+  // From the kernel timestamp to the read from the device. evdev only.
+  joystick_latency_stats kernel_to_read;
+  // From the read from the device to the delivery by Read().
+  joystick_latency_stats read_to_delivery;
+  // From the kernel timestamp to the delivery by Read(). evdev only.
+  joystick_latency_stats total;
+};
+
+// Reads a joystick device on a dedicated thread woken up by epoll. Both the
+// legacy joydev API (/dev/input/jsN) and evdev (/dev/input/eventN) are
+// supported. All the pending events are drained per wakeup, the axis updates
+// in a drain are coalesced to the latest value per axis, and the events are
+// published into a single-producer single-consumer ring buffer that Dart
+// drains in batches.
+class JoystickReader {
+ public:
+  // |capacity| is rounded up to a power of two.
+  JoystickReader(int fd, uint32_t capacity);
+  ~JoystickReader();
+
+  // Prevent copying.
+  JoystickReader(JoystickReader const&) = delete;
+  JoystickReader& operator=(JoystickReader const&) = delete;
+
+  // Starts a dedicated thread reading the device. Readers driven by
+  // JoystickManager aren't started, and the manager calls SyncState() and
+  // Drain() from its own epoll loop instead.
+  bool Start();
+  void Stop();
+
+  // Publishes the current state of evdev devices as JS_EVENT_INIT events.
+  void SyncState();
+
+  // Reads all the pending events of the device without blocking.
+  void Drain();
+
+  // Marks the device as disconnected.
+  void Disconnect() { is_connected_ = false; }
+
+  int fd() const { return fd_; }
+
+  // Copies up to |max_events| events from the ring buffer. Returns the number
+  // of copied events.
+  int32_t Read(joystick_event* events, int32_t max_events);
+
+  void GetState(joystick_state* state);
+
+  // Gets the latency percentiles of the events except JS_EVENT_INIT ones.
+  void GetLatency(joystick_latency* latency) const;
+  void ResetLatency();
+
+  bool IsConnected() const { return is_connected_; }
+
+  bool IsEvdev() const { return is_evdev_; }
+
+  // Plays a rumble effect of evdev devices supporting FF_RUMBLE. The
+  // magnitudes are in [0.0, 1.0]. The fd must be opened for writing.
+  bool Rumble(float strong_magnitude, float weak_magnitude,
+              uint32_t duration_ms);
+
+ private:
+  struct AxisInfo {
+    uint16_t code = 0;
+    int32_t minimum = 0;
+    int32_t maximum = 0;
+    int32_t flat = 0;
+  };
+
+  void Run();
+  void DrainJoydev();
+  void DrainEvdev();
+  void SetUpEvdev();
+  void SyncEvdevState();
+  float Normalize(uint8_t axis, int32_t value) const;
+  void Publish(joystick_event* events, int32_t count);
+
+  const int fd_;
+  int epoll_fd_ = -1;
+  int stop_fd_ = -1;
+  std::thread thread_;
+  std::atomic<bool> is_connected_{true};
+  bool is_evdev_ = false;
+
+  // Mapping from evdev codes to the axis/button numbers. -1 means unmapped.
+  int16_t abs_map_[ABS_CNT];
+  int16_t key_map_[KEY_CNT];
+  AxisInfo axes_[JOYSTICK_MAX_AXES];
+  uint16_t button_codes_[JOYSTICK_MAX_BUTTONS];
+  // Whether the events up to the next SYN_REPORT must be discarded.
+  bool is_dropping_ = false;
+
+  bool has_rumble_ = false;
+  int16_t rumble_effect_id_ = -1;
+  std::mutex mutex_rumble_;
+
+  // Written only by the reader thread and read only by the consumer.
+  std::unique_ptr<joystick_event[]> ring_;
+  uint32_t ring_mask_;
+  std::atomic<uint64_t> write_index_{0};
+  std::atomic<uint64_t> read_index_{0};
+
+  joystick_state state_;
+  std::mutex mutex_state_;
+
+  LatencyHistogram kernel_to_read_;
+  LatencyHistogram read_to_delivery_;
+  LatencyHistogram total_latency_;
+};
+
+#endif  // PACKAGES_JOYSTICK_ELINUX_JOYSTICK_READER_H_
@@ -0,0 +1,74 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() { Reset(); }
+
+void LatencyHistogram::Record(uint64_t value_us) {
+  buckets_[GetBucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+
+  auto max = max_.load(std::memory_order_relaxed);
+  while (value_us > max &&
+         !max_.compare_exchange_weak(max, value_us,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::GetStats(joystick_latency_stats* stats) const {
+  stats->count = count_.load(std::memory_order_relaxed);
+  stats->max = max_.load(std::memory_order_relaxed);
+  stats->p50 = std::min(GetPercentile(stats->count, 0.50), stats->max);
+  stats->p99 = std::min(GetPercentile(stats->count, 0.99), stats->max);
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+// static
+int LatencyHistogram::GetBucketIndex(uint64_t value) {
+  if (value < kSubBucketCount) {
+    return value;
+  }
+  // Index of the most significant bit, which is kSubBucketBits or larger.
+  const int exponent = 63 - __builtin_clzll(value);
+  const int shift = exponent - kSubBucketBits;
+  const int sub_bucket = (value >> shift) & (kSubBucketCount - 1);
+  return std::min((shift + 1) * kSubBucketCount + sub_bucket,
+                  kBucketCount - 1);
+}
+
+// static
+uint64_t LatencyHistogram::GetBucketUpperBound(int index) {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const int shift = index / kSubBucketCount - 1;
+  const uint64_t sub_bucket = index % kSubBucketCount;
+  return ((kSubBucketCount + sub_bucket + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::GetPercentile(uint64_t count,
+                                         double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  const auto target = std::max<uint64_t>(1, count * percentile + 0.5);
+  uint64_t accumulated = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    accumulated += buckets_[i].load(std::memory_order_relaxed);
+    if (accumulated >= target) {
+      return GetBucketUpperBound(i);
+    }
+  }
+  return max_.load(std::memory_order_relaxed);
+}
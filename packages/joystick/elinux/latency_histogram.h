@@ -0,0 +1,54 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_JOYSTICK_ELINUX_LATENCY_HISTOGRAM_H_
+#define PACKAGES_JOYSTICK_ELINUX_LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Percentiles of a latency stage in microseconds. The layout is shared with
+// Dart.
+struct joystick_latency_stats {
+  uint64_t count;
+  uint64_t p50;
+  uint64_t p99;
+  uint64_t max;
+};
+
+// A lock-free histogram of latencies in microseconds. Values are bucketed
+// with 32 linear sub-buckets per power of two, so that the percentiles have
+// a relative error below about 3% up to hours.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+  ~LatencyHistogram() = default;
+
+  // Prevent copying.
+  LatencyHistogram(LatencyHistogram const&) = delete;
+  LatencyHistogram& operator=(LatencyHistogram const&) = delete;
+
+  // Can be called from any thread.
+  void Record(uint64_t value_us);
+
+  void GetStats(joystick_latency_stats* stats) const;
+
+  void Reset();
+
+ private:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+  static constexpr int kBucketCount = (64 - kSubBucketBits) * kSubBucketCount;
+
+  static int GetBucketIndex(uint64_t value);
+  static uint64_t GetBucketUpperBound(int index);
+
+  uint64_t GetPercentile(uint64_t count, double percentile) const;
+
+  std::atomic<uint64_t> buckets_[kBucketCount];
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+#endif  // PACKAGES_JOYSTICK_ELINUX_LATENCY_HISTOGRAM_H_
@@ -8,9 +8,17 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#include "joystick_manager.h"
+#include "joystick_reader.h"
+
 extern "C" __attribute__((visibility("default"))) int joystick_open(
     const char* device) {
-  int fd = open(device, O_NONBLOCK);
+  // Opens for writing to play force-feedback effects of evdev devices, and
+  // falls back to read-only when it isn't permitted.
+  int fd = open(device, O_RDWR | O_NONBLOCK);
+  if (fd < 0) {
+    fd = open(device, O_RDONLY | O_NONBLOCK);
+  }
   if (fd < 0) {
     fprintf(stderr, "Failed to open %s (%d)\n", device, errno);
   }
@@ -25,3 +33,64 @@ extern "C" __attribute__((visibility("default"))) int joystick_read(
   }
   return bytes == sizeof(*ev);
 }
+
+extern "C" __attribute__((visibility("default"))) JoystickReader*
+joystick_reader_create(int fd, uint32_t capacity) {
+  auto* reader = new JoystickReader(fd, capacity);
+  if (!reader->Start()) {
+    delete reader;
+    return nullptr;
+  }
+  return reader;
+}
+
+extern "C" __attribute__((visibility("default"))) void joystick_reader_destroy(
+    JoystickReader* reader) {
+  delete reader;
+}
+
+extern "C" __attribute__((visibility("default"))) int joystick_reader_read(
+    JoystickReader* reader, joystick_event* events, int max_events) {
+  return reader->Read(events, max_events);
+}
+
+extern "C" __attribute__((visibility("default"))) void
+joystick_reader_get_state(JoystickReader* reader, joystick_state* state) {
+  reader->GetState(state);
+}
+
+extern "C" __attribute__((visibility("default"))) int
+joystick_reader_is_connected(JoystickReader* reader) {
+  return reader->IsConnected();
+}
+
+extern "C" __attribute__((visibility("default"))) void
+joystick_reader_get_latency(JoystickReader* reader, joystick_latency* latency) {
+  reader->GetLatency(latency);
+}
+
+extern "C" __attribute__((visibility("default"))) void
+joystick_reader_reset_latency(JoystickReader* reader) {
+  reader->ResetLatency();
+}
+
+extern "C" __attribute__((visibility("default"))) int
+joystick_reader_is_evdev(JoystickReader* reader) {
+  return reader->IsEvdev();
+}
+
+extern "C" __attribute__((visibility("default"))) int joystick_reader_rumble(
+    JoystickReader* reader, float strong_magnitude, float weak_magnitude,
+    uint32_t duration_ms) {
+  return reader->Rumble(strong_magnitude, weak_magnitude, duration_ms);
+}
+
+extern "C" __attribute__((visibility("default"))) JoystickReader*
+joystick_manager_acquire_reader(int32_t id) {
+  return JoystickManager::GetInstance()->AcquireReader(id);
+}
+
+extern "C" __attribute__((visibility("default"))) void
+joystick_manager_release_reader(JoystickReader* reader) {
+  JoystickManager::GetInstance()->ReleaseReader(reader);
+}
@@ -4,8 +4,10 @@
 
 // ignore_for_file: public_member_api_docs
 
+import 'dart:async';
 import 'dart:ffi';
 import 'package:ffi/ffi.dart';
+import 'package:flutter/services.dart';
 
 DynamicLibrary _dylib = DynamicLibrary.open('libjoystick_plugin.so');
 
@@ -71,3 +73,377 @@ bool joystickInputIsAxis(JSEvent ev) {
 bool joystickButtonIsPressed(JSEvent ev) {
   return (ev.value & 1) != 0;
 }
+
+/// See: joystick_event in joystick_reader.h
+class JoystickEvent extends Struct {
+  /// Timestamp in microseconds.
+  @Uint64()
+  external int time;
+
+  /// CLOCK_MONOTONIC time when the event was read from the device in
+  /// microseconds.
+  @Uint64()
+  external int readTime;
+  @Int32()
+  external int value;
+
+  /// Axis value normalized to [-1.0, 1.0], or 0.0 / 1.0 for buttons.
+  @Float()
+  external double normalized;
+  @Uint8()
+  external int type;
+  @Uint8()
+  external int number;
+
+  /// ABS_* / BTN_* code of evdev devices.
+  @Uint16()
+  external int code;
+}
+
+/// See: joystick_state in joystick_reader.h
+class JoystickState extends Struct {
+  /// CLOCK_MONOTONIC time of the last update in microseconds.
+  @Uint64()
+  external int timestamp;
+
+  /// Number of events dropped because the ring buffer was full.
+  @Uint64()
+  external int dropped;
+  @Uint32()
+  external int numAxes;
+  @Uint32()
+  external int numButtons;
+  @Array(JOYSTICK_MAX_AXES)
+  external Array<Int32> axes;
+  @Array(JOYSTICK_MAX_AXES)
+  external Array<Float> normalizedAxes;
+  @Array(JOYSTICK_MAX_BUTTONS)
+  external Array<Uint8> buttons;
+}
+
+/// Max number of axes in [JoystickState].
+const int JOYSTICK_MAX_AXES = 64;
+
+/// Max number of buttons in [JoystickState].
+const int JOYSTICK_MAX_BUTTONS = 256;
+
+typedef JoystickReaderCreateNative = Pointer<Void> Function(
+    Int32 fd, Uint32 capacity);
+typedef JoystickReaderCreate = Pointer<Void> Function(int fd, int capacity);
+
+/// Starts a reader thread for the opened joystick device. Returns nullptr on
+/// failure.
+final JoystickReaderCreate joystickReaderCreate = _dylib
+    .lookup<NativeFunction<JoystickReaderCreateNative>>(
+        'joystick_reader_create')
+    .asFunction();
+
+typedef JoystickReaderDestroyNative = Void Function(Pointer<Void>);
+typedef JoystickReaderDestroy = void Function(Pointer<Void>);
+
+/// Stops the reader thread and releases the reader.
+final JoystickReaderDestroy joystickReaderDestroy = _dylib
+    .lookup<NativeFunction<JoystickReaderDestroyNative>>(
+        'joystick_reader_destroy')
+    .asFunction();
+
+typedef JoystickReaderReadNative = Int32 Function(
+    Pointer<Void>, Pointer<JoystickEvent>, Int32 maxEvents);
+typedef JoystickReaderRead = int Function(
+    Pointer<Void>, Pointer<JoystickEvent>, int maxEvents);
+
+/// Drains up to maxEvents events from the ring buffer of the reader. Returns
+/// the number of read events.
+final JoystickReaderRead joystickReaderRead = _dylib
+    .lookup<NativeFunction<JoystickReaderReadNative>>('joystick_reader_read')
+    .asFunction();
+
+typedef JoystickReaderGetStateNative = Void Function(
+    Pointer<Void>, Pointer<JoystickState>);
+typedef JoystickReaderGetState = void Function(
+    Pointer<Void>, Pointer<JoystickState>);
+
+/// Gets the snapshot of all axes and buttons.
+final JoystickReaderGetState joystickReaderGetState = _dylib
+    .lookup<NativeFunction<JoystickReaderGetStateNative>>(
+        'joystick_reader_get_state')
+    .asFunction();
+
+typedef JoystickReaderIsConnectedNative = Int32 Function(Pointer<Void>);
+typedef JoystickReaderIsConnected = int Function(Pointer<Void>);
+
+/// Returns 0 if the device has been disconnected.
+final JoystickReaderIsConnected joystickReaderIsConnected = _dylib
+    .lookup<NativeFunction<JoystickReaderIsConnectedNative>>(
+        'joystick_reader_is_connected')
+    .asFunction();
+
+/// See: joystick_latency_stats in latency_histogram.h
+class JoystickLatencyStats extends Struct {
+  @Uint64()
+  external int count;
+
+  /// Percentiles in microseconds.
+  @Uint64()
+  external int p50;
+  @Uint64()
+  external int p99;
+  @Uint64()
+  external int max;
+}
+
+/// See: joystick_latency in joystick_reader.h
+class JoystickLatency extends Struct {
+  /// From the kernel timestamp to the read from the device. evdev only.
+  external JoystickLatencyStats kernelToRead;
+
+  /// From the read from the device to the delivery to Dart.
+  external JoystickLatencyStats readToDelivery;
+
+  /// From the kernel timestamp to the delivery to Dart. evdev only.
+  external JoystickLatencyStats total;
+}
+
+typedef JoystickReaderGetLatencyNative = Void Function(
+    Pointer<Void>, Pointer<JoystickLatency>);
+typedef JoystickReaderGetLatency = void Function(
+    Pointer<Void>, Pointer<JoystickLatency>);
+
+/// Gets the latency percentiles of the events delivered by
+/// [joystickReaderRead].
+final JoystickReaderGetLatency joystickReaderGetLatency = _dylib
+    .lookup<NativeFunction<JoystickReaderGetLatencyNative>>(
+        'joystick_reader_get_latency')
+    .asFunction();
+
+typedef JoystickReaderResetLatencyNative = Void Function(Pointer<Void>);
+typedef JoystickReaderResetLatency = void Function(Pointer<Void>);
+
+/// Clears the latency histograms.
+final JoystickReaderResetLatency joystickReaderResetLatency = _dylib
+    .lookup<NativeFunction<JoystickReaderResetLatencyNative>>(
+        'joystick_reader_reset_latency')
+    .asFunction();
+
+typedef JoystickReaderIsEvdevNative = Int32 Function(Pointer<Void>);
+typedef JoystickReaderIsEvdev = int Function(Pointer<Void>);
+
+/// Returns 1 if the device is an evdev device (/dev/input/eventN).
+final JoystickReaderIsEvdev joystickReaderIsEvdev = _dylib
+    .lookup<NativeFunction<JoystickReaderIsEvdevNative>>(
+        'joystick_reader_is_evdev')
+    .asFunction();
+
+typedef JoystickReaderRumbleNative = Int32 Function(Pointer<Void>,
+    Float strongMagnitude, Float weakMagnitude, Uint32 durationMs);
+typedef JoystickReaderRumble = int Function(Pointer<Void>,
+    double strongMagnitude, double weakMagnitude, int durationMs);
+
+/// Plays a rumble effect. Returns 0 on failure.
+final JoystickReaderRumble joystickReaderRumble = _dylib
+    .lookup<NativeFunction<JoystickReaderRumbleNative>>(
+        'joystick_reader_rumble')
+    .asFunction();
+
+typedef JoystickManagerAcquireReaderNative = Pointer<Void> Function(Int32 id);
+typedef JoystickManagerAcquireReader = Pointer<Void> Function(int id);
+
+/// Gets the reader of a device opened by [JoystickManager]. Returns nullptr
+/// if there is no such device.
+final JoystickManagerAcquireReader joystickManagerAcquireReader = _dylib
+    .lookup<NativeFunction<JoystickManagerAcquireReaderNative>>(
+        'joystick_manager_acquire_reader')
+    .asFunction();
+
+typedef JoystickManagerReleaseReaderNative = Void Function(Pointer<Void>);
+typedef JoystickManagerReleaseReader = void Function(Pointer<Void>);
+
+/// Releases a reader got by [joystickManagerAcquireReader].
+final JoystickManagerReleaseReader joystickManagerReleaseReader = _dylib
+    .lookup<NativeFunction<JoystickManagerReleaseReaderNative>>(
+        'joystick_manager_release_reader')
+    .asFunction();
+
+/// A joystick opened by [JoystickManager].
+class JoystickDevice {
+  JoystickDevice._(this.id, this.path, this.name, this.isEvdev);
+
+  final int id;
+  final String path;
+  final String name;
+  final bool isEvdev;
+}
+
+/// A connection or disconnection of a joystick.
+class JoystickDeviceEvent {
+  JoystickDeviceEvent._(this.isConnected, this.device);
+
+  final bool isConnected;
+  final JoystickDevice device;
+}
+
+/// Watches the joysticks connected to the system.
+class JoystickManager {
+  static const MethodChannel _channel = MethodChannel('joystick/manager');
+
+  /// Interval at which the events queued by the native thread are delivered.
+  static const Duration _drainInterval = Duration(milliseconds: 100);
+
+  /// Opens the joysticks connected to the system and notifies their
+  /// connections and disconnections, starting from the devices already
+  /// connected. evdev devices (/dev/input/eventN) are used if [evdev] is
+  /// true, otherwise joydev devices (/dev/input/jsN). Only one stream can be
+  /// listened to at a time.
+  static Stream<JoystickDeviceEvent> devices(
+      {bool evdev = false, int capacity = 256}) {
+    late final StreamController<JoystickDeviceEvent> controller;
+    Timer? timer;
+    // Incremented on every listen and cancel, so that a drain in flight for
+    // a previous listener stops.
+    int session = 0;
+
+    // The native thread watching the devices only queues the events, and
+    // they are returned by this call on the platform thread. The next drain
+    // is scheduled after the previous one completes.
+    Future<void> drain(int drainSession) async {
+      List<dynamic>? events;
+      try {
+        events = await _channel.invokeListMethod<dynamic>('drainDeviceEvents');
+      } on PlatformException catch (error) {
+        controller.addError(error);
+      }
+      if (drainSession != session) {
+        return;
+      }
+      for (final dynamic event in events ?? <dynamic>[]) {
+        final Map<dynamic, dynamic> map = event as Map<dynamic, dynamic>;
+        controller.add(JoystickDeviceEvent._(
+            map['event'] == 'connected',
+            JoystickDevice._(map['id']! as int, map['path']! as String,
+                map['name']! as String, map['evdev']! as bool)));
+      }
+      timer = Timer(_drainInterval, () => drain(drainSession));
+    }
+
+    controller = StreamController<JoystickDeviceEvent>.broadcast(
+      onListen: () {
+        final int listenSession = ++session;
+        _channel.invokeMethod<void>('startWatching', <String, dynamic>{
+          'evdev': evdev,
+          'capacity': capacity,
+        }).then((_) {
+          if (listenSession == session) {
+            timer = Timer(_drainInterval, () => drain(listenSession));
+          }
+        }, onError: controller.addError);
+      },
+      onCancel: () {
+        session++;
+        timer?.cancel();
+        _channel.invokeMethod<void>('stopWatching');
+      },
+    );
+    return controller.stream;
+  }
+}
+
+/// Reads joystick events in batches from the native reader thread.
+class JoystickEventReader {
+  /// Starts reading the joystick opened by [joystickOpen].
+  JoystickEventReader(int fd, {int capacity = 256, this.batchSize = 64})
+      : _reader = joystickReaderCreate(fd, capacity),
+        _isManaged = false,
+        _events = malloc<JoystickEvent>(batchSize),
+        _state = malloc<JoystickState>(),
+        _latency = malloc<JoystickLatency>();
+
+  /// Reads a joystick opened by [JoystickManager]. The device is read by the
+  /// thread of the manager, and the reader stays valid after the device is
+  /// disconnected until [dispose] is called.
+  JoystickEventReader.fromDevice(JoystickDevice device, {this.batchSize = 64})
+      : _reader = joystickManagerAcquireReader(device.id),
+        _isManaged = true,
+        _events = malloc<JoystickEvent>(batchSize),
+        _state = malloc<JoystickState>(),
+        _latency = malloc<JoystickLatency>();
+
+  final Pointer<Void> _reader;
+  final bool _isManaged;
+  final Pointer<JoystickEvent> _events;
+  final Pointer<JoystickState> _state;
+  final Pointer<JoystickLatency> _latency;
+
+  /// Max number of events returned by [read].
+  final int batchSize;
+
+  /// Returns false if the reader thread couldn't be started, or the device
+  /// has already been closed by [JoystickManager].
+  bool get isValid => _reader != nullptr;
+
+  /// Returns false if the device has been disconnected.
+  bool get isConnected => isValid && joystickReaderIsConnected(_reader) != 0;
+
+  /// Returns true if the device is an evdev device, which reports the axes
+  /// in the native resolution and supports [rumble].
+  bool get isEvdev => isValid && joystickReaderIsEvdev(_reader) != 0;
+
+  /// Plays a rumble effect for [duration]. The magnitudes are in [0.0, 1.0].
+  /// Returns false if the device doesn't support force feedback.
+  bool rumble(double strongMagnitude, double weakMagnitude, Duration duration) {
+    if (!isValid) {
+      return false;
+    }
+    return joystickReaderRumble(_reader, strongMagnitude, weakMagnitude,
+            duration.inMilliseconds) !=
+        0;
+  }
+
+  /// Reads the pending events in one FFI call. The returned events are valid
+  /// until the next call.
+  List<JoystickEvent> read() {
+    if (!isValid) {
+      return <JoystickEvent>[];
+    }
+    final int count = joystickReaderRead(_reader, _events, batchSize);
+    return List<JoystickEvent>.generate(count, (int i) => _events[i]);
+  }
+
+  /// Gets the snapshot of all axes and buttons. The returned state is valid
+  /// until the next call.
+  JoystickState getState() {
+    if (isValid) {
+      joystickReaderGetState(_reader, _state);
+    }
+    return _state.ref;
+  }
+
+  /// Gets the latency percentiles of the events returned by [read]. The
+  /// returned latency is valid until the next call.
+  JoystickLatency getLatency() {
+    if (isValid) {
+      joystickReaderGetLatency(_reader, _latency);
+    }
+    return _latency.ref;
+  }
+
+  /// Clears the latency histograms, e.g. after a warm-up.
+  void resetLatency() {
+    if (isValid) {
+      joystickReaderResetLatency(_reader);
+    }
+  }
+
+  /// Stops the reader. The fd isn't closed.
+  void dispose() {
+    if (isValid) {
+      if (_isManaged) {
+        joystickManagerReleaseReader(_reader);
+      } else {
+        joystickReaderDestroy(_reader);
+      }
+    }
+    malloc.free(_events);
+    malloc.free(_state);
+    malloc.free(_latency);
+  }
+}
@@ -0,0 +1,154 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the input latency of JoystickReader with a virtual gamepad on
+// uinput. Axis events are generated at a fixed rate, and the events are
+// consumed by polling at a fixed interval in place of the Flutter frames.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o latency_benchmark
+//       latency_benchmark.cc ../elinux/joystick_reader.cc
+//       ../elinux/latency_histogram.cc -lpthread
+//   (in one line)
+//   $ sudo ./latency_benchmark [rate_hz] [duration_s] [poll_interval_us]
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#include "joystick_reader.h"
+#include "uinput_gamepad.h"
+
+namespace {
+constexpr int kDefaultRateHz = 1000;
+constexpr int kDefaultDurationS = 10;
+// Same as the frame interval at 60 Hz.
+constexpr int kDefaultPollIntervalUs = 16667;
+constexpr int kWarmUpMs = 500;
+
+void AddMicroseconds(struct timespec* ts, int64_t us) {
+  ts->tv_nsec += us * 1000;
+  while (ts->tv_nsec >= 1000000000) {
+    ts->tv_nsec -= 1000000000;
+    ts->tv_sec++;
+  }
+}
+
+void PrintStats(const char* name, const joystick_latency_stats& stats) {
+  printf("%-17s count=%-8llu p50=%-6lluus p99=%-6lluus max=%lluus\n", name,
+         static_cast<unsigned long long>(stats.count),
+         static_cast<unsigned long long>(stats.p50),
+         static_cast<unsigned long long>(stats.p99),
+         static_cast<unsigned long long>(stats.max));
+}
+
+// Opens the event node, waiting for devtmpfs/udev to create it.
+int OpenEventNode(const std::string& path) {
+  for (int i = 0; i < 100; i++) {
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd >= 0) {
+      return fd;
+    }
+    usleep(10000);
+  }
+  return -1;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int rate_hz = argc > 1 ? atoi(argv[1]) : kDefaultRateHz;
+  const int duration_s = argc > 2 ? atoi(argv[2]) : kDefaultDurationS;
+  const int poll_interval_us = argc > 3 ? atoi(argv[3]) : kDefaultPollIntervalUs;
+  if (rate_hz <= 0 || duration_s <= 0 || poll_interval_us <= 0) {
+    fprintf(stderr, "Usage: %s [rate_hz] [duration_s] [poll_interval_us]\n",
+            argv[0]);
+    return 1;
+  }
+
+  int uinput_fd = CreateUinputGamepad();
+  if (uinput_fd < 0) {
+    fprintf(stderr, "Failed to create the device (%d)\n", errno);
+    return 1;
+  }
+  const auto node = GetUinputEventNode(uinput_fd);
+  int fd = node.empty() ? -1 : OpenEventNode(node);
+  if (fd < 0) {
+    fprintf(stderr, "Failed to open the event node of the device\n");
+    ioctl(uinput_fd, UI_DEV_DESTROY);
+    close(uinput_fd);
+    return 1;
+  }
+
+  // Large enough not to drop the events between two polls.
+  JoystickReader reader(fd, rate_hz);
+  if (!reader.Start()) {
+    return 1;
+  }
+
+  std::atomic<bool> is_running{true};
+  std::atomic<uint64_t> generated{0};
+  std::thread producer([&]() {
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    // Toggles the value because evdev drops events with unchanged values.
+    for (int tick = 0; is_running; tick++) {
+      EmitInputEvent(uinput_fd, EV_ABS, ABS_X,
+                     tick % 2 ? kGamepadAxisMax : kGamepadAxisMin);
+      EmitInputEvent(uinput_fd, EV_SYN, SYN_REPORT, 0);
+      generated++;
+      AddMicroseconds(&next, 1000000 / rate_hz);
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    }
+  });
+
+  joystick_event events[256];
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  struct timespec next = start;
+  const int64_t total_polls =
+      (static_cast<int64_t>(duration_s) * 1000 + kWarmUpMs) * 1000 /
+      poll_interval_us;
+  const int64_t warm_up_polls =
+      static_cast<int64_t>(kWarmUpMs) * 1000 / poll_interval_us;
+  uint64_t received = 0;
+  for (int64_t poll = 0; poll < total_polls; poll++) {
+    AddMicroseconds(&next, poll_interval_us);
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+    int32_t count;
+    while ((count = reader.Read(events, 256)) > 0) {
+      received += count;
+    }
+    if (poll == warm_up_polls) {
+      reader.ResetLatency();
+    }
+  }
+  is_running = false;
+  producer.join();
+
+  joystick_latency latency;
+  reader.GetLatency(&latency);
+  joystick_state state;
+  reader.GetState(&state);
+  printf("rate=%dHz duration=%ds poll_interval=%dus\n", rate_hz, duration_s,
+         poll_interval_us);
+  printf("generated=%llu received=%llu dropped=%llu\n",
+         static_cast<unsigned long long>(generated.load()),
+         static_cast<unsigned long long>(received),
+         static_cast<unsigned long long>(state.dropped));
+  PrintStats("kernel_to_read", latency.kernel_to_read);
+  PrintStats("read_to_delivery", latency.read_to_delivery);
+  PrintStats("total", latency.total);
+
+  reader.Stop();
+  close(fd);
+  ioctl(uinput_fd, UI_DEV_DESTROY);
+  close(uinput_fd);
+  return 0;
+}
@@ -0,0 +1,96 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_JOYSTICK_TOOL_UINPUT_GAMEPAD_H_
+#define PACKAGES_JOYSTICK_TOOL_UINPUT_GAMEPAD_H_
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <initializer_list>
+#include <string>
+
+// Helpers to create a virtual gamepad on uinput, shared by the tools.
+
+constexpr int kGamepadAxisMin = 0;
+constexpr int kGamepadAxisMax = 1023;
+constexpr int kGamepadAxisFlat = 16;
+
+inline bool EmitInputEvent(int fd, int type, int code, int value) {
+  struct input_event ev = {};
+  ev.type = type;
+  ev.code = code;
+  ev.value = value;
+  return write(fd, &ev, sizeof(ev)) == sizeof(ev);
+}
+
+// Creates a gamepad with two axes, two buttons and rumble. Returns the fd of
+// /dev/uinput, or -1 on failure.
+inline int CreateUinputGamepad() {
+  int fd = open("/dev/uinput", O_RDWR | O_NONBLOCK);
+  if (fd < 0) {
+    return -1;
+  }
+
+  ioctl(fd, UI_SET_EVBIT, EV_KEY);
+  ioctl(fd, UI_SET_KEYBIT, BTN_SOUTH);
+  ioctl(fd, UI_SET_KEYBIT, BTN_EAST);
+  ioctl(fd, UI_SET_EVBIT, EV_ABS);
+  ioctl(fd, UI_SET_EVBIT, EV_FF);
+  ioctl(fd, UI_SET_FFBIT, FF_RUMBLE);
+
+  for (int code : {ABS_X, ABS_Y}) {
+    struct uinput_abs_setup abs = {};
+    abs.code = code;
+    abs.absinfo.minimum = kGamepadAxisMin;
+    abs.absinfo.maximum = kGamepadAxisMax;
+    abs.absinfo.flat = kGamepadAxisFlat;
+    if (ioctl(fd, UI_ABS_SETUP, &abs) < 0) {
+      close(fd);
+      return -1;
+    }
+  }
+
+  struct uinput_setup setup = {};
+  setup.id.bustype = BUS_VIRTUAL;
+  setup.id.vendor = 0x1234;
+  setup.id.product = 0x5678;
+  setup.ff_effects_max = 1;
+  snprintf(setup.name, UINPUT_MAX_NAME_SIZE, "flutter-elinux virtual gamepad");
+  if (ioctl(fd, UI_DEV_SETUP, &setup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Returns the /dev/input/eventN path of the created device, or an empty
+// string if it isn't found.
+inline std::string GetUinputEventNode(int fd) {
+  char sysname[64] = {};
+  if (ioctl(fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+    return std::string();
+  }
+  const auto sys_path = std::string("/sys/devices/virtual/input/") + sysname;
+  auto* dir = opendir(sys_path.c_str());
+  if (!dir) {
+    return std::string();
+  }
+  std::string node;
+  while (auto* entry = readdir(dir)) {
+    if (strncmp(entry->d_name, "event", 5) == 0) {
+      node = std::string("/dev/input/") + entry->d_name;
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+#endif  // PACKAGES_JOYSTICK_TOOL_UINPUT_GAMEPAD_H_
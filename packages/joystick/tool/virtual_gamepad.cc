@@ -0,0 +1,76 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A virtual gamepad on uinput to check the evdev backend without hardware.
+// It moves the sticks, toggles the buttons and prints the rumble effects
+// played by the joystick plugin.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -o virtual_gamepad virtual_gamepad.cc
+//   $ sudo ./virtual_gamepad
+// Then open the /dev/input/eventN device printed by the tool.
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cmath>
+
+#include "uinput_gamepad.h"
+
+namespace {
+// Answers the force-feedback requests from the clients of the device.
+void HandleFeedback(int fd) {
+  struct input_event ev;
+  while (read(fd, &ev, sizeof(ev)) == sizeof(ev)) {
+    if (ev.type == EV_UINPUT && ev.code == UI_FF_UPLOAD) {
+      struct uinput_ff_upload upload = {};
+      upload.request_id = ev.value;
+      ioctl(fd, UI_BEGIN_FF_UPLOAD, &upload);
+      printf("Rumble uploaded: strong=%u weak=%u length=%ums\n",
+             upload.effect.u.rumble.strong_magnitude,
+             upload.effect.u.rumble.weak_magnitude,
+             upload.effect.replay.length);
+      upload.retval = 0;
+      ioctl(fd, UI_END_FF_UPLOAD, &upload);
+    } else if (ev.type == EV_UINPUT && ev.code == UI_FF_ERASE) {
+      struct uinput_ff_erase erase = {};
+      erase.request_id = ev.value;
+      ioctl(fd, UI_BEGIN_FF_ERASE, &erase);
+      erase.retval = 0;
+      ioctl(fd, UI_END_FF_ERASE, &erase);
+    } else if (ev.type == EV_FF) {
+      printf("Rumble %s (effect %d)\n", ev.value ? "played" : "stopped",
+             ev.code);
+    }
+  }
+}
+}  // namespace
+
+int main() {
+  int fd = CreateUinputGamepad();
+  if (fd < 0) {
+    fprintf(stderr, "Failed to create the device (%d)\n", errno);
+    return 1;
+  }
+  printf("Created %s\n", GetUinputEventNode(fd).c_str());
+
+  const int center = (kGamepadAxisMin + kGamepadAxisMax) / 2;
+  for (int tick = 0;; tick++) {
+    const double phase = tick * 0.05;
+    EmitInputEvent(fd, EV_ABS, ABS_X, center + std::sin(phase) * center);
+    EmitInputEvent(fd, EV_ABS, ABS_Y, center + std::cos(phase) * center);
+    if (tick % 50 == 0) {
+      EmitInputEvent(fd, EV_KEY, BTN_SOUTH, (tick / 50) % 2);
+    }
+    EmitInputEvent(fd, EV_SYN, SYN_REPORT, 0);
+
+    struct pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, 10) > 0) {
+      HandleFeedback(fd);
+    }
+  }
+}
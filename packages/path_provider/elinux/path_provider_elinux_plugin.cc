@@ -0,0 +1,48 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/path_provider_elinux/path_provider_elinux_plugin.h"
+
+#include "xdg_paths.h"
+
+// The layout is shared with Dart. Null means the directory isn't available.
+struct path_provider_paths {
+  const char* temporary;
+  const char* application_support;
+  const char* application_documents;
+  const char* application_cache;
+  const char* downloads;
+  const char* application_id;
+  const char* executable_name;
+};
+
+namespace {
+const char* ToCString(const std::string& path) {
+  return path.empty() ? nullptr : path.c_str();
+}
+}  // namespace
+
+void PathProviderElinuxPluginRegisterWithRegistrar(
+    FlutterDesktopPluginRegistrarRef registrar) {
+  // Resolves the paths before the Dart code asks for them at startup.
+  GetXdgPaths();
+}
+
+// Returns all the paths at once. They are valid until the process exits.
+extern "C" __attribute__((visibility("default"))) const path_provider_paths*
+path_provider_elinux_get_paths() {
+  static const path_provider_paths paths = [] {
+    const auto& xdg_paths = GetXdgPaths();
+    return path_provider_paths{
+        ToCString(xdg_paths.temporary),
+        ToCString(xdg_paths.application_support),
+        ToCString(xdg_paths.application_documents),
+        ToCString(xdg_paths.application_cache),
+        ToCString(xdg_paths.downloads),
+        ToCString(xdg_paths.application_id),
+        ToCString(xdg_paths.executable_name),
+    };
+  }();
+  return &paths;
+}
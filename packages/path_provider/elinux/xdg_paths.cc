@@ -0,0 +1,176 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "xdg_paths.h"
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <limits.h>
+#include <pwd.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace {
+constexpr mode_t kDirectoryMode = 0700;
+
+std::string GetHomeDirectory() {
+  const char* home = getenv("HOME");
+  if (home && home[0] != '\0') {
+    return home;
+  }
+  const auto* pw = getpwuid(getuid());
+  return pw && pw->pw_dir ? pw->pw_dir : "";
+}
+
+// Gets an XDG base directory. Relative paths are invalid and ignored.
+std::string GetBaseDirectory(const char* name, const std::string& fallback) {
+  const char* value = getenv(name);
+  return value && value[0] == '/' ? value : fallback;
+}
+
+std::string GetExecutableName() {
+  char path[PATH_MAX];
+  const auto size = readlink("/proc/self/exe", path, sizeof(path) - 1);
+  if (size <= 0) {
+    return "";
+  }
+  std::string name(path, size);
+  name = name.substr(name.rfind('/') + 1);
+  // Strips the extension in the same way as path.basenameWithoutExtension().
+  const auto pos = name.rfind('.');
+  return pos == std::string::npos || pos == 0 ? name : name.substr(0, pos);
+}
+
+std::string GetApplicationId() {
+  // There can't be a default GApplication unless libgio is already loaded.
+  void* gio = dlopen("libgio-2.0.so.0", RTLD_LAZY | RTLD_NOLOAD);
+  if (!gio) {
+    return "";
+  }
+  using GetDefaultFunction = void* (*)();
+  using GetApplicationIdFunction = const char* (*)(void*);
+  auto* get_default = reinterpret_cast<GetDefaultFunction>(
+      dlsym(gio, "g_application_get_default"));
+  auto* get_application_id = reinterpret_cast<GetApplicationIdFunction>(
+      dlsym(gio, "g_application_get_application_id"));
+  std::string id;
+  void* application = get_default ? get_default() : nullptr;
+  if (application && get_application_id) {
+    const char* value = get_application_id(application);
+    id = value ? value : "";
+  }
+  dlclose(gio);
+  return id;
+}
+
+// Reads user-dirs.dirs, which has lines like XDG_DOCUMENTS_DIR="$HOME/Docs".
+// The values are relative to $HOME or absolute.
+std::map<std::string, std::string> ReadUserDirectories(
+    const std::string& path, const std::string& home) {
+  std::map<std::string, std::string> directories;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line[start] == '#' ||
+        line.compare(start, 4, "XDG_") != 0) {
+      continue;
+    }
+    const auto equal = line.find("_DIR=", start);
+    if (equal == std::string::npos) {
+      continue;
+    }
+    const auto name = line.substr(start + 4, equal - start - 4);
+    auto value = line.substr(equal + 5);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+      value = value.substr(1, value.size() - 2);
+    }
+    if (value.compare(0, 5, "$HOME") == 0) {
+      directories[name] = home + value.substr(5);
+    } else if (!value.empty() && value[0] == '/') {
+      directories[name] = value;
+    }
+  }
+  return directories;
+}
+
+bool IsDirectory(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool CreateDirectories(const std::string& directory) {
+  size_t pos = 0;
+  while (pos != std::string::npos) {
+    pos = directory.find('/', pos + 1);
+    const auto parent = directory.substr(0, pos);
+    if (mkdir(parent.c_str(), kDirectoryMode) < 0 && errno != EEXIST) {
+      std::cerr << "Failed to create " << parent << " (" << errno << ")"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+XdgPaths ResolveXdgPaths() {
+  XdgPaths paths;
+  const auto home = GetHomeDirectory();
+
+  const char* temporary = getenv("TMPDIR");
+  paths.temporary = temporary && temporary[0] != '\0' ? temporary : "/tmp";
+
+  paths.executable_name = GetExecutableName();
+  paths.application_id = GetApplicationId();
+  if (paths.application_id.empty()) {
+    paths.application_id = paths.executable_name;
+  }
+
+  const auto data_home =
+      GetBaseDirectory("XDG_DATA_HOME", home + "/.local/share");
+  paths.application_support = data_home + "/" + paths.application_id;
+  // The executable name was used as the directory originally. It's used if
+  // it exists for backwards compatibility.
+  const auto legacy_support = data_home + "/" + paths.executable_name;
+  if (!IsDirectory(paths.application_support) &&
+      IsDirectory(legacy_support)) {
+    paths.application_support = legacy_support;
+  }
+  // Created because the mobile implementations assume that they exist.
+  if (!CreateDirectories(paths.application_support)) {
+    paths.application_support.clear();
+  }
+
+  paths.application_cache =
+      GetBaseDirectory("XDG_CACHE_HOME", home + "/.cache") + "/" +
+      paths.application_id;
+  if (!CreateDirectories(paths.application_cache)) {
+    paths.application_cache.clear();
+  }
+
+  // The directories missing in user-dirs.dirs fall back to $HOME as in
+  // xdg-user-dir.
+  const auto user_directories = ReadUserDirectories(
+      GetBaseDirectory("XDG_CONFIG_HOME", home + "/.config") +
+          "/user-dirs.dirs",
+      home);
+  const auto get_user_directory = [&](const char* name) {
+    auto iter = user_directories.find(name);
+    return iter != user_directories.end() ? iter->second : home;
+  };
+  paths.application_documents = get_user_directory("DOCUMENTS");
+  paths.downloads = get_user_directory("DOWNLOAD");
+  return paths;
+}
+
+const XdgPaths& GetXdgPaths() {
+  static const XdgPaths paths = ResolveXdgPaths();
+  return paths;
+}
@@ -0,0 +1,31 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_PATH_PROVIDER_ELINUX_XDG_PATHS_H_
+#define PACKAGES_PATH_PROVIDER_ELINUX_XDG_PATHS_H_
+
+#include <string>
+
+// Directories of the application based on the XDG Base Directory
+// Specification. An empty string means the directory isn't available.
+struct XdgPaths {
+  std::string temporary;
+  std::string application_support;
+  std::string application_documents;
+  std::string application_cache;
+  std::string downloads;
+  // GApplication ID, or the executable name if there is no GApplication.
+  std::string application_id;
+  std::string executable_name;
+};
+
+// Resolves the directories from the environment, /proc/self/exe and
+// user-dirs.dirs, and creates the missing application directories with the
+// permissions of the specification (0700).
+XdgPaths ResolveXdgPaths();
+
+// Returns the paths resolved on the first call.
+const XdgPaths& GetXdgPaths();
+
+#endif  // PACKAGES_PATH_PROVIDER_ELINUX_XDG_PATHS_H_
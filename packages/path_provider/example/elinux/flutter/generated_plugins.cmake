@@ -3,6 +3,7 @@
 #
 
 list(APPEND FLUTTER_PLUGIN_LIST
+  path_provider_elinux
 )
 
 set(PLUGIN_BUNDLED_LIBRARIES)
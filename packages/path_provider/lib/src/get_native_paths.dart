@@ -0,0 +1,9 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// getNativePaths() is implemented using FFI; export a stub for platforms
+// that don't support FFI (e.g., web) to avoid having transitive dependencies
+// break web compilation.
+export 'get_native_paths_stub.dart'
+    if (dart.library.ffi) 'get_native_paths_real.dart';
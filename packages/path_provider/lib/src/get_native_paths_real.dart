@@ -0,0 +1,47 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'dart:ffi';
+import 'package:ffi/ffi.dart';
+
+import 'native_paths.dart';
+
+/// See: path_provider_paths in elinux/path_provider_elinux_plugin.cc
+class _PathProviderPaths extends Struct {
+  external Pointer<Utf8> temporary;
+  external Pointer<Utf8> applicationSupport;
+  external Pointer<Utf8> applicationDocuments;
+  external Pointer<Utf8> applicationCache;
+  external Pointer<Utf8> downloads;
+  external Pointer<Utf8> applicationId;
+  external Pointer<Utf8> executableName;
+}
+
+// const path_provider_paths* path_provider_elinux_get_paths();
+typedef _GetPaths = Pointer<_PathProviderPaths> Function();
+
+String? _toDartString(Pointer<Utf8> string) {
+  return string == nullptr ? null : string.toDartString();
+}
+
+/// Gets the paths resolved by the native library with a single call, or null
+/// if the library isn't available (e.g. in unit tests).
+NativePaths? getNativePaths() {
+  final DynamicLibrary library;
+  try {
+    library = DynamicLibrary.open('libpath_provider_elinux_plugin.so');
+  } on ArgumentError {
+    return null;
+  }
+  final _PathProviderPaths paths = library
+      .lookupFunction<_GetPaths, _GetPaths>('path_provider_elinux_get_paths')()
+      .ref;
+  return NativePaths(
+    temporary: _toDartString(paths.temporary),
+    applicationSupport: _toDartString(paths.applicationSupport),
+    applicationDocuments: _toDartString(paths.applicationDocuments),
+    applicationCache: _toDartString(paths.applicationCache),
+    downloads: _toDartString(paths.downloads),
+  );
+}
@@ -0,0 +1,8 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+import 'native_paths.dart';
+
+/// Gets the paths resolved by the native library.
+NativePaths? getNativePaths() => null;
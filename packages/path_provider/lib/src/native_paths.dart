@@ -0,0 +1,30 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/// Paths resolved and cached by the native library of the plugin.
+class NativePaths {
+  /// Constructs an instance of [NativePaths].
+  const NativePaths({
+    this.temporary,
+    this.applicationSupport,
+    this.applicationDocuments,
+    this.applicationCache,
+    this.downloads,
+  });
+
+  /// The temporary directory.
+  final String? temporary;
+
+  /// The application support directory, which exists.
+  final String? applicationSupport;
+
+  /// The documents directory of the user.
+  final String? applicationDocuments;
+
+  /// The application cache directory, which exists.
+  final String? applicationCache;
+
+  /// The downloads directory of the user.
+  final String? downloads;
+}
@@ -11,25 +11,36 @@ import 'package:path_provider_platform_interface/path_provider_platform_interfac
 import 'package:xdg_directories/xdg_directories.dart' as xdg;
 
 import 'get_application_id.dart';
+import 'get_native_paths.dart';
+import 'native_paths.dart';
 
 /// The elinux implementation of [PathProviderPlatform]
 ///
 /// This class implements the `package:path_provider` functionality for eLinux
+///
+/// The paths are resolved once by the native library of the plugin, which
+/// caches them at the plugin registration. If the library isn't available,
+/// they are resolved in Dart.
 class PathProviderELinux extends PathProviderPlatform {
   /// Constructs an instance of [PathProviderELinux]
-  PathProviderELinux() : _environment = Platform.environment;
+  PathProviderELinux()
+      : _environment = Platform.environment,
+        _nativePaths = getNativePaths();
 
   /// Constructs an instance of [PathProviderELinux] with the given [environment]
   @visibleForTesting
   PathProviderELinux.private(
       {Map<String, String> environment = const <String, String>{},
       String? executableName,
-      String? applicationId})
+      String? applicationId,
+      NativePaths? nativePaths})
       : _environment = environment,
         _executableName = executableName,
-        _applicationId = applicationId;
+        _applicationId = applicationId,
+        _nativePaths = nativePaths;
 
   final Map<String, String> _environment;
+  final NativePaths? _nativePaths;
   String? _executableName;
   String? _applicationId;
 
@@ -40,6 +51,9 @@ class PathProviderELinux extends PathProviderPlatform {
 
   @override
   Future<String?> getTemporaryPath() {
+    if (_nativePaths != null) {
+      return Future<String?>.value(_nativePaths!.temporary);
+    }
     final String environmentTmpDir = _environment['TMPDIR'] ?? '';
     return Future<String?>.value(
       environmentTmpDir.isEmpty ? '/tmp' : environmentTmpDir,
@@ -48,6 +62,9 @@ class PathProviderELinux extends PathProviderPlatform {
 
   @override
   Future<String?> getApplicationSupportPath() async {
+    if (_nativePaths != null) {
+      return _nativePaths!.applicationSupport;
+    }
     final Directory directory =
         Directory(path.join(xdg.dataHome.path, await _getId()));
     if (directory.existsSync()) {
@@ -69,11 +86,17 @@ class PathProviderELinux extends PathProviderPlatform {
 
   @override
   Future<String?> getApplicationDocumentsPath() {
+    if (_nativePaths != null) {
+      return Future<String?>.value(_nativePaths!.applicationDocuments);
+    }
     return Future<String?>.value(xdg.getUserDirectory('DOCUMENTS')?.path);
   }
 
   @override
   Future<String?> getApplicationCachePath() async {
+    if (_nativePaths != null) {
+      return _nativePaths!.applicationCache;
+    }
     final Directory directory =
         Directory(path.join(xdg.cacheHome.path, await _getId()));
     if (!directory.existsSync()) {
@@ -84,6 +107,9 @@ class PathProviderELinux extends PathProviderPlatform {
 
   @override
   Future<String?> getDownloadsPath() {
+    if (_nativePaths != null) {
+      return Future<String?>.value(_nativePaths!.downloads);
+    }
     return Future<String?>.value(xdg.getUserDirectory('DOWNLOAD')?.path);
   }
 
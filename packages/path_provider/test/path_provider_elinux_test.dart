@@ -4,6 +4,7 @@
 // found in the LICENSE file.
 import 'package:flutter_test/flutter_test.dart';
 import 'package:path_provider_elinux/path_provider_elinux.dart';
+import 'package:path_provider_elinux/src/native_paths.dart';
 import 'package:path_provider_platform_interface/path_provider_platform_interface.dart';
 import 'package:xdg_directories/xdg_directories.dart' as xdg;
 
@@ -69,4 +70,21 @@ void main() {
     final PathProviderPlatform plugin = PathProviderPlatform.instance;
     expect(await plugin.getDownloadsPath(), startsWith('/'));
   });
+
+  test('uses the paths of the native library', () async {
+    final PathProviderPlatform plugin = PathProviderELinux.private(
+      environment: <String, String>{'TMPDIR': '/run/user/0/tmp'},
+      nativePaths: const NativePaths(
+        temporary: '/native/tmp',
+        applicationSupport: '/native/support',
+        applicationDocuments: '/native/documents',
+        applicationCache: '/native/cache',
+      ),
+    );
+    expect(await plugin.getTemporaryPath(), '/native/tmp');
+    expect(await plugin.getApplicationSupportPath(), '/native/support');
+    expect(await plugin.getApplicationDocumentsPath(), '/native/documents');
+    expect(await plugin.getApplicationCachePath(), '/native/cache');
+    expect(await plugin.getDownloadsPath(), isNull);
+  });
 }
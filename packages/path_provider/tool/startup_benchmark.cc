@@ -0,0 +1,80 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the time to resolve the paths of path_provider. The first lookup
+// resolves all the paths natively, and the later lookups return the cached
+// paths. For comparison, it also measures running xdg-user-dir, which the
+// Dart implementation (package:xdg_directories) runs per user directory.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o startup_benchmark
+//       startup_benchmark.cc ../elinux/xdg_paths.cc -ldl
+//   (in one line)
+//   $ ./startup_benchmark [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <functional>
+
+#include "xdg_paths.h"
+
+namespace {
+constexpr int kDefaultIterations = 100;
+
+// Returns the average time of |function| in microseconds.
+double Measure(int iterations, const std::function<void()>& function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    function();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  return elapsed.count() / 1000.0 / iterations;
+}
+
+bool RunXdgUserDir(const char* name) {
+  const std::string command = std::string("xdg-user-dir ") + name;
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe) {
+    return false;
+  }
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), pipe)) {
+  }
+  return pclose(pipe) == 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : kDefaultIterations;
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto& paths = GetXdgPaths();
+  const auto first = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  printf("application id: %s\n", paths.application_id.c_str());
+  printf("support: %s\n", paths.application_support.c_str());
+  printf("cache: %s\n", paths.application_cache.c_str());
+  printf("documents: %s\n", paths.application_documents.c_str());
+  printf("downloads: %s\n", paths.downloads.c_str());
+  printf("\n");
+
+  printf("first lookup: %lld us\n", static_cast<long long>(first));
+  printf("resolve all paths: %.1f us\n",
+         Measure(iterations, [] { ResolveXdgPaths(); }));
+  printf("cached lookup: %.3f us\n", Measure(iterations, [] {
+           volatile auto size = GetXdgPaths().temporary.size();
+           (void)size;
+         }));
+  if (RunXdgUserDir("DOCUMENTS")) {
+    printf("xdg-user-dir (per user directory): %.1f us\n",
+           Measure(iterations, [] { RunXdgUserDir("DOCUMENTS"); }));
+  } else {
+    printf("xdg-user-dir isn't available\n");
+  }
+  return 0;
+}
@@ -0,0 +1,181 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "preference_codec.h"
+
+#include <cstring>
+
+namespace {
+constexpr uint8_t kTypeBool = 0;
+constexpr uint8_t kTypeInt = 1;
+constexpr uint8_t kTypeDouble = 2;
+constexpr uint8_t kTypeString = 3;
+constexpr uint8_t kTypeStringList = 4;
+}  // namespace
+
+uint32_t Crc32(const char* data, size_t size) {
+  static uint32_t table[256] = {};
+  static bool is_table_ready = [] {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; j++) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+      }
+      table[i] = crc;
+    }
+    return true;
+  }();
+  (void)is_table_ready;
+
+  uint32_t crc = 0xffffffff;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+  return crc ^ 0xffffffff;
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; i++) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+void AppendUint64(uint64_t value, std::string* out) {
+  for (int i = 0; i < 8; i++) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+  }
+}
+
+void AppendBytes(const std::string& bytes, std::string* out) {
+  AppendUint32(bytes.size(), out);
+  out->append(bytes);
+}
+
+void AppendPreferenceValue(const PreferenceValue& value, std::string* out) {
+  if (const auto* bool_value = std::get_if<bool>(&value)) {
+    out->push_back(kTypeBool);
+    out->push_back(*bool_value ? 1 : 0);
+  } else if (const auto* int_value = std::get_if<int64_t>(&value)) {
+    out->push_back(kTypeInt);
+    AppendUint64(*int_value, out);
+  } else if (const auto* double_value = std::get_if<double>(&value)) {
+    uint64_t bits;
+    memcpy(&bits, double_value, sizeof(bits));
+    out->push_back(kTypeDouble);
+    AppendUint64(bits, out);
+  } else if (const auto* string_value = std::get_if<std::string>(&value)) {
+    out->push_back(kTypeString);
+    AppendBytes(*string_value, out);
+  } else if (const auto* list_value =
+                 std::get_if<std::vector<std::string>>(&value)) {
+    out->push_back(kTypeStringList);
+    AppendUint32(list_value->size(), out);
+    for (const auto& element : *list_value) {
+      AppendBytes(element, out);
+    }
+  }
+}
+
+bool ByteReader::ReadUint8(uint8_t* value) {
+  if (pos_ + 1 > size_) {
+    return false;
+  }
+  *value = data_[pos_++];
+  return true;
+}
+
+bool ByteReader::ReadUint32(uint32_t* value) {
+  if (pos_ + 4 > size_) {
+    return false;
+  }
+  *value = 0;
+  for (int i = 0; i < 4; i++) {
+    *value |= static_cast<uint32_t>(static_cast<uint8_t>(data_[pos_++]))
+              << (i * 8);
+  }
+  return true;
+}
+
+bool ByteReader::ReadUint64(uint64_t* value) {
+  if (pos_ + 8 > size_) {
+    return false;
+  }
+  *value = 0;
+  for (int i = 0; i < 8; i++) {
+    *value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_++]))
+              << (i * 8);
+  }
+  return true;
+}
+
+bool ByteReader::ReadBytes(std::string* bytes) {
+  uint32_t length;
+  if (!ReadUint32(&length) || pos_ + length > size_) {
+    return false;
+  }
+  bytes->assign(data_ + pos_, length);
+  pos_ += length;
+  return true;
+}
+
+bool ByteReader::ReadPreferenceValue(PreferenceValue* value) {
+  uint8_t type;
+  if (!ReadUint8(&type)) {
+    return false;
+  }
+  switch (type) {
+    case kTypeBool: {
+      uint8_t bool_value;
+      if (!ReadUint8(&bool_value)) {
+        return false;
+      }
+      *value = bool_value != 0;
+      return true;
+    }
+    case kTypeInt: {
+      uint64_t int_value;
+      if (!ReadUint64(&int_value)) {
+        return false;
+      }
+      *value = static_cast<int64_t>(int_value);
+      return true;
+    }
+    case kTypeDouble: {
+      uint64_t bits;
+      if (!ReadUint64(&bits)) {
+        return false;
+      }
+      double double_value;
+      memcpy(&double_value, &bits, sizeof(double_value));
+      *value = double_value;
+      return true;
+    }
+    case kTypeString: {
+      std::string string_value;
+      if (!ReadBytes(&string_value)) {
+        return false;
+      }
+      *value = std::move(string_value);
+      return true;
+    }
+    case kTypeStringList: {
+      uint32_t count;
+      if (!ReadUint32(&count)) {
+        return false;
+      }
+      std::vector<std::string> list;
+      for (uint32_t i = 0; i < count; i++) {
+        std::string element;
+        if (!ReadBytes(&element)) {
+          return false;
+        }
+        list.push_back(std::move(element));
+      }
+      *value = std::move(list);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
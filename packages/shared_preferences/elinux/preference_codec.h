@@ -0,0 +1,43 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_CODEC_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_CODEC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "preference_value.h"
+
+// Binary encoding shared by the log and the snapshot of PreferencesStore.
+// All the integers are little-endian. A value is a type byte followed by
+// the data of the type.
+
+uint32_t Crc32(const char* data, size_t size);
+
+void AppendUint32(uint32_t value, std::string* out);
+void AppendUint64(uint64_t value, std::string* out);
+// Appends the size as uint32 and the bytes.
+void AppendBytes(const std::string& bytes, std::string* out);
+void AppendPreferenceValue(const PreferenceValue& value, std::string* out);
+
+// Reads the encoded data with bounds checks.
+class ByteReader {
+ public:
+  ByteReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool ReadUint8(uint8_t* value);
+  bool ReadUint32(uint32_t* value);
+  bool ReadUint64(uint64_t* value);
+  bool ReadBytes(std::string* bytes);
+  bool ReadPreferenceValue(PreferenceValue* value);
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_CODEC_H_
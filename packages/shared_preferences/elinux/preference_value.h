@@ -0,0 +1,25 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_VALUE_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_VALUE_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+// The value types supported by shared_preferences.
+using PreferenceValue = std::variant<bool, int64_t, double, std::string,
+                                     std::vector<std::string>>;
+
+using PreferenceMap = std::unordered_map<std::string, PreferenceValue>;
+
+// Latest mutation per key. std::nullopt means a removal.
+using PreferenceMutations =
+    std::unordered_map<std::string, std::optional<PreferenceValue>>;
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCE_VALUE_H_
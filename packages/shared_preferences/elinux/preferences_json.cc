@@ -0,0 +1,280 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "preferences_json.h"
+
+#include <stdlib.h>
+
+namespace {
+class JsonParser {
+ public:
+  explicit JsonParser(const std::string& json) : json_(json) {}
+
+  bool ParseObject(PreferenceMap* preferences) {
+    SkipWhitespace();
+    if (!Consume('{')) {
+      return false;
+    }
+    SkipWhitespace();
+    if (Consume('}')) {
+      return true;
+    }
+    while (true) {
+      std::string key;
+      SkipWhitespace();
+      if (!ParseString(&key)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (!Consume(':')) {
+        return false;
+      }
+      SkipWhitespace();
+      PreferenceValue value;
+      bool is_supported = false;
+      if (!ParseValue(&value, &is_supported)) {
+        return false;
+      }
+      if (is_supported) {
+        (*preferences)[key] = std::move(value);
+      }
+      SkipWhitespace();
+      if (Consume('}')) {
+        return true;
+      }
+      if (!Consume(',')) {
+        return false;
+      }
+    }
+  }
+
+ private:
+  bool ParseValue(PreferenceValue* value, bool* is_supported) {
+    if (pos_ >= json_.size()) {
+      return false;
+    }
+    const char c = json_[pos_];
+    if (c == '"') {
+      std::string str;
+      if (!ParseString(&str)) {
+        return false;
+      }
+      *value = std::move(str);
+      *is_supported = true;
+      return true;
+    }
+    if (c == '[') {
+      return ParseStringList(value, is_supported);
+    }
+    if (c == '{') {
+      // Nested objects aren't supported by shared_preferences.
+      PreferenceMap ignored;
+      *is_supported = false;
+      return ParseObject(&ignored);
+    }
+    if (ConsumeLiteral("true")) {
+      *value = true;
+      *is_supported = true;
+      return true;
+    }
+    if (ConsumeLiteral("false")) {
+      *value = false;
+      *is_supported = true;
+      return true;
+    }
+    if (ConsumeLiteral("null")) {
+      *is_supported = false;
+      return true;
+    }
+    return ParseNumber(value, is_supported);
+  }
+
+  bool ParseStringList(PreferenceValue* value, bool* is_supported) {
+    Consume('[');
+    std::vector<std::string> list;
+    *is_supported = true;
+    SkipWhitespace();
+    if (Consume(']')) {
+      *value = std::move(list);
+      return true;
+    }
+    while (true) {
+      SkipWhitespace();
+      PreferenceValue element;
+      bool is_element_supported = false;
+      if (!ParseValue(&element, &is_element_supported)) {
+        return false;
+      }
+      if (is_element_supported && std::holds_alternative<std::string>(element)) {
+        list.push_back(std::move(std::get<std::string>(element)));
+      } else {
+        *is_supported = false;
+      }
+      SkipWhitespace();
+      if (Consume(']')) {
+        break;
+      }
+      if (!Consume(',')) {
+        return false;
+      }
+    }
+    *value = std::move(list);
+    return true;
+  }
+
+  bool ParseNumber(PreferenceValue* value, bool* is_supported) {
+    const auto start = pos_;
+    bool is_integer = true;
+    while (pos_ < json_.size()) {
+      const char c = json_[pos_];
+      if (c == '.' || c == 'e' || c == 'E') {
+        is_integer = false;
+      } else if (!(c == '-' || c == '+' || (c >= '0' && c <= '9'))) {
+        break;
+      }
+      pos_++;
+    }
+    if (pos_ == start) {
+      return false;
+    }
+
+    const std::string number = json_.substr(start, pos_ - start);
+    char* end = nullptr;
+    if (is_integer) {
+      *value = static_cast<int64_t>(strtoll(number.c_str(), &end, 10));
+    } else {
+      *value = strtod(number.c_str(), &end);
+    }
+    *is_supported = true;
+    return end && *end == '\0';
+  }
+
+  bool ParseString(std::string* out) {
+    if (!Consume('"')) {
+      return false;
+    }
+    while (pos_ < json_.size()) {
+      const char c = json_[pos_++];
+      if (c == '"') {
+        return true;
+      }
+      if (c != '\\') {
+        out->push_back(c);
+        continue;
+      }
+      if (pos_ >= json_.size()) {
+        return false;
+      }
+      const char escaped = json_[pos_++];
+      switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+          out->push_back(escaped);
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ParseHex4(&code_point)) {
+            return false;
+          }
+          // Combines a surrogate pair.
+          if (code_point >= 0xd800 && code_point < 0xdc00 &&
+              json_.compare(pos_, 2, "\\u") == 0) {
+            pos_ += 2;
+            uint32_t low;
+            if (!ParseHex4(&low) || low < 0xdc00 || low >= 0xe000) {
+              return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+                         (low - 0xdc00);
+          }
+          AppendUtf8(code_point, out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  bool ParseHex4(uint32_t* value) {
+    if (pos_ + 4 > json_.size()) {
+      return false;
+    }
+    char* end = nullptr;
+    const std::string hex = json_.substr(pos_, 4);
+    *value = strtoul(hex.c_str(), &end, 16);
+    pos_ += 4;
+    return end && *end == '\0';
+  }
+
+  static void AppendUtf8(uint32_t code_point, std::string* out) {
+    if (code_point < 0x80) {
+      out->push_back(code_point);
+    } else if (code_point < 0x800) {
+      out->push_back(0xc0 | (code_point >> 6));
+      out->push_back(0x80 | (code_point & 0x3f));
+    } else if (code_point < 0x10000) {
+      out->push_back(0xe0 | (code_point >> 12));
+      out->push_back(0x80 | ((code_point >> 6) & 0x3f));
+      out->push_back(0x80 | (code_point & 0x3f));
+    } else {
+      out->push_back(0xf0 | (code_point >> 18));
+      out->push_back(0x80 | ((code_point >> 12) & 0x3f));
+      out->push_back(0x80 | ((code_point >> 6) & 0x3f));
+      out->push_back(0x80 | (code_point & 0x3f));
+    }
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < json_.size() &&
+           (json_[pos_] == ' ' || json_[pos_] == '\t' || json_[pos_] == '\n' ||
+            json_[pos_] == '\r')) {
+      pos_++;
+    }
+  }
+
+  bool Consume(char c) {
+    if (pos_ < json_.size() && json_[pos_] == c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeLiteral(const char* literal) {
+    const std::string str(literal);
+    if (json_.compare(pos_, str.size(), str) == 0) {
+      pos_ += str.size();
+      return true;
+    }
+    return false;
+  }
+
+  const std::string& json_;
+  size_t pos_ = 0;
+};
+}  // namespace
+
+bool DecodePreferencesJson(const std::string& json,
+                           PreferenceMap* preferences) {
+  JsonParser parser(json);
+  return parser.ParseObject(preferences);
+}
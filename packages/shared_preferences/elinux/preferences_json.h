@@ -0,0 +1,17 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_JSON_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_JSON_H_
+
+#include <string>
+
+#include "preference_value.h"
+
+// Decodes shared_preferences.json written by the Dart implementation, which
+// is migrated to the binary format of PreferencesStore. Values of unsupported
+// types are skipped. Returns false if |json| isn't a JSON object.
+bool DecodePreferencesJson(const std::string& json, PreferenceMap* preferences);
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_JSON_H_
@@ -0,0 +1,74 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "preferences_log.h"
+
+#include "preference_codec.h"
+
+namespace {
+constexpr uint8_t kOpSet = 1;
+constexpr uint8_t kOpRemove = 2;
+
+constexpr size_t kHeaderSize = 8;
+
+void AppendRecord(const std::string& payload, std::string* log) {
+  AppendUint32(payload.size(), log);
+  AppendUint32(Crc32(payload.data(), payload.size()), log);
+  log->append(payload);
+}
+}  // namespace
+
+void AppendSetRecord(const std::string& key, const PreferenceValue& value,
+                     std::string* log) {
+  std::string payload;
+  payload.push_back(kOpSet);
+  AppendBytes(key, &payload);
+  AppendPreferenceValue(value, &payload);
+  AppendRecord(payload, log);
+}
+
+void AppendRemoveRecord(const std::string& key, std::string* log) {
+  std::string payload;
+  payload.push_back(kOpRemove);
+  AppendBytes(key, &payload);
+  AppendRecord(payload, log);
+}
+
+size_t ReplayLog(const std::string& log, PreferenceMutations* mutations) {
+  size_t pos = 0;
+  while (pos + kHeaderSize <= log.size()) {
+    ByteReader header(log.data() + pos, kHeaderSize);
+    uint32_t payload_size;
+    uint32_t crc;
+    header.ReadUint32(&payload_size);
+    header.ReadUint32(&crc);
+    if (pos + kHeaderSize + payload_size > log.size()) {
+      break;
+    }
+    const char* payload = log.data() + pos + kHeaderSize;
+    if (Crc32(payload, payload_size) != crc) {
+      break;
+    }
+
+    ByteReader reader(payload, payload_size);
+    uint8_t op;
+    std::string key;
+    if (!reader.ReadUint8(&op) || !reader.ReadBytes(&key)) {
+      break;
+    }
+    if (op == kOpSet) {
+      PreferenceValue value;
+      if (!reader.ReadPreferenceValue(&value)) {
+        break;
+      }
+      (*mutations)[key] = std::move(value);
+    } else if (op == kOpRemove) {
+      (*mutations)[key] = std::nullopt;
+    } else {
+      break;
+    }
+    pos += kHeaderSize + payload_size;
+  }
+  return pos;
+}
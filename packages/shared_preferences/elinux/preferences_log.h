@@ -0,0 +1,27 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_LOG_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_LOG_H_
+
+#include <cstddef>
+#include <string>
+
+#include "preference_value.h"
+
+// Records of the append-only log of PreferencesStore. Each record is
+// [payload size (u32)][CRC-32 of the payload (u32)][payload], and the payload
+// is an operation with a key and, for set operations, a typed value encoded
+// as in preference_codec.h.
+
+void AppendSetRecord(const std::string& key, const PreferenceValue& value,
+                     std::string* log);
+
+void AppendRemoveRecord(const std::string& key, std::string* log);
+
+// Applies the records in |log| to |mutations| in order. Stops at the first
+// torn or corrupted record, and returns the size of the valid records.
+size_t ReplayLog(const std::string& log, PreferenceMutations* mutations);
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_LOG_H_
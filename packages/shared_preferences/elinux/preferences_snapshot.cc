@@ -0,0 +1,173 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "preferences_snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "preference_codec.h"
+
+namespace {
+constexpr char kMagic[4] = {'F', 'L', 'P', 'S'};
+constexpr uint32_t kVersion = 1;
+
+constexpr size_t kHeaderSize = 24;
+constexpr size_t kIndexEntrySize = 16;
+
+enum IndexField {
+  kKeyOffset = 0,
+  kKeySize = 1,
+  kValueOffset = 2,
+  kValueSize = 3,
+};
+}  // namespace
+
+// static
+std::unique_ptr<PreferencesSnapshot> PreferencesSnapshot::Open(
+    const std::string& path) {
+  std::unique_ptr<PreferencesSnapshot> snapshot(new PreferencesSnapshot());
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    if (errno == ENOENT) {
+      return snapshot;
+    }
+    std::cerr << "Failed to open " << path << " (" << errno << ")"
+              << std::endl;
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < kHeaderSize) {
+    std::cerr << "Invalid preferences file: " << path << std::endl;
+    close(fd);
+    return nullptr;
+  }
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Failed to map " << path << " (" << errno << ")"
+              << std::endl;
+    return nullptr;
+  }
+  snapshot->data_ = static_cast<const char*>(data);
+  snapshot->size_ = st.st_size;
+  snapshot->inode_ = st.st_ino;
+
+  ByteReader header(snapshot->data_ + sizeof(kMagic),
+                    kHeaderSize - sizeof(kMagic));
+  uint32_t version;
+  uint32_t count;
+  uint32_t reserved;
+  uint64_t file_size;
+  header.ReadUint32(&version);
+  header.ReadUint32(&count);
+  header.ReadUint32(&reserved);
+  header.ReadUint64(&file_size);
+  if (memcmp(snapshot->data_, kMagic, sizeof(kMagic)) != 0 ||
+      version != kVersion || file_size != snapshot->size_ ||
+      kHeaderSize + static_cast<uint64_t>(count) * kIndexEntrySize >
+          snapshot->size_) {
+    std::cerr << "Invalid preferences file: " << path << std::endl;
+    return nullptr;
+  }
+  snapshot->count_ = count;
+
+  // Checks the bounds once so that the accessors don't need to.
+  for (size_t i = 0; i < count; i++) {
+    const uint64_t key_end = static_cast<uint64_t>(
+                                 snapshot->ReadIndex(i, kKeyOffset)) +
+                             snapshot->ReadIndex(i, kKeySize);
+    const uint64_t value_end = static_cast<uint64_t>(
+                                   snapshot->ReadIndex(i, kValueOffset)) +
+                               snapshot->ReadIndex(i, kValueSize);
+    if (key_end > snapshot->size_ || value_end > snapshot->size_) {
+      std::cerr << "Invalid preferences file: " << path << std::endl;
+      return nullptr;
+    }
+  }
+  return snapshot;
+}
+
+// static
+std::string PreferencesSnapshot::Encode(
+    const std::map<std::string, PreferenceValue>& preferences) {
+  std::string index;
+  std::string data;
+  const size_t data_offset =
+      kHeaderSize + preferences.size() * kIndexEntrySize;
+  for (const auto& [key, value] : preferences) {
+    AppendUint32(data_offset + data.size(), &index);
+    AppendUint32(key.size(), &index);
+    data.append(key);
+    const auto value_offset = data_offset + data.size();
+    AppendPreferenceValue(value, &data);
+    AppendUint32(value_offset, &index);
+    AppendUint32(data_offset + data.size() - value_offset, &index);
+  }
+
+  std::string file(kMagic, sizeof(kMagic));
+  AppendUint32(kVersion, &file);
+  AppendUint32(preferences.size(), &file);
+  AppendUint32(0, &file);
+  AppendUint64(data_offset + data.size(), &file);
+  file.append(index);
+  file.append(data);
+  return file;
+}
+
+PreferencesSnapshot::~PreferencesSnapshot() {
+  if (data_) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+std::string_view PreferencesSnapshot::KeyAt(size_t index) const {
+  return std::string_view(data_ + ReadIndex(index, kKeyOffset),
+                          ReadIndex(index, kKeySize));
+}
+
+bool PreferencesSnapshot::ValueAt(size_t index,
+                                  PreferenceValue* value) const {
+  const auto raw_value = RawValueAt(index);
+  ByteReader reader(raw_value.data(), raw_value.size());
+  return reader.ReadPreferenceValue(value);
+}
+
+std::string_view PreferencesSnapshot::RawValueAt(size_t index) const {
+  return std::string_view(data_ + ReadIndex(index, kValueOffset),
+                          ReadIndex(index, kValueSize));
+}
+
+size_t PreferencesSnapshot::Find(std::string_view key) const {
+  const auto index = LowerBound(key);
+  return index < count_ && KeyAt(index) == key ? index : count_;
+}
+
+size_t PreferencesSnapshot::LowerBound(std::string_view key) const {
+  size_t low = 0;
+  size_t high = count_;
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (KeyAt(middle) < key) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+uint32_t PreferencesSnapshot::ReadIndex(size_t index, int field) const {
+  const auto* entry = reinterpret_cast<const uint8_t*>(
+      data_ + kHeaderSize + index * kIndexEntrySize + field * 4);
+  return entry[0] | (entry[1] << 8) | (entry[2] << 16) |
+         (static_cast<uint32_t>(entry[3]) << 24);
+}
@@ -0,0 +1,76 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_SNAPSHOT_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_SNAPSHOT_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "preference_value.h"
+
+// A snapshot of the preferences in a memory-mapped binary file. Keys are
+// found by a binary search on the sorted index, and only the values read are
+// decoded.
+//
+// Layout (little-endian):
+//   header: magic "FLPS", version (u32), entry count (u32), reserved (u32),
+//           file size (u64)
+//   index:  entry count * {key offset, key size, value offset, value size}
+//           (u32 each), sorted by the bytes of the keys
+//   data:   keys and values (encoded as in preference_codec.h)
+class PreferencesSnapshot {
+ public:
+  // Maps |path|. Returns an empty snapshot if the file doesn't exist, and
+  // nullptr if it can't be read or is invalid.
+  static std::unique_ptr<PreferencesSnapshot> Open(const std::string& path);
+
+  static std::string Encode(
+      const std::map<std::string, PreferenceValue>& preferences);
+
+  ~PreferencesSnapshot();
+
+  // Prevent copying.
+  PreferencesSnapshot(PreferencesSnapshot const&) = delete;
+  PreferencesSnapshot& operator=(PreferencesSnapshot const&) = delete;
+
+  size_t size() const { return count_; }
+
+  size_t file_size() const { return size_; }
+
+  // Inode of the mapped file, or 0 for an empty snapshot. A new inode means
+  // the file was replaced by a compaction.
+  ino_t inode() const { return inode_; }
+
+  std::string_view KeyAt(size_t index) const;
+
+  bool ValueAt(size_t index, PreferenceValue* value) const;
+
+  // Returns the encoded value, to compare values without decoding them.
+  std::string_view RawValueAt(size_t index) const;
+
+  // Returns the index of |key|, or size() if it isn't found.
+  size_t Find(std::string_view key) const;
+
+  // Returns the index of the first key not less than |key|.
+  size_t LowerBound(std::string_view key) const;
+
+ private:
+  PreferencesSnapshot() = default;
+
+  uint32_t ReadIndex(size_t index, int field) const;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  uint32_t count_ = 0;
+  ino_t inode_ = 0;
+};
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_SNAPSHOT_H_
@@ -0,0 +1,736 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "preferences_store.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/eventfd.h>
+#include <sys/file.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "preferences_json.h"
+#include "preferences_log.h"
+
+namespace {
+// The log is compacted when it exceeds this size and the snapshot.
+constexpr size_t kCompactionThreshold = 64 * 1024;
+
+std::string GetDirectory(const std::string& path) {
+  const auto pos = path.rfind('/');
+  return pos == std::string::npos ? "." : path.substr(0, pos);
+}
+
+// Returns |path| without the ".json" extension.
+std::string GetBasePath(const std::string& path) {
+  constexpr char kExtension[] = ".json";
+  constexpr size_t kExtensionSize = sizeof(kExtension) - 1;
+  if (path.size() > kExtensionSize &&
+      path.compare(path.size() - kExtensionSize, kExtensionSize,
+                   kExtension) == 0) {
+    return path.substr(0, path.size() - kExtensionSize);
+  }
+  return path;
+}
+
+std::string GetFileName(const std::string& path) {
+  const auto pos = path.rfind('/');
+  return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+bool Exists(const std::string& path) {
+  return access(path.c_str(), F_OK) == 0;
+}
+
+bool CreateDirectories(const std::string& directory) {
+  size_t pos = 0;
+  while (pos != std::string::npos) {
+    pos = directory.find('/', pos + 1);
+    const auto parent = directory.substr(0, pos);
+    if (mkdir(parent.c_str(), 0755) < 0 && errno != EEXIST) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReadFile(const std::string& path, std::string* content) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return errno == ENOENT;
+  }
+  char buffer[16 * 1024];
+  ssize_t bytes;
+  while ((bytes = read(fd, buffer, sizeof(buffer))) > 0) {
+    content->append(buffer, bytes);
+  }
+  close(fd);
+  return bytes == 0;
+}
+
+// Reads |fd| from |offset| to the end.
+bool ReadFrom(int fd, size_t offset, std::string* content) {
+  char buffer[16 * 1024];
+  ssize_t bytes;
+  while ((bytes = pread(fd, buffer, sizeof(buffer), offset)) != 0) {
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    content->append(buffer, bytes);
+    offset += bytes;
+  }
+  return true;
+}
+
+bool WriteAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    auto bytes = write(fd, data, size);
+    if (bytes < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += bytes;
+    size -= bytes;
+  }
+  return true;
+}
+}  // namespace
+
+PreferencesStore::PreferencesStore(const std::string& path)
+    : path_(path),
+      snapshot_path_(GetBasePath(path) + ".bin"),
+      log_path_(GetBasePath(path) + ".log") {}
+
+PreferencesStore::~PreferencesStore() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  cond_.notify_one();
+  if (stop_fd_ >= 0) {
+    eventfd_write(stop_fd_, 1);
+  }
+  if (watch_thread_.joinable()) {
+    watch_thread_.join();
+  }
+  // The writer thread writes the pending records before exiting.
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (inotify_fd_ >= 0) {
+    close(inotify_fd_);
+  }
+  if (stop_fd_ >= 0) {
+    close(stop_fd_);
+  }
+  if (log_fd_ >= 0) {
+    close(log_fd_);
+  }
+}
+
+bool PreferencesStore::Open() {
+  if (!CreateDirectories(GetDirectory(path_))) {
+    std::cerr << "Failed to create the directory of " << path_ << std::endl;
+    return false;
+  }
+
+  log_fd_ = open(log_path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+  if (log_fd_ < 0) {
+    std::cerr << "Failed to open " << log_path_ << std::endl;
+    return false;
+  }
+  // The other processes may be migrating or compacting the files.
+  if (!LockLog(true)) {
+    return false;
+  }
+  if (Exists(snapshot_path_) || Migrate()) {
+    snapshot_ = PreferencesSnapshot::Open(snapshot_path_);
+  }
+  if (snapshot_) {
+    snapshot_size_ = snapshot_->file_size();
+    Refresh(true);
+  }
+  UnlockLog();
+  if (!snapshot_) {
+    return false;
+  }
+
+  // Without the notifications, the changes of the other processes are still
+  // read before each write.
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  stop_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (inotify_fd_ < 0 || stop_fd_ < 0 ||
+      inotify_add_watch(inotify_fd_, GetDirectory(path_).c_str(),
+                        IN_MODIFY | IN_MOVED_TO) < 0) {
+    std::cerr << "Failed to watch the changes of " << log_path_ << std::endl;
+  } else {
+    watch_thread_ = std::thread(&PreferencesStore::Watch, this);
+  }
+
+  thread_ = std::thread(&PreferencesStore::Run, this);
+  return true;
+}
+
+bool PreferencesStore::Migrate() {
+  if (!Exists(path_)) {
+    return true;
+  }
+
+  std::string json;
+  if (!ReadFile(path_, &json)) {
+    std::cerr << "Failed to read " << path_ << std::endl;
+    return false;
+  }
+  // A corrupt file is ignored like the Dart implementation did, but kept as
+  // a backup instead of being removed.
+  PreferenceMap preferences;
+  const bool is_valid =
+      json.empty() || DecodePreferencesJson(json, &preferences);
+  const auto backup_path = path_ + ".bak";
+  if (!is_valid) {
+    std::cerr << "Failed to parse " << path_ << ", keeping it as "
+              << backup_path << std::endl;
+    preferences.clear();
+  }
+
+  const std::map<std::string, PreferenceValue> sorted(preferences.begin(),
+                                                       preferences.end());
+  if (!WriteFileAtomically(snapshot_path_,
+                           PreferencesSnapshot::Encode(sorted))) {
+    return false;
+  }
+  // The snapshot exists from now on, so the migration isn't repeated even if
+  // the removal fails.
+  if (is_valid) {
+    unlink(path_.c_str());
+  } else if (rename(path_.c_str(), backup_path.c_str()) != 0) {
+    std::cerr << "Failed to rename " << path_ << std::endl;
+  }
+  return true;
+}
+
+bool PreferencesStore::Get(const std::string& key, PreferenceValue* value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Find(key, value);
+}
+
+PreferenceMap PreferencesStore::GetAll(
+    const std::string& prefix, const std::set<std::string>* allow_list) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PreferenceMap preferences;
+  for (auto& key : GetSelectedKeys(prefix, allow_list)) {
+    PreferenceValue value;
+    if (Find(key, &value)) {
+      preferences.emplace(std::move(key), std::move(value));
+    }
+  }
+  return preferences;
+}
+
+void PreferencesStore::SetDebounceWindow(std::chrono::milliseconds window) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    debounce_window_ = window;
+  }
+  cond_.notify_one();
+}
+
+void PreferencesStore::Flush(WriteCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AddCallback(std::move(callback));
+    is_flush_requested_ = true;
+  }
+  cond_.notify_one();
+}
+
+void PreferencesStore::SetChangeCallback(ChangeCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  change_callback_ = std::move(callback);
+}
+
+PreferencesStore::WriteStats PreferencesStore::GetWriteStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void PreferencesStore::Set(const std::string& key, PreferenceValue value,
+                           WriteCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    overlay_[key] = {value, ++sequence_};
+    AddMutation(key, std::move(value));
+    AddCallback(std::move(callback));
+  }
+  cond_.notify_one();
+}
+
+void PreferencesStore::Remove(const std::string& key, WriteCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Recorded even if the key doesn't exist here, since another process may
+    // have set it and not been read yet.
+    overlay_[key] = {std::nullopt, ++sequence_};
+    AddMutation(key, std::nullopt);
+    AddCallback(std::move(callback));
+  }
+  cond_.notify_one();
+}
+
+void PreferencesStore::Clear(const std::string& prefix,
+                             const std::set<std::string>* allow_list,
+                             WriteCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& key : GetSelectedKeys(prefix, allow_list)) {
+      overlay_[key] = {std::nullopt, ++sequence_};
+      AddMutation(key, std::nullopt);
+    }
+    AddCallback(std::move(callback));
+  }
+  cond_.notify_one();
+}
+
+bool PreferencesStore::Find(const std::string& key, PreferenceValue* value) {
+  auto iter = overlay_.find(key);
+  if (iter != overlay_.end()) {
+    if (!iter->second.value) {
+      return false;
+    }
+    if (value) {
+      *value = *iter->second.value;
+    }
+    return true;
+  }
+  const auto index = snapshot_->Find(key);
+  if (index == snapshot_->size()) {
+    return false;
+  }
+  return !value || snapshot_->ValueAt(index, value);
+}
+
+std::vector<std::string> PreferencesStore::GetSelectedKeys(
+    const std::string& prefix, const std::set<std::string>* allow_list) {
+  std::vector<std::string> keys;
+  if (allow_list) {
+    for (const auto& key : *allow_list) {
+      if (IsSelected(key, prefix, nullptr) && Find(key, nullptr)) {
+        keys.push_back(key);
+      }
+    }
+    return keys;
+  }
+
+  // The keys with the prefix are contiguous in the sorted index.
+  for (auto i = snapshot_->LowerBound(prefix); i < snapshot_->size(); i++) {
+    const auto key = snapshot_->KeyAt(i);
+    if (key.compare(0, prefix.size(), prefix) != 0) {
+      break;
+    }
+    if (overlay_.find(std::string(key)) == overlay_.end()) {
+      keys.emplace_back(key);
+    }
+  }
+  for (const auto& [key, entry] : overlay_) {
+    if (entry.value && IsSelected(key, prefix, nullptr)) {
+      keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+void PreferencesStore::AddMutation(const std::string& key,
+                                   std::optional<PreferenceValue> value) {
+  stats_.write_count++;
+  auto [iter, inserted] = pending_mutations_.try_emplace(key, value);
+  if (!inserted) {
+    iter->second = std::move(value);
+    stats_.coalesced_count++;
+  }
+}
+
+void PreferencesStore::AddCallback(WriteCallback callback) {
+  if (pending_callbacks_.empty()) {
+    first_pending_time_ = std::chrono::steady_clock::now();
+  }
+  pending_callbacks_.push_back(std::move(callback));
+}
+
+void PreferencesStore::Run() {
+  while (true) {
+    bool has_pending_writes;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this] {
+        return is_stopping_ || is_refresh_requested_ ||
+               !pending_callbacks_.empty();
+      });
+      if (is_stopping_ && pending_callbacks_.empty()) {
+        return;
+      }
+      is_refresh_requested_ = false;
+      has_pending_writes = !pending_callbacks_.empty();
+      if (has_pending_writes) {
+        // Waits for more mutations to be merged into this write.
+        cond_.wait_until(lock, first_pending_time_ + debounce_window_, [this] {
+          return is_stopping_ || is_flush_requested_;
+        });
+        is_flush_requested_ = false;
+      }
+    }
+
+    if (has_pending_writes) {
+      Write();
+    } else if (LockLog(false)) {
+      Refresh(false);
+      UnlockLog();
+    }
+  }
+}
+
+void PreferencesStore::Write() {
+  // The records of the other processes are read first, so that the records
+  // written here follow them and the compaction includes them.
+  const bool is_locked = LockLog(true);
+  if (is_locked) {
+    Refresh(true);
+  }
+
+  std::string records;
+  std::vector<WriteCallback> callbacks;
+  std::shared_ptr<PreferencesSnapshot> snapshot;
+  std::map<std::string, std::optional<PreferenceValue>> overlay;
+  uint64_t sequence = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [key, value] : pending_mutations_) {
+      if (value) {
+        AppendSetRecord(key, *value, &records);
+      } else {
+        AppendRemoveRecord(key, &records);
+      }
+    }
+    pending_mutations_.clear();
+    callbacks.swap(pending_callbacks_);
+    if (!records.empty()) {
+      stats_.flush_count++;
+    }
+
+    // The overlay is taken together with the records, so that the log
+    // written below contains all the mutations in the overlay. Replaying it
+    // over the new snapshot after a crash before truncating it is harmless.
+    const auto log_size = log_size_ + records.size();
+    if (log_size > kCompactionThreshold && log_size > snapshot_size_) {
+      snapshot = snapshot_;
+      for (const auto& [key, entry] : overlay_) {
+        overlay.emplace(key, entry.value);
+      }
+      sequence = sequence_;
+    }
+  }
+
+  const bool success = is_locked && (records.empty() || AppendToLog(records));
+  for (auto& callback : callbacks) {
+    if (callback) {
+      callback(success);
+    }
+  }
+  if (success && snapshot && Compact(*snapshot, overlay, sequence)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.compaction_count++;
+  }
+  if (is_locked) {
+    UnlockLog();
+  }
+}
+
+void PreferencesStore::Refresh(bool is_exclusive) {
+  std::set<std::string> changed_keys;
+  struct stat st;
+  const ino_t inode = stat(snapshot_path_.c_str(), &st) == 0 ? st.st_ino : 0;
+  if (inode != snapshot_->inode()) {
+    // Compacted by another process, which truncated the log after that.
+    std::shared_ptr<PreferencesSnapshot> snapshot =
+        PreferencesSnapshot::Open(snapshot_path_);
+    if (!snapshot) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    DiffSnapshot(*snapshot, &changed_keys);
+    snapshot_ = std::move(snapshot);
+    snapshot_size_ = snapshot_->file_size();
+    // The mutations not written yet are kept over the new snapshot.
+    for (auto iter = overlay_.begin(); iter != overlay_.end();) {
+      if (pending_mutations_.count(iter->first) == 0) {
+        iter = overlay_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    log_size_ = 0;
+  }
+
+  // Reads only the records appended since the last read.
+  std::string log;
+  if (!ReadFrom(log_fd_, log_size_, &log)) {
+    std::cerr << "Failed to read " << log_path_ << std::endl;
+    return;
+  }
+  PreferenceMutations mutations;
+  const auto valid_size = ReplayLog(log, &mutations);
+  // Drops a record torn by a crash so that new records follow valid ones.
+  if (is_exclusive && valid_size != log.size() &&
+      ftruncate(log_fd_, log_size_ + valid_size) < 0) {
+    std::cerr << "Failed to truncate " << log_path_ << std::endl;
+  }
+
+  ChangeCallback change_callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    log_size_ += valid_size;
+    for (auto& [key, value] : mutations) {
+      // The mutations not written yet will override them.
+      if (pending_mutations_.count(key) == 0) {
+        overlay_[key] = {std::move(value), ++sequence_};
+        changed_keys.insert(key);
+      }
+    }
+    change_callback = change_callback_;
+  }
+  if (change_callback && !changed_keys.empty()) {
+    change_callback(
+        std::vector<std::string>(changed_keys.begin(), changed_keys.end()));
+  }
+}
+
+void PreferencesStore::DiffSnapshot(const PreferencesSnapshot& snapshot,
+                                    std::set<std::string>* changed_keys) {
+  // The keys in the overlay are compared below.
+  const auto is_changed = [this, changed_keys](std::string_view key) {
+    std::string key_string(key);
+    if (overlay_.find(key_string) == overlay_.end()) {
+      changed_keys->insert(std::move(key_string));
+    }
+  };
+
+  // Merge-joins the sorted indexes, comparing the encoded values.
+  size_t i = 0;
+  size_t j = 0;
+  while (i < snapshot_->size() || j < snapshot.size()) {
+    const int order = i == snapshot_->size() ? 1
+                      : j == snapshot.size()
+                          ? -1
+                          : snapshot_->KeyAt(i).compare(snapshot.KeyAt(j));
+    if (order < 0) {
+      is_changed(snapshot_->KeyAt(i++));
+    } else if (order > 0) {
+      is_changed(snapshot.KeyAt(j++));
+    } else {
+      if (snapshot_->RawValueAt(i) != snapshot.RawValueAt(j)) {
+        is_changed(snapshot.KeyAt(j));
+      }
+      i++;
+      j++;
+    }
+  }
+
+  for (const auto& [key, entry] : overlay_) {
+    if (pending_mutations_.count(key) > 0) {
+      continue;
+    }
+    std::optional<PreferenceValue> value;
+    const auto index = snapshot.Find(key);
+    if (index < snapshot.size()) {
+      value.emplace();
+      snapshot.ValueAt(index, &*value);
+    }
+    if (value != entry.value) {
+      changed_keys->insert(key);
+    }
+  }
+}
+
+void PreferencesStore::Watch() {
+  const auto log_name = GetFileName(log_path_);
+  const auto snapshot_name = GetFileName(snapshot_path_);
+  alignas(struct inotify_event) char buffer[4096];
+  struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {stop_fd_, POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    if (fds[1].revents) {
+      return;
+    }
+
+    bool is_changed = false;
+    ssize_t bytes;
+    while ((bytes = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+      for (char* p = buffer; p < buffer + bytes;) {
+        const auto* event = reinterpret_cast<struct inotify_event*>(p);
+        if (event->len > 0 &&
+            (log_name == event->name || snapshot_name == event->name)) {
+          is_changed = true;
+        }
+        p += sizeof(struct inotify_event) + event->len;
+      }
+    }
+    if (is_changed) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_refresh_requested_ = true;
+      }
+      cond_.notify_one();
+    }
+  }
+}
+
+bool PreferencesStore::LockLog(bool is_exclusive) {
+  // OFD locks are owned by the open file description, so that they also
+  // exclude the other stores of this process unlike the POSIX record locks.
+  struct flock lock = {};
+  lock.l_type = is_exclusive ? F_WRLCK : F_RDLCK;
+  lock.l_whence = SEEK_SET;
+  int result;
+  do {
+    result = fcntl(log_fd_, F_OFD_SETLKW, &lock);
+  } while (result < 0 && errno == EINTR);
+  if (result < 0 && errno == EINVAL) {
+    // Kernels before 3.15 don't support OFD locks.
+    do {
+      result = flock(log_fd_, is_exclusive ? LOCK_EX : LOCK_SH);
+    } while (result < 0 && errno == EINTR);
+  }
+  if (result < 0) {
+    std::cerr << "Failed to lock " << log_path_ << " (" << errno << ")"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void PreferencesStore::UnlockLog() {
+  struct flock lock = {};
+  lock.l_type = F_UNLCK;
+  lock.l_whence = SEEK_SET;
+  if (fcntl(log_fd_, F_OFD_SETLK, &lock) < 0) {
+    flock(log_fd_, LOCK_UN);
+  }
+}
+
+bool PreferencesStore::AppendToLog(const std::string& records) {
+  lseek(log_fd_, log_size_, SEEK_SET);
+  if (!WriteAll(log_fd_, records.data(), records.size()) ||
+      fdatasync(log_fd_) < 0) {
+    std::cerr << "Failed to write " << log_path_ << " (" << errno << ")"
+              << std::endl;
+    // Drops the partial write so that later records aren't lost behind it.
+    if (ftruncate(log_fd_, log_size_) < 0) {
+      std::cerr << "Failed to truncate " << log_path_ << std::endl;
+    }
+    return false;
+  }
+  log_size_ += records.size();
+  return true;
+}
+
+bool PreferencesStore::Compact(
+    const PreferencesSnapshot& snapshot,
+    const std::map<std::string, std::optional<PreferenceValue>>& overlay,
+    uint64_t sequence) {
+  std::map<std::string, PreferenceValue> preferences;
+  for (size_t i = 0; i < snapshot.size(); i++) {
+    std::string key(snapshot.KeyAt(i));
+    PreferenceValue value;
+    if (overlay.find(key) == overlay.end() && snapshot.ValueAt(i, &value)) {
+      preferences.emplace_hint(preferences.end(), std::move(key),
+                               std::move(value));
+    }
+  }
+  for (const auto& [key, value] : overlay) {
+    if (value) {
+      preferences[key] = *value;
+    }
+  }
+
+  const auto data = PreferencesSnapshot::Encode(preferences);
+  if (!WriteFileAtomically(snapshot_path_, data)) {
+    return false;
+  }
+  std::shared_ptr<PreferencesSnapshot> new_snapshot =
+      PreferencesSnapshot::Open(snapshot_path_);
+  if (!new_snapshot) {
+    return false;
+  }
+  snapshot_size_ = data.size();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_ = std::move(new_snapshot);
+    // Keeps the entries mutated after the overlay was taken.
+    for (auto iter = overlay_.begin(); iter != overlay_.end();) {
+      if (iter->second.sequence <= sequence) {
+        iter = overlay_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  if (ftruncate(log_fd_, 0) < 0 || fdatasync(log_fd_) < 0) {
+    std::cerr << "Failed to truncate " << log_path_ << std::endl;
+    return false;
+  }
+  log_size_ = 0;
+  return true;
+}
+
+bool PreferencesStore::WriteFileAtomically(const std::string& path,
+                                           const std::string& data) {
+  const auto temp_path = path + ".tmp";
+  int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0666);
+  if (fd < 0) {
+    std::cerr << "Failed to open " << temp_path << std::endl;
+    return false;
+  }
+  const bool written =
+      WriteAll(fd, data.data(), data.size()) && fsync(fd) == 0;
+  close(fd);
+  if (!written || rename(temp_path.c_str(), path.c_str()) < 0) {
+    std::cerr << "Failed to write " << path << " (" << errno << ")"
+              << std::endl;
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  // Makes the rename durable.
+  int dir_fd = open(GetDirectory(path).c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd >= 0) {
+    fsync(dir_fd);
+    close(dir_fd);
+  }
+  return true;
+}
+
+// static
+bool PreferencesStore::IsSelected(const std::string& key,
+                                  const std::string& prefix,
+                                  const std::set<std::string>* allow_list) {
+  return key.compare(0, prefix.size(), prefix) == 0 &&
+         (!allow_list || allow_list->count(key) > 0);
+}
@@ -0,0 +1,179 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_STORE_H_
+#define PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_STORE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "preference_value.h"
+#include "preferences_snapshot.h"
+
+// Keeps the preferences in a memory-mapped snapshot (shared_preferences.bin)
+// and an in-memory overlay of the later mutations, and persists the mutations
+// in the background. Each mutation is appended to a log
+// (shared_preferences.log) as a small record, and the log is compacted into
+// the snapshot when it grows. The snapshot is replaced atomically by writing
+// a temporary file, fsync and rename. An existing shared_preferences.json of
+// the Dart implementation is migrated to the snapshot when it's opened first.
+//
+// Mutations are batched: the writer thread waits for the debounce window
+// after the first pending mutation, merges the mutations of the same key and
+// writes them with one fdatasync.
+//
+// The files can be shared by several processes. The writers append and
+// compact under an exclusive lock of the log, and each process reads the
+// records appended by the others (or the snapshot replaced by them) before
+// its writes and when inotify reports a change, so that only the changed keys
+// are reloaded.
+class PreferencesStore {
+ public:
+  // Called on the writer thread once the mutation is durable, or failed.
+  using WriteCallback = std::function<void(bool success)>;
+
+  // Called on the writer thread with the keys changed by other processes.
+  using ChangeCallback =
+      std::function<void(const std::vector<std::string>& keys)>;
+
+  struct WriteStats {
+    // Number of the mutations of keys.
+    uint64_t write_count = 0;
+    // Number of the mutations merged into a later mutation of the same key
+    // before being written.
+    uint64_t coalesced_count = 0;
+    // Number of the durable writes of the log.
+    uint64_t flush_count = 0;
+    uint64_t compaction_count = 0;
+  };
+
+  // |path| is the path of shared_preferences.json. The other files are
+  // stored in the same directory.
+  explicit PreferencesStore(const std::string& path);
+  ~PreferencesStore();
+
+  // Prevent copying.
+  PreferencesStore(PreferencesStore const&) = delete;
+  PreferencesStore& operator=(PreferencesStore const&) = delete;
+
+  // Maps the snapshot, replays the log and starts the writer thread.
+  bool Open();
+
+  const std::string& path() const { return path_; }
+
+  // 0 writes the pending mutations as soon as the previous write finishes.
+  void SetDebounceWindow(std::chrono::milliseconds window);
+
+  // Writes the pending mutations without waiting for the debounce window.
+  void Flush(WriteCallback callback);
+
+  WriteStats GetWriteStats();
+
+  void SetChangeCallback(ChangeCallback callback);
+
+  // Gets the value of |key|. Only this value is decoded from the snapshot.
+  bool Get(const std::string& key, PreferenceValue* value);
+
+  // Returns the preferences whose keys start with |prefix| and, if
+  // |allow_list| isn't null, are contained in it. Only the selected values
+  // are decoded from the snapshot.
+  PreferenceMap GetAll(const std::string& prefix,
+                       const std::set<std::string>* allow_list);
+
+  void Set(const std::string& key, PreferenceValue value,
+           WriteCallback callback);
+
+  void Remove(const std::string& key, WriteCallback callback);
+
+  // Removes the preferences selected in the same way as GetAll().
+  void Clear(const std::string& prefix,
+             const std::set<std::string>* allow_list, WriteCallback callback);
+
+ private:
+  struct OverlayEntry {
+    // std::nullopt means a removal.
+    std::optional<PreferenceValue> value;
+    // Order of the mutation, to find the entries folded into a snapshot.
+    uint64_t sequence = 0;
+  };
+
+  bool Migrate();
+  void Run();
+  void Write();
+  // Reads the changes of the other processes. Must be called on the writer
+  // thread with the lock of the log held.
+  void Refresh(bool is_exclusive);
+  // Must be called with |mutex_| held.
+  void DiffSnapshot(const PreferencesSnapshot& snapshot,
+                    std::set<std::string>* changed_keys);
+  // Watches the files on a dedicated thread and requests a refresh on
+  // changes.
+  void Watch();
+  bool LockLog(bool is_exclusive);
+  void UnlockLog();
+  // The following must be called with |mutex_| held.
+  // |value| can be null to check the existence.
+  bool Find(const std::string& key, PreferenceValue* value);
+  std::vector<std::string> GetSelectedKeys(
+      const std::string& prefix, const std::set<std::string>* allow_list);
+  void AddMutation(const std::string& key,
+                   std::optional<PreferenceValue> value);
+  void AddCallback(WriteCallback callback);
+
+  bool AppendToLog(const std::string& records);
+  // Merges |overlay| into |snapshot|, and replaces the snapshot file.
+  bool Compact(const PreferencesSnapshot& snapshot,
+               const std::map<std::string, std::optional<PreferenceValue>>&
+                   overlay,
+               uint64_t sequence);
+  bool WriteFileAtomically(const std::string& path, const std::string& data);
+
+  static bool IsSelected(const std::string& key, const std::string& prefix,
+                         const std::set<std::string>* allow_list);
+
+  const std::string path_;
+  const std::string snapshot_path_;
+  const std::string log_path_;
+  int log_fd_ = -1;
+  int inotify_fd_ = -1;
+  int stop_fd_ = -1;
+  // Written only by the writer thread after Open(). The size of the log read
+  // or written by this process.
+  size_t log_size_ = 0;
+  size_t snapshot_size_ = 0;
+
+  // Replaced by the writer thread after the compactions of this or the other
+  // processes. The writer thread holds a reference while it merges the
+  // overlay into it.
+  std::shared_ptr<PreferencesSnapshot> snapshot_;
+  // Mutations not compacted into |snapshot_| yet.
+  std::unordered_map<std::string, OverlayEntry> overlay_;
+  uint64_t sequence_ = 0;
+  // Mutations and callbacks not written to the log yet.
+  std::unordered_map<std::string, std::optional<PreferenceValue>>
+      pending_mutations_;
+  std::vector<WriteCallback> pending_callbacks_;
+  std::chrono::steady_clock::time_point first_pending_time_;
+  std::chrono::milliseconds debounce_window_{0};
+  bool is_flush_requested_ = false;
+  bool is_refresh_requested_ = false;
+  bool is_stopping_ = false;
+  WriteStats stats_;
+  ChangeCallback change_callback_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+  std::thread watch_thread_;
+};
+
+#endif  // PACKAGES_SHARED_PREFERENCES_ELINUX_PREFERENCES_STORE_H_
@@ -0,0 +1,319 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/shared_preferences_elinux/shared_preferences_elinux_plugin.h"
+
+#include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
+#include <flutter/plugin_registrar.h>
+#include <flutter/standard_method_codec.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "preferences_store.h"
+
+namespace {
+constexpr char kChannelName[] = "plugins.flutter.io/shared_preferences_elinux";
+constexpr char kInvalidArgument[] = "Invalid argument";
+constexpr char kStoreError[] = "Store error";
+
+template <typename T>
+bool GetValueFromEncodableMap(const flutter::EncodableMap* map,
+                              const char* key, T& out) {
+  auto iter = map->find(flutter::EncodableValue(key));
+  if (iter != map->end() && !iter->second.IsNull()) {
+    if (auto* value = std::get_if<T>(&iter->second)) {
+      out = *value;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ToPreferenceValue(const flutter::EncodableValue& value,
+                       PreferenceValue* out) {
+  if (auto* bool_value = std::get_if<bool>(&value)) {
+    *out = *bool_value;
+  } else if (auto* int32_value = std::get_if<int32_t>(&value)) {
+    *out = static_cast<int64_t>(*int32_value);
+  } else if (auto* int64_value = std::get_if<int64_t>(&value)) {
+    *out = *int64_value;
+  } else if (auto* double_value = std::get_if<double>(&value)) {
+    *out = *double_value;
+  } else if (auto* string_value = std::get_if<std::string>(&value)) {
+    *out = *string_value;
+  } else if (auto* list_value = std::get_if<flutter::EncodableList>(&value)) {
+    std::vector<std::string> list;
+    for (const auto& element : *list_value) {
+      auto* string_element = std::get_if<std::string>(&element);
+      if (!string_element) {
+        return false;
+      }
+      list.push_back(*string_element);
+    }
+    *out = std::move(list);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+flutter::EncodableValue ToEncodableValue(const PreferenceValue& value) {
+  if (auto* bool_value = std::get_if<bool>(&value)) {
+    return flutter::EncodableValue(*bool_value);
+  } else if (auto* int_value = std::get_if<int64_t>(&value)) {
+    return flutter::EncodableValue(*int_value);
+  } else if (auto* double_value = std::get_if<double>(&value)) {
+    return flutter::EncodableValue(*double_value);
+  } else if (auto* string_value = std::get_if<std::string>(&value)) {
+    return flutter::EncodableValue(*string_value);
+  }
+  flutter::EncodableList list;
+  for (const auto& element : std::get<std::vector<std::string>>(value)) {
+    list.push_back(flutter::EncodableValue(element));
+  }
+  return flutter::EncodableValue(list);
+}
+
+// Gets "prefix" and the optional "allowList" of the filter.
+bool GetFilter(const flutter::EncodableMap* arguments, std::string& prefix,
+               std::unique_ptr<std::set<std::string>>& allow_list) {
+  if (!GetValueFromEncodableMap(arguments, "prefix", prefix)) {
+    return false;
+  }
+  flutter::EncodableList list;
+  if (GetValueFromEncodableMap(arguments, "allowList", list)) {
+    allow_list = std::make_unique<std::set<std::string>>();
+    for (const auto& element : list) {
+      if (auto* key = std::get_if<std::string>(&element)) {
+        allow_list->insert(*key);
+      }
+    }
+  }
+  return true;
+}
+
+class SharedPreferencesElinuxPlugin : public flutter::Plugin {
+ public:
+  static void RegisterWithRegistrar(flutter::PluginRegistrar* registrar) {
+    auto plugin = std::make_unique<SharedPreferencesElinuxPlugin>();
+    auto channel =
+        std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kChannelName,
+            &flutter::StandardMethodCodec::GetInstance());
+    channel->SetMethodCallHandler(
+        [plugin_pointer = plugin.get()](const auto& call, auto result) {
+          plugin_pointer->HandleMethodCall(call, std::move(result));
+        });
+
+    registrar->AddPlugin(std::move(plugin));
+  }
+
+  SharedPreferencesElinuxPlugin() {}
+
+  virtual ~SharedPreferencesElinuxPlugin() {}
+
+ private:
+  void HandleMethodCall(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+    if (method_call.method_name() == "watchChanges") {
+      SetWatchingChanges(true);
+      result->Success();
+      return;
+    }
+    if (method_call.method_name() == "unwatchChanges") {
+      SetWatchingChanges(false);
+      result->Success();
+      return;
+    }
+    if (method_call.method_name() == "drainChangeEvents") {
+      result->Success(flutter::EncodableValue(DrainChangeEvents()));
+      return;
+    }
+
+    const auto* arguments =
+        std::get_if<flutter::EncodableMap>(method_call.arguments());
+    if (!arguments) {
+      result->Error(kInvalidArgument, "No arguments provided.");
+      return;
+    }
+
+    const auto& method_name = method_call.method_name();
+    if (method_name == "open") {
+      std::string path;
+      if (!GetValueFromEncodableMap(arguments, "path", path)) {
+        result->Error(kInvalidArgument, "No path provided.");
+        return;
+      }
+      if (!store_ || store_->path() != path) {
+        store_ = nullptr;
+        auto store = std::make_unique<PreferencesStore>(path);
+        if (!store->Open()) {
+          result->Error(kStoreError, "Failed to open " + path);
+          return;
+        }
+        store->SetDebounceWindow(debounce_window_);
+        store->SetChangeCallback(
+            [this](const std::vector<std::string>& keys) {
+              QueueChangeEvent(keys);
+            });
+        store_ = std::move(store);
+      }
+      result->Success();
+      return;
+    }
+    if (method_name == "setWriteConfig") {
+      int32_t debounce_ms;
+      if (!GetValueFromEncodableMap(arguments, "debounceMs", debounce_ms) ||
+          debounce_ms < 0) {
+        result->Error(kInvalidArgument, "Invalid debounceMs.");
+        return;
+      }
+      debounce_window_ = std::chrono::milliseconds(debounce_ms);
+      if (store_) {
+        store_->SetDebounceWindow(debounce_window_);
+      }
+      result->Success();
+      return;
+    }
+
+    if (!store_) {
+      result->Error(kStoreError, "The store isn't opened.");
+      return;
+    }
+
+    // The results of the mutations are sent from the writer thread of the
+    // store once the data is on disk. Unlike the change events, method
+    // results don't need to be sent on the platform thread.
+    std::shared_ptr<flutter::MethodResult<flutter::EncodableValue>>
+        shared_result = std::move(result);
+    auto on_written = [shared_result](bool success) {
+      shared_result->Success(flutter::EncodableValue(success));
+    };
+
+    if (method_name == "get") {
+      std::string key;
+      if (!GetValueFromEncodableMap(arguments, "key", key)) {
+        shared_result->Error(kInvalidArgument, "No key provided.");
+        return;
+      }
+      PreferenceValue value;
+      if (store_->Get(key, &value)) {
+        shared_result->Success(ToEncodableValue(value));
+      } else {
+        shared_result->Success();
+      }
+    } else if (method_name == "getAll") {
+      std::string prefix;
+      std::unique_ptr<std::set<std::string>> allow_list;
+      if (!GetFilter(arguments, prefix, allow_list)) {
+        shared_result->Error(kInvalidArgument, "No prefix provided.");
+        return;
+      }
+      flutter::EncodableMap map;
+      for (const auto& [key, value] :
+           store_->GetAll(prefix, allow_list.get())) {
+        map[flutter::EncodableValue(key)] = ToEncodableValue(value);
+      }
+      shared_result->Success(flutter::EncodableValue(map));
+    } else if (method_name == "setValue") {
+      std::string key;
+      PreferenceValue value;
+      auto iter = arguments->find(flutter::EncodableValue("value"));
+      if (!GetValueFromEncodableMap(arguments, "key", key) ||
+          iter == arguments->end() ||
+          !ToPreferenceValue(iter->second, &value)) {
+        shared_result->Error(kInvalidArgument, "Invalid key or value.");
+        return;
+      }
+      store_->Set(key, std::move(value), on_written);
+    } else if (method_name == "remove") {
+      std::string key;
+      if (!GetValueFromEncodableMap(arguments, "key", key)) {
+        shared_result->Error(kInvalidArgument, "No key provided.");
+        return;
+      }
+      store_->Remove(key, on_written);
+    } else if (method_name == "clear") {
+      std::string prefix;
+      std::unique_ptr<std::set<std::string>> allow_list;
+      if (!GetFilter(arguments, prefix, allow_list)) {
+        shared_result->Error(kInvalidArgument, "No prefix provided.");
+        return;
+      }
+      store_->Clear(prefix, allow_list.get(), on_written);
+    } else if (method_name == "flush") {
+      store_->Flush(on_written);
+    } else if (method_name == "getWriteStats") {
+      const auto stats = store_->GetWriteStats();
+      flutter::EncodableMap map = {
+          {flutter::EncodableValue("writeCount"),
+           flutter::EncodableValue(static_cast<int64_t>(stats.write_count))},
+          {flutter::EncodableValue("coalescedCount"),
+           flutter::EncodableValue(
+               static_cast<int64_t>(stats.coalesced_count))},
+          {flutter::EncodableValue("flushCount"),
+           flutter::EncodableValue(static_cast<int64_t>(stats.flush_count))},
+          {flutter::EncodableValue("compactionCount"),
+           flutter::EncodableValue(
+               static_cast<int64_t>(stats.compaction_count))},
+      };
+      shared_result->Success(flutter::EncodableValue(map));
+    } else {
+      shared_result->NotImplemented();
+    }
+  }
+
+  // The changes are queued only while they're watched.
+  void SetWatchingChanges(bool is_watching) {
+    std::lock_guard<std::mutex> lock(mutex_change_events_);
+    is_watching_changes_ = is_watching;
+    pending_change_events_.clear();
+  }
+
+  // Called on the writer thread of the store. The keys are queued until
+  // they're returned by DrainChangeEvents().
+  void QueueChangeEvent(const std::vector<std::string>& keys) {
+    flutter::EncodableList list;
+    for (const auto& key : keys) {
+      list.push_back(flutter::EncodableValue(key));
+    }
+    std::lock_guard<std::mutex> lock(mutex_change_events_);
+    if (is_watching_changes_) {
+      pending_change_events_.push_back(flutter::EncodableValue(list));
+    }
+  }
+
+  // Returns the queued changes as the result of the method call, since the
+  // plugin can't post them to the platform thread by itself.
+  flutter::EncodableList DrainChangeEvents() {
+    flutter::EncodableList events;
+    std::lock_guard<std::mutex> lock(mutex_change_events_);
+    events.swap(pending_change_events_);
+    return events;
+  }
+
+  bool is_watching_changes_ = false;
+  flutter::EncodableList pending_change_events_;
+  std::mutex mutex_change_events_;
+  // Declared after the queue so that the writer thread is stopped first.
+  std::unique_ptr<PreferencesStore> store_;
+  std::chrono::milliseconds debounce_window_{0};
+};
+
+}  // namespace
+
+void SharedPreferencesElinuxPluginRegisterWithRegistrar(
+    FlutterDesktopPluginRegistrarRef registrar) {
+  SharedPreferencesElinuxPlugin::RegisterWithRegistrar(
+      flutter::PluginRegistrarManager::GetInstance()
+          ->GetRegistrar<flutter::PluginRegistrar>(registrar));
+}
@@ -3,6 +3,8 @@
 #
 
 list(APPEND FLUTTER_PLUGIN_LIST
+  path_provider_elinux
+  shared_preferences_elinux
 )
 
 set(PLUGIN_BUNDLED_LIBRARIES)
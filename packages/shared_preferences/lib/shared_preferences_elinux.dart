@@ -9,6 +9,7 @@ import 'dart:convert' show json;
 import 'package:file/file.dart';
 import 'package:file/local.dart';
 import 'package:flutter/foundation.dart' show debugPrint, visibleForTesting;
+import 'package:flutter/services.dart';
 import 'package:path/path.dart' as path;
 import 'package:path_provider_elinux/path_provider_elinux.dart';
 import 'package:shared_preferences_platform_interface/shared_preferences_platform_interface.dart';
@@ -17,22 +18,55 @@ import 'package:shared_preferences_platform_interface/types.dart';
 /// The Linux implementation of [SharedPreferencesStorePlatform].
 ///
 /// This class implements the `package:shared_preferences` functionality for Linux.
+///
+/// The preferences are kept by the native store of the plugin in a
+/// memory-mapped binary file, and the mutations are persisted incrementally
+/// in the background. If the native plugin isn't available, they are read
+/// from and written to the JSON file in Dart.
 class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
   /// Deprecated instance of [SharedPreferencesELinux].
   /// Use [SharedPreferencesStorePlatform.instance] instead.
   @Deprecated('Use `SharedPreferencesStorePlatform.instance` instead.')
   static SharedPreferencesELinux instance = SharedPreferencesELinux();
 
+  /// Creates the preferences. If [useNativeStore] is false, they are always
+  /// read from and written to the JSON file in Dart, e.g. for testing with
+  /// another [fs].
+  SharedPreferencesELinux({bool useNativeStore = true})
+      : _useNativeStore = useNativeStore;
+
   static const String _defaultPrefix = 'flutter.';
 
+  static const MethodChannel _channel =
+      MethodChannel('plugins.flutter.io/shared_preferences_elinux');
+
+  /// Interval at which the changes queued by the native store are delivered.
+  static const Duration _changeDrainInterval = Duration(milliseconds: 100);
+
   /// Registers the ELinux implementation.
   static void registerWith() {
     SharedPreferencesStorePlatform.instance = SharedPreferencesELinux();
   }
 
+  /// Whether the native store is used if the native plugin is available.
+  final bool _useNativeStore;
+
+  /// Changes delivered to the streams returned by [watchChanges].
+  StreamController<List<String>>? _changeController;
+
+  /// Timer of the next drain of the changes.
+  Timer? _changeDrainTimer;
+
+  /// Incremented whenever the changes start or stop being watched, so that a
+  /// drain in flight for the previous listeners stops.
+  int _changeSession = 0;
+
   /// Local copy of preferences
   Map<String, Object>? _cachedPreferences;
 
+  /// Whether the native store has been opened.
+  Future<bool>? _nativeStoreOpened;
+
   /// File system used to store to disk. Exposed for testing only.
   @visibleForTesting
   FileSystem fs = const LocalFileSystem();
@@ -50,6 +84,37 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
     return fs.file(path.join(directory, 'shared_preferences.json'));
   }
 
+  /// Opens the native store for the local data file. Returns false if the
+  /// native plugin isn't available, or the native store isn't used.
+  Future<bool> _openNativeStore() {
+    return _nativeStoreOpened ??= () async {
+      if (!_useNativeStore) {
+        return false;
+      }
+      final File? localDataFile = await _getLocalDataFile();
+      if (localDataFile == null) {
+        return false;
+      }
+      try {
+        await _channel.invokeMethod<void>(
+            'open', <String, Object>{'path': localDataFile.path});
+        return true;
+      } on MissingPluginException {
+        return false;
+      } on PlatformException catch (e) {
+        debugPrint('Unable to open the native store: $e');
+        return false;
+      }
+    }();
+  }
+
+  static Map<String, Object> _filterArguments(PreferencesFilter filter) {
+    return <String, Object>{
+      'prefix': filter.prefix,
+      if (filter.allowList != null) 'allowList': filter.allowList!.toList(),
+    };
+  }
+
   /// Gets the preferences from the stored file and saves them in cache.
   Future<Map<String, Object>> _reload() async {
     Map<String, Object> preferences = <String, Object>{};
@@ -94,6 +159,107 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
     return true;
   }
 
+  /// Gets the value of [key], or null if it doesn't exist. The native store
+  /// decodes only this value instead of all the preferences.
+  Future<Object?> getValue(String key) async {
+    if (await _openNativeStore()) {
+      final Object? value = await _channel
+          .invokeMethod<Object?>('get', <String, Object>{'key': key});
+      return value is List ? value.cast<String>().toList() : value;
+    }
+    return (await _readPreferences())[key];
+  }
+
+  /// Notifies the keys changed by other processes sharing the preferences
+  /// file, e.g. a helper process of the same application. The changed values
+  /// are already reloaded when the keys are notified, and can be read with
+  /// [getValue]. The stream is empty if the native plugin isn't available.
+  Stream<List<String>> watchChanges() async* {
+    if (!await _openNativeStore()) {
+      return;
+    }
+    _changeController ??= StreamController<List<String>>.broadcast(
+      onListen: () {
+        final int session = ++_changeSession;
+        _channel.invokeMethod<void>('watchChanges').then((_) {
+          if (session == _changeSession) {
+            _scheduleChangeDrain(session);
+          }
+        }, onError: _changeController!.addError);
+      },
+      onCancel: () {
+        _changeSession++;
+        _changeDrainTimer?.cancel();
+        _channel.invokeMethod<void>('unwatchChanges');
+      },
+    );
+    yield* _changeController!.stream;
+  }
+
+  /// The writer thread of the native store only queues the changes, and
+  /// they are returned by this call on the platform thread. The next drain
+  /// is scheduled after the previous one completes.
+  void _scheduleChangeDrain(int session) {
+    _changeDrainTimer = Timer(_changeDrainInterval, () async {
+      List<Object?>? changes;
+      try {
+        changes = await _channel.invokeListMethod<Object?>('drainChangeEvents');
+      } on PlatformException catch (error) {
+        _changeController!.addError(error);
+      }
+      if (session != _changeSession) {
+        return;
+      }
+      for (final Object? keys in changes ?? <Object?>[]) {
+        _changeController!.add((keys! as List<Object?>).cast<String>());
+      }
+      _scheduleChangeDrain(session);
+    });
+  }
+
+  /// Sets the time the native store waits after a mutation for more
+  /// mutations to be merged into one write. The mutations of the same key in
+  /// the window are coalesced. The futures of the mutations complete once the
+  /// data is on disk, so a long window delays them. Defaults to zero, which
+  /// still merges the mutations made while the previous write is in
+  /// progress.
+  Future<void> setDebounceWindow(Duration window) async {
+    if (await _openNativeStore()) {
+      await _channel.invokeMethod<void>('setWriteConfig',
+          <String, Object>{'debounceMs': window.inMilliseconds});
+    }
+  }
+
+  /// Writes the pending mutations without waiting for the debounce window.
+  /// Returns [true] once they are on disk.
+  Future<bool> flush() async {
+    if (await _openNativeStore()) {
+      return await _channel
+              .invokeMethod<bool>('flush', <String, Object>{}) ??
+          false;
+    }
+    // The Dart implementation writes synchronously.
+    return true;
+  }
+
+  /// Gets the statistics of the writes of the native store.
+  Future<SharedPreferencesWriteStats> getWriteStats() async {
+    if (await _openNativeStore()) {
+      final Map<String, Object?>? stats = await _channel
+          .invokeMapMethod<String, Object?>('getWriteStats', <String, Object>{});
+      if (stats != null) {
+        return SharedPreferencesWriteStats._(
+          writeCount: stats['writeCount']! as int,
+          coalescedCount: stats['coalescedCount']! as int,
+          flushCount: stats['flushCount']! as int,
+          compactionCount: stats['compactionCount']! as int,
+        );
+      }
+    }
+    return SharedPreferencesWriteStats._(
+        writeCount: 0, coalescedCount: 0, flushCount: 0, compactionCount: 0);
+  }
+
   @override
   Future<bool> clear() async {
     return clearWithParameters(
@@ -112,6 +278,11 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
   @override
   Future<bool> clearWithParameters(ClearParameters parameters) async {
     final PreferencesFilter filter = parameters.filter;
+    if (await _openNativeStore()) {
+      return await _channel.invokeMethod<bool>(
+              'clear', _filterArguments(filter)) ??
+          false;
+    }
     final Map<String, Object> preferences = await _readPreferences();
     preferences.removeWhere((String key, _) =>
         key.startsWith(filter.prefix) &&
@@ -138,6 +309,18 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
   Future<Map<String, Object>> getAllWithParameters(
       GetAllParameters parameters) async {
     final PreferencesFilter filter = parameters.filter;
+    if (await _openNativeStore()) {
+      final Map<String, Object?>? values = await _channel
+          .invokeMapMethod<String, Object?>('getAll', _filterArguments(filter));
+      return <String, Object>{
+        for (final MapEntry<String, Object?> entry
+            in (values ?? <String, Object?>{}).entries)
+          if (entry.value != null)
+            entry.key: entry.value is List
+                ? (entry.value! as List<Object?>).cast<String>().toList()
+                : entry.value!,
+      };
+    }
     final Map<String, Object> withPrefix =
         Map<String, Object>.from(await _readPreferences());
     withPrefix.removeWhere((String key, _) => !(key.startsWith(filter.prefix) &&
@@ -147,6 +330,11 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
 
   @override
   Future<bool> remove(String key) async {
+    if (await _openNativeStore()) {
+      return await _channel
+              .invokeMethod<bool>('remove', <String, Object>{'key': key}) ??
+          false;
+    }
     final Map<String, Object> preferences = await _readPreferences();
     preferences.remove(key);
     return _writePreferences(preferences);
@@ -154,8 +342,36 @@ class SharedPreferencesELinux extends SharedPreferencesStorePlatform {
 
   @override
   Future<bool> setValue(String valueType, String key, Object value) async {
+    if (await _openNativeStore()) {
+      return await _channel.invokeMethod<bool>(
+              'setValue', <String, Object>{'key': key, 'value': value}) ??
+          false;
+    }
     final Map<String, Object> preferences = await _readPreferences();
     preferences[key] = value;
     return _writePreferences(preferences);
   }
 }
+
+/// Statistics of the writes of the native store.
+class SharedPreferencesWriteStats {
+  SharedPreferencesWriteStats._({
+    required this.writeCount,
+    required this.coalescedCount,
+    required this.flushCount,
+    required this.compactionCount,
+  });
+
+  /// Number of the mutations of keys.
+  final int writeCount;
+
+  /// Number of the mutations merged into a later mutation of the same key
+  /// before being written.
+  final int coalescedCount;
+
+  /// Number of the durable writes to disk.
+  final int flushCount;
+
+  /// Number of the compactions of the log into the preferences file.
+  final int compactionCount;
+}
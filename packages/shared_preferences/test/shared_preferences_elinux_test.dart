@@ -5,6 +5,7 @@
 import 'dart:convert';
 
 import 'package:file/memory.dart';
+import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:path/path.dart' as path;
 import 'package:path_provider_elinux/path_provider_elinux.dart';
@@ -70,7 +71,8 @@ void main() {
   }
 
   SharedPreferencesELinux getPreferences() {
-    final SharedPreferencesELinux prefs = SharedPreferencesELinux();
+    final SharedPreferencesELinux prefs =
+        SharedPreferencesELinux(useNativeStore: false);
     prefs.fs = fs;
     prefs.pathProvider = pathProvider;
     return prefs;
@@ -254,6 +256,163 @@ void main() {
     );
     expect(noValues, hasLength(0));
   });
+
+  group('native store', () {
+    const MethodChannel channel =
+        MethodChannel('plugins.flutter.io/shared_preferences_elinux');
+    final Map<String, Object> nativeValues = <String, Object>{};
+    final List<List<String>> nativeChanges = <List<String>>[];
+    final List<MethodCall> log = <MethodCall>[];
+
+    bool isSelected(String key, Map<Object?, Object?> arguments) {
+      final List<Object?>? allowList = arguments['allowList'] as List<Object?>?;
+      return key.startsWith(arguments['prefix']! as String) &&
+          (allowList?.contains(key) ?? true);
+    }
+
+    setUp(() {
+      nativeValues.clear();
+      nativeChanges.clear();
+      log.clear();
+      TestWidgetsFlutterBinding.ensureInitialized()
+          .defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (MethodCall call) async {
+        log.add(call);
+        switch (call.method) {
+          case 'watchChanges':
+          case 'unwatchChanges':
+            return null;
+          case 'drainChangeEvents':
+            final List<List<String>> changes =
+                List<List<String>>.of(nativeChanges);
+            nativeChanges.clear();
+            return changes;
+        }
+        final Map<Object?, Object?> arguments =
+            call.arguments as Map<Object?, Object?>;
+        switch (call.method) {
+          case 'open':
+            return null;
+          case 'get':
+            return nativeValues[arguments['key']];
+          case 'getAll':
+            return <String, Object>{
+              for (final MapEntry<String, Object> entry
+                  in nativeValues.entries)
+                if (isSelected(entry.key, arguments)) entry.key: entry.value,
+            };
+          case 'setValue':
+            nativeValues[arguments['key']! as String] = arguments['value']!;
+            return true;
+          case 'remove':
+            nativeValues.remove(arguments['key']);
+            return true;
+          case 'clear':
+            nativeValues
+                .removeWhere((String key, _) => isSelected(key, arguments));
+            return true;
+          case 'setWriteConfig':
+            return null;
+          case 'flush':
+            return true;
+          case 'getWriteStats':
+            return <String, Object>{
+              'writeCount': 3,
+              'coalescedCount': 2,
+              'flushCount': 1,
+              'compactionCount': 0,
+            };
+        }
+        return null;
+      });
+    });
+
+    SharedPreferencesELinux getNativePreferences() {
+      final SharedPreferencesELinux prefs = SharedPreferencesELinux();
+      prefs.pathProvider = pathProvider;
+      return prefs;
+    }
+
+    test('opens the store once', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+
+      await prefs.getAll();
+      await prefs.setValue('', 'flutter.key', 'one');
+
+      final List<MethodCall> opens =
+          log.where((MethodCall call) => call.method == 'open').toList();
+      expect(opens, hasLength(1));
+      expect(opens.first.arguments,
+          <String, Object>{'path': await getFilePath()});
+    });
+
+    test('setValue and getAll', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+
+      for (final MapEntry<String, Object> entry in allTestValues.entries) {
+        expect(await prefs.setValue('', entry.key, entry.value), isTrue);
+      }
+
+      expect(await prefs.getAll(), flutterTestValues);
+      expect(await prefs.getAllWithPrefix(''), allTestValues);
+    });
+
+    test('getValue', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+      nativeValues.addAll(allTestValues);
+
+      expect(await prefs.getValue('flutter.String'), 'hello world');
+      expect(await prefs.getValue('flutter.StringList'), <String>['foo', 'bar']);
+      expect(await prefs.getValue('flutter.Missing'), isNull);
+    });
+
+    test('watchChanges', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+      nativeChanges.add(<String>['flutter.a', 'flutter.b']);
+
+      expect(await prefs.watchChanges().first,
+          <String>['flutter.a', 'flutter.b']);
+      expect(log.map((MethodCall call) => call.method),
+          containsAllInOrder(<String>['watchChanges', 'drainChangeEvents']));
+    });
+
+    test('remove and clearWithParameters', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+      nativeValues.addAll(allTestValues);
+
+      expect(await prefs.remove('flutter.Int'), isTrue);
+      expect(
+          await prefs.clearWithParameters(
+            ClearParameters(
+              filter: PreferencesFilter(
+                prefix: 'prefix.',
+                allowList: <String>{'prefix.Bool'},
+              ),
+            ),
+          ),
+          isTrue);
+
+      expect(await prefs.getAll(), hasLength(4));
+      expect(await prefs.getAllWithPrefix('prefix.'), hasLength(4));
+      expect(nativeValues.containsKey('prefix.Bool'), isFalse);
+    });
+
+    test('setDebounceWindow, flush and getWriteStats', () async {
+      final SharedPreferencesELinux prefs = getNativePreferences();
+
+      await prefs.setDebounceWindow(const Duration(milliseconds: 50));
+      expect(await prefs.flush(), isTrue);
+      final SharedPreferencesWriteStats stats = await prefs.getWriteStats();
+
+      expect(
+          log.firstWhere((MethodCall call) => call.method == 'setWriteConfig')
+              .arguments,
+          <String, Object>{'debounceMs': 50});
+      expect(stats.writeCount, 3);
+      expect(stats.coalescedCount, 2);
+      expect(stats.flushCount, 1);
+    });
+  });
 }
 
 /// Fake implementation of PathProviderELinux that returns hard-coded paths,
@@ -0,0 +1,169 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures concurrent writers of PreferencesStore in separate processes
+// sharing the same files. Each writer sets its own keys and a shared key, and
+// the results are checked for lost writes after all the writers exit. The
+// parent process also keeps a store open as a reader and counts the change
+// notifications.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o concurrent_writers_benchmark
+//       concurrent_writers_benchmark.cc ../elinux/preferences_store.cc
+//       ../elinux/preferences_snapshot.cc ../elinux/preferences_log.cc
+//       ../elinux/preferences_json.cc ../elinux/preference_codec.cc
+//       -lpthread
+//   (in one line)
+//   $ ./concurrent_writers_benchmark [writers] [writes_per_writer] [dir]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "preferences_store.h"
+
+namespace {
+constexpr int kDefaultWriters = 4;
+constexpr int kDefaultWritesPerWriter = 1000;
+constexpr char kDefaultDirectory[] = "/tmp/shared_preferences_benchmark";
+
+std::string GetKey(int writer, int index) {
+  return "flutter.writer" + std::to_string(writer) + "." +
+         std::to_string(index);
+}
+
+// Writes and waits for each write to be durable. Returns the latencies in
+// microseconds.
+std::vector<int64_t> RunWriter(const std::string& path, int writer,
+                               int writes) {
+  std::vector<int64_t> latencies;
+  PreferencesStore store(path);
+  if (!store.Open()) {
+    return latencies;
+  }
+  for (int i = 0; i < writes; i++) {
+    std::promise<bool> written;
+    const auto start = std::chrono::steady_clock::now();
+    store.Set(GetKey(writer, i), static_cast<int64_t>(i), nullptr);
+    store.Set("flutter.last_writer", static_cast<int64_t>(writer),
+              [&written](bool success) { written.set_value(success); });
+    if (!written.get_future().get()) {
+      fprintf(stderr, "Writer %d failed to write\n", writer);
+      break;
+    }
+    latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  }
+  return latencies;
+}
+
+int64_t GetPercentile(std::vector<int64_t>& values, int percentile) {
+  if (values.empty()) {
+    return 0;
+  }
+  const size_t index = (values.size() - 1) * percentile / 100;
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int writers = argc > 1 ? atoi(argv[1]) : kDefaultWriters;
+  const int writes = argc > 2 ? atoi(argv[2]) : kDefaultWritesPerWriter;
+  const std::string directory = argc > 3 ? argv[3] : kDefaultDirectory;
+  const std::string path = directory + "/shared_preferences.json";
+
+  const std::string command = "rm -rf " + directory;
+  if (system(command.c_str()) != 0) {
+    return 1;
+  }
+
+  std::atomic<size_t> notified_keys{0};
+  PreferencesStore reader(path);
+  if (!reader.Open()) {
+    fprintf(stderr, "Failed to open %s\n", path.c_str());
+    return 1;
+  }
+  reader.SetChangeCallback([&notified_keys](const auto& keys) {
+    notified_keys += keys.size();
+  });
+
+  int pipe_fds[2];
+  if (pipe(pipe_fds) < 0) {
+    return 1;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<pid_t> pids;
+  for (int writer = 0; writer < writers; writer++) {
+    const pid_t pid = fork();
+    if (pid == 0) {
+      close(pipe_fds[0]);
+      auto latencies = RunWriter(path, writer, writes);
+      const int64_t result[3] = {
+          static_cast<int64_t>(latencies.size()),
+          GetPercentile(latencies, 50),
+          GetPercentile(latencies, 99),
+      };
+      const bool is_written =
+          write(pipe_fds[1], result, sizeof(result)) == sizeof(result);
+      _exit(is_written ? 0 : 1);
+    }
+    pids.push_back(pid);
+  }
+  close(pipe_fds[1]);
+
+  for (int writer = 0; writer < writers; writer++) {
+    int64_t result[3];
+    if (read(pipe_fds[0], result, sizeof(result)) != sizeof(result)) {
+      fprintf(stderr, "Failed to get the result of a writer\n");
+      return 1;
+    }
+    printf("writer: %lld writes, p50 %lld us, p99 %lld us\n",
+           static_cast<long long>(result[0]),
+           static_cast<long long>(result[1]),
+           static_cast<long long>(result[2]));
+  }
+  for (auto pid : pids) {
+    waitpid(pid, nullptr, 0);
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+  // Lets the reader catch up with the last notifications.
+  std::promise<bool> flushed;
+  reader.Flush([&flushed](bool success) { flushed.set_value(success); });
+  flushed.get_future().get();
+
+  PreferencesStore checker(path);
+  if (!checker.Open()) {
+    return 1;
+  }
+  int lost_writes = 0;
+  for (int writer = 0; writer < writers; writer++) {
+    for (int i = 0; i < writes; i++) {
+      PreferenceValue value;
+      if (!checker.Get(GetKey(writer, i), &value) ||
+          std::get<int64_t>(value) != i) {
+        lost_writes++;
+      }
+    }
+  }
+  const auto total_writes = static_cast<int64_t>(writers) * writes;
+  printf("%lld writes in %lld ms (%.0f writes/s), %d lost\n",
+         static_cast<long long>(total_writes), static_cast<long long>(elapsed),
+         elapsed > 0 ? total_writes * 1000.0 / elapsed : 0.0, lost_writes);
+  printf("reader: %zu keys notified, %zu keys\n", notified_keys.load(),
+         reader.GetAll("flutter.", nullptr).size());
+  return lost_writes == 0 ? 0 : 1;
+}
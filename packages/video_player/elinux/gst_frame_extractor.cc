@@ -0,0 +1,194 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gst_frame_extractor.h"
+
+#include <gst/app/gstappsink.h>
+#include <gst/video/video.h>
+
+#include <iostream>
+
+namespace {
+// Timeouts to preroll a frame and to encode it.
+constexpr GstClockTime kPrerollTimeout = 5 * GST_SECOND;
+constexpr GstClockTime kEncodeTimeout = GST_SECOND;
+}  // namespace
+
+GstFrameExtractor::GstFrameExtractor(const std::string& uri, int32_t width,
+                                     int32_t height)
+    : width_(width), height_(height) {
+  if (gst_uri_is_valid(uri.c_str())) {
+    uri_ = uri;
+  } else {
+    auto* filename_uri = gst_filename_to_uri(uri.c_str(), NULL);
+    uri_ = filename_uri ? filename_uri : uri;
+    g_free(filename_uri);
+  }
+}
+
+GstFrameExtractor::~GstFrameExtractor() { DestroyPipeline(); }
+
+bool GstFrameExtractor::Open() {
+  if (!CreatePipeline()) {
+    std::cerr << "Failed to create a frame extraction pipeline" << std::endl;
+    DestroyPipeline();
+    return false;
+  }
+
+  if (gst_element_set_state(pipeline_, GST_STATE_PAUSED) ==
+      GST_STATE_CHANGE_FAILURE) {
+    std::cerr << "Failed to change the state to PAUSED" << std::endl;
+    DestroyPipeline();
+    return false;
+  }
+  if (!WaitForPreroll()) {
+    DestroyPipeline();
+    return false;
+  }
+  return true;
+}
+
+bool GstFrameExtractor::ExtractFrame(int64_t position, ImageFormat format,
+                                     Frame& frame) {
+  if (!pipeline_) {
+    return false;
+  }
+
+  // Key unit seeks are much faster than accurate ones on long-GOP content,
+  // and the nearest key frame is good enough for a thumbnail.
+  if (!gst_element_seek_simple(
+          pipeline_, GST_FORMAT_TIME,
+          static_cast<GstSeekFlags>(GST_SEEK_FLAG_FLUSH |
+                                    GST_SEEK_FLAG_KEY_UNIT),
+          position * GST_MSECOND)) {
+    std::cerr << "Failed to seek " << position << std::endl;
+    return false;
+  }
+  if (!WaitForPreroll()) {
+    return false;
+  }
+
+  auto* sample =
+      gst_app_sink_try_pull_preroll(GST_APP_SINK(app_sink_), kPrerollTimeout);
+  if (!sample) {
+    std::cerr << "Failed to pull a frame at " << position << std::endl;
+    return false;
+  }
+
+  auto* caps = gst_caps_new_empty_simple(
+      format == ImageFormat::kPng ? "image/png" : "image/jpeg");
+  GError* error = NULL;
+  auto* encoded =
+      gst_video_convert_sample(sample, caps, kEncodeTimeout, &error);
+  gst_caps_unref(caps);
+  if (!encoded) {
+    std::cerr << "Failed to encode a frame: "
+              << (error ? error->message : "unknown error") << std::endl;
+    g_clear_error(&error);
+    gst_sample_unref(sample);
+    return false;
+  }
+
+  auto* structure = gst_caps_get_structure(gst_sample_get_caps(sample), 0);
+  gst_structure_get_int(structure, "width", &frame.width);
+  gst_structure_get_int(structure, "height", &frame.height);
+  auto* buffer = gst_sample_get_buffer(sample);
+  frame.position = GST_BUFFER_PTS_IS_VALID(buffer)
+                       ? GST_BUFFER_PTS(buffer) / GST_MSECOND
+                       : position;
+
+  auto* encoded_buffer = gst_sample_get_buffer(encoded);
+  frame.data.resize(gst_buffer_get_size(encoded_buffer));
+  gst_buffer_extract(encoded_buffer, 0, frame.data.data(), frame.data.size());
+
+  gst_sample_unref(encoded);
+  gst_sample_unref(sample);
+  return true;
+}
+
+// Creates a frame extraction pipeline using playbin.
+// $ playbin uri=<file> flags=video video-sink="videoconvert ! videoscale !
+// video/x-raw,format=RGBA,pixel-aspect-ratio=1/1,width=<w>,height=<h> !
+// appsink"
+bool GstFrameExtractor::CreatePipeline() {
+  pipeline_ = gst_pipeline_new("frame_extractor");
+  if (!pipeline_) {
+    std::cerr << "Failed to create a pipeline" << std::endl;
+    return false;
+  }
+  playbin_ = gst_element_factory_make("playbin", NULL);
+  if (!playbin_) {
+    std::cerr << "Failed to create a playbin" << std::endl;
+    return false;
+  }
+  gst_bin_add(GST_BIN(pipeline_), playbin_);
+
+  auto* output = gst_bin_new("output");
+  auto* video_convert = gst_element_factory_make("videoconvert", NULL);
+  auto* video_scale = gst_element_factory_make("videoscale", NULL);
+  app_sink_ = gst_element_factory_make("appsink", NULL);
+  if (!output || !video_convert || !video_scale || !app_sink_) {
+    std::cerr << "Failed to create an output" << std::endl;
+    return false;
+  }
+  gst_bin_add_many(GST_BIN(output), video_convert, video_scale, app_sink_,
+                   NULL);
+  // Sets the output to playbin first to release it with the pipeline.
+  g_object_set(playbin_, "video-sink", output, NULL);
+
+  // Only the preroll frame is pulled, so the sink doesn't need a clock.
+  g_object_set(G_OBJECT(app_sink_), "sync", FALSE, "max-buffers", 1, "drop",
+               TRUE, NULL);
+
+  // Videoscale keeps the display aspect ratio if the height isn't fixed.
+  auto* caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING,
+                                   "RGBA", "pixel-aspect-ratio",
+                                   GST_TYPE_FRACTION, 1, 1, NULL);
+  if (width_ > 0) {
+    gst_caps_set_simple(caps, "width", G_TYPE_INT, width_, NULL);
+  }
+  if (height_ > 0) {
+    gst_caps_set_simple(caps, "height", G_TYPE_INT, height_, NULL);
+  }
+  auto link_ok = gst_element_link(video_convert, video_scale) &&
+                 gst_element_link_filtered(video_scale, app_sink_, caps);
+  gst_caps_unref(caps);
+  if (!link_ok) {
+    std::cerr << "Failed to link elements" << std::endl;
+    return false;
+  }
+
+  auto* sinkpad = gst_element_get_static_pad(video_convert, "sink");
+  auto* ghost_sinkpad = gst_ghost_pad_new("sink", sinkpad);
+  gst_pad_set_active(ghost_sinkpad, TRUE);
+  gst_element_add_pad(output, ghost_sinkpad);
+  gst_object_unref(sinkpad);
+
+  // Doesn't decode audio nor render subtitles.
+  gst_util_set_object_arg(G_OBJECT(playbin_), "flags", "video");
+  g_object_set(playbin_, "uri", uri_.c_str(), NULL);
+
+  return true;
+}
+
+void GstFrameExtractor::DestroyPipeline() {
+  if (pipeline_) {
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+  }
+  playbin_ = nullptr;
+  app_sink_ = nullptr;
+}
+
+bool GstFrameExtractor::WaitForPreroll() {
+  GstState state;
+  auto result =
+      gst_element_get_state(pipeline_, &state, NULL, kPrerollTimeout);
+  if (result == GST_STATE_CHANGE_FAILURE || state != GST_STATE_PAUSED) {
+    std::cerr << "Failed to preroll " << uri_ << std::endl;
+    return false;
+  }
+  return true;
+}
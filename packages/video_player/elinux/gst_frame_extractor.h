@@ -0,0 +1,60 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_FRAME_EXTRACTOR_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_FRAME_EXTRACTOR_H_
+
+#include <gst/gst.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Extracts frames of a video as encoded images without rendering it. The
+// pipeline is the same as GstVideoPlayer's one except that the frames are
+// scaled to the target size and pulled from an appsink, and audio isn't
+// decoded.
+class GstFrameExtractor {
+ public:
+  enum class ImageFormat {
+    kJpeg,
+    kPng,
+  };
+
+  struct Frame {
+    // Timestamp of the extracted key frame in msec.
+    int64_t position = -1;
+    int32_t width = 0;
+    int32_t height = 0;
+    std::vector<uint8_t> data;
+  };
+
+  // If |height| is 0, it's determined by the display aspect ratio.
+  GstFrameExtractor(const std::string& uri, int32_t width, int32_t height);
+  ~GstFrameExtractor();
+
+  // Prevent copying.
+  GstFrameExtractor(GstFrameExtractor const&) = delete;
+  GstFrameExtractor& operator=(GstFrameExtractor const&) = delete;
+
+  // Prerolls the pipeline. Must be called before ExtractFrame.
+  bool Open();
+
+  // Seeks to the key frame nearest to |position| in msec and encodes it.
+  bool ExtractFrame(int64_t position, ImageFormat format, Frame& frame);
+
+ private:
+  bool CreatePipeline();
+  void DestroyPipeline();
+  bool WaitForPreroll();
+
+  std::string uri_;
+  int32_t width_;
+  int32_t height_;
+  GstElement* pipeline_ = nullptr;
+  GstElement* playbin_ = nullptr;
+  GstElement* app_sink_ = nullptr;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_FRAME_EXTRACTOR_H_
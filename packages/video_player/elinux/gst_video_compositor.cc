@@ -0,0 +1,259 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gst_video_compositor.h"
+
+#include <algorithm>
+#include <iostream>
+
+GstVideoCompositor::GstVideoCompositor(
+    const std::vector<std::string>& uris, int32_t width, int32_t height,
+    GstVideoOutput::OnFrameDecoded on_frame_decoded)
+    : width_(width), height_(height) {
+  output_ = std::make_unique<GstVideoOutput>(std::move(on_frame_decoded), true);
+  if (!output_->IsValid() || !CreatePipeline(uris)) {
+    std::cerr << "Failed to create a compositor pipeline" << std::endl;
+    DestroyPipeline();
+    output_ = nullptr;
+    return;
+  }
+  // The composited frames are scaled down further if the texture is smaller.
+  output_->SetVideoSize(width_, height_);
+}
+
+GstVideoCompositor::~GstVideoCompositor() {
+  DestroyPipeline();
+  output_ = nullptr;
+}
+
+bool GstVideoCompositor::Play() {
+  if (!pipeline_ || gst_element_set_state(pipeline_, GST_STATE_PLAYING) ==
+                        GST_STATE_CHANGE_FAILURE) {
+    std::cerr << "Failed to change the state to PLAYING" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool GstVideoCompositor::Pause() {
+  if (!pipeline_ || gst_element_set_state(pipeline_, GST_STATE_PAUSED) ==
+                        GST_STATE_CHANGE_FAILURE) {
+    std::cerr << "Failed to change the state to PAUSED" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool GstVideoCompositor::SetLayout(const std::vector<Region>& layout) {
+  if (!compositor_) {
+    return false;
+  }
+
+  std::vector<const Region*> regions(sources_.size(), nullptr);
+  for (const auto& region : layout) {
+    if (region.source < 0 ||
+        region.source >= static_cast<int32_t>(sources_.size())) {
+      std::cerr << "Invalid source index: " << region.source << std::endl;
+      return false;
+    }
+    // The last region wins if a source is placed more than once.
+    regions[region.source] = &region;
+  }
+
+  // The properties of the compositor pads are read on every output frame, so
+  // the layout changes without renegotiation.
+  for (size_t i = 0; i < sources_.size(); i++) {
+    auto* pad = G_OBJECT(sources_[i]->compositor_pad);
+    const auto* region = regions[i];
+    if (!region || region->width <= 0 || region->height <= 0) {
+      g_object_set(pad, "alpha", 0.0, NULL);
+      continue;
+    }
+    g_object_set(pad, "xpos", region->x, "ypos", region->y, "width",
+                 region->width, "height", region->height, "zorder",
+                 static_cast<guint>(std::max(0, region->z_order)), "alpha",
+                 1.0, NULL);
+  }
+  return true;
+}
+
+bool GstVideoCompositor::CreatePipeline(const std::vector<std::string>& uris) {
+  pipeline_ = gst_pipeline_new("compositor_pipeline");
+  if (!pipeline_) {
+    std::cerr << "Failed to create a pipeline" << std::endl;
+    return false;
+  }
+  compositor_ = gst_element_factory_make("compositor", "compositor");
+  if (!compositor_) {
+    std::cerr << "Failed to create a compositor" << std::endl;
+    return false;
+  }
+  auto* caps_filter = gst_element_factory_make("capsfilter", NULL);
+  if (!caps_filter) {
+    std::cerr << "Failed to create a capsfilter" << std::endl;
+    gst_object_unref(compositor_);
+    compositor_ = nullptr;
+    return false;
+  }
+  bus_ = gst_pipeline_get_bus(GST_PIPELINE(pipeline_));
+  gst_bus_set_sync_handler(bus_, HandleGstMessage, this, NULL);
+
+  gst_util_set_object_arg(G_OBJECT(compositor_), "background", "black");
+  // A stalled live source doesn't hold the other sources back.
+  if (g_object_class_find_property(G_OBJECT_GET_CLASS(compositor_),
+                                   "ignore-inactive-pads")) {
+    g_object_set(G_OBJECT(compositor_), "ignore-inactive-pads", TRUE, NULL);
+  }
+
+  auto* caps = gst_caps_new_simple("video/x-raw", "width", G_TYPE_INT, width_,
+                                   "height", G_TYPE_INT, height_, NULL);
+  g_object_set(G_OBJECT(caps_filter), "caps", caps, NULL);
+  gst_caps_unref(caps);
+
+  gst_bin_add_many(GST_BIN(pipeline_), compositor_, caps_filter,
+                   output_->GetBin(), NULL);
+  if (!gst_element_link_many(compositor_, caps_filter, output_->GetBin(),
+                             NULL)) {
+    std::cerr << "Failed to link elements" << std::endl;
+    return false;
+  }
+
+  for (const auto& uri : uris) {
+    auto source = std::make_unique<Source>();
+    source->compositor = this;
+    source->decodebin = gst_element_factory_make("uridecodebin", NULL);
+    source->queue = gst_element_factory_make("queue", NULL);
+    if (!source->decodebin || !source->queue) {
+      std::cerr << "Failed to create a source of " << uri << std::endl;
+      if (source->decodebin) {
+        gst_object_unref(source->decodebin);
+      }
+      if (source->queue) {
+        gst_object_unref(source->queue);
+      }
+      return false;
+    }
+    gst_bin_add_many(GST_BIN(pipeline_), source->decodebin, source->queue,
+                     NULL);
+
+    if (gst_uri_is_valid(uri.c_str())) {
+      g_object_set(G_OBJECT(source->decodebin), "uri", uri.c_str(), NULL);
+    } else {
+      auto* filename_uri = gst_filename_to_uri(uri.c_str(), NULL);
+      g_object_set(G_OBJECT(source->decodebin), "uri",
+                   filename_uri ? filename_uri : uri.c_str(), NULL);
+      g_free(filename_uri);
+    }
+    g_signal_connect(G_OBJECT(source->decodebin), "pad-added",
+                     G_CALLBACK(PadAddedHandler), source.get());
+
+    // Hidden until a layout places it.
+    source->compositor_pad =
+        gst_element_get_request_pad(compositor_, "sink_%u");
+    g_object_set(G_OBJECT(source->compositor_pad), "alpha", 0.0, NULL);
+    auto* queue_pad = gst_element_get_static_pad(source->queue, "src");
+    auto result = gst_pad_link(queue_pad, source->compositor_pad);
+    gst_object_unref(queue_pad);
+    sources_.push_back(std::move(source));
+    if (result != GST_PAD_LINK_OK) {
+      std::cerr << "Failed to link a source of " << uri << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void GstVideoCompositor::DestroyPipeline() {
+  if (output_) {
+    output_->Stop();
+  }
+
+  if (pipeline_) {
+    gst_element_set_state(pipeline_, GST_STATE_NULL);
+  }
+
+  for (auto& source : sources_) {
+    if (source->compositor_pad) {
+      gst_object_unref(source->compositor_pad);
+    }
+  }
+  sources_.clear();
+
+  if (bus_) {
+    gst_object_unref(bus_);
+    bus_ = nullptr;
+  }
+
+  if (pipeline_) {
+    gst_object_unref(pipeline_);
+    pipeline_ = nullptr;
+  }
+
+  compositor_ = nullptr;
+}
+
+// static
+void GstVideoCompositor::PadAddedHandler(GstElement* decodebin, GstPad* pad,
+                                         gpointer user_data) {
+  auto* source = reinterpret_cast<Source*>(user_data);
+  auto* caps = gst_pad_get_current_caps(pad);
+  if (!caps) {
+    caps = gst_pad_query_caps(pad, NULL);
+  }
+  const bool is_video =
+      caps && !gst_caps_is_empty(caps) &&
+      g_str_has_prefix(gst_structure_get_name(gst_caps_get_structure(caps, 0)),
+                       "video/");
+  if (caps) {
+    gst_caps_unref(caps);
+  }
+  // Audio and the other video streams of the source are left unlinked.
+  if (!is_video) {
+    return;
+  }
+
+  auto* sink_pad = gst_element_get_static_pad(source->queue, "sink");
+  if (!gst_pad_is_linked(sink_pad) &&
+      gst_pad_link(pad, sink_pad) != GST_PAD_LINK_OK) {
+    std::cerr << "Failed to link a decoded video" << std::endl;
+  }
+  gst_object_unref(sink_pad);
+}
+
+// static
+GstBusSyncReply GstVideoCompositor::HandleGstMessage(GstBus* bus,
+                                                     GstMessage* message,
+                                                     gpointer user_data) {
+  switch (GST_MESSAGE_TYPE(message)) {
+    case GST_MESSAGE_WARNING: {
+      gchar* debug;
+      GError* error;
+      gst_message_parse_warning(message, &error, &debug);
+      g_printerr("WARNING from element %s: %s\n", GST_OBJECT_NAME(message->src),
+                 error->message);
+      g_printerr("Warning details: %s\n", debug);
+      g_free(debug);
+      g_error_free(error);
+      break;
+    }
+    case GST_MESSAGE_ERROR: {
+      gchar* debug;
+      GError* error;
+      gst_message_parse_error(message, &error, &debug);
+      g_printerr("ERROR from element %s: %s\n", GST_OBJECT_NAME(message->src),
+                 error->message);
+      g_printerr("Error details: %s\n", debug);
+      g_free(debug);
+      g_error_free(error);
+      break;
+    }
+    default:
+      break;
+  }
+
+  gst_message_unref(message);
+
+  return GST_BUS_DROP;
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_COMPOSITOR_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_COMPOSITOR_H_
+
+#include <gst/gst.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gst_video_output.h"
+
+// Composites multiple video sources into the frames of one texture, so that
+// a grid of videos needs only one conversion and upload.
+// $ uridecodebin uri=<uri 0> ! queue ! compositor name=c !
+//   capsfilter caps=video/x-raw,width=<w>,height=<h> ! <GstVideoOutput>
+//   uridecodebin uri=<uri 1> ! queue ! c.
+//   ...
+class GstVideoCompositor {
+ public:
+  // Placement of a source in the composited frame in pixels. Sources without
+  // a region are hidden.
+  struct Region {
+    int32_t source = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    // Regions with larger values are drawn on top.
+    int32_t z_order = 0;
+  };
+
+  GstVideoCompositor(const std::vector<std::string>& uris, int32_t width,
+                     int32_t height,
+                     GstVideoOutput::OnFrameDecoded on_frame_decoded);
+  ~GstVideoCompositor();
+
+  // Prevent copying.
+  GstVideoCompositor(GstVideoCompositor const&) = delete;
+  GstVideoCompositor& operator=(GstVideoCompositor const&) = delete;
+
+  bool Play();
+  bool Pause();
+
+  // Moves and resizes the sources without rebuilding the pipeline. The
+  // change is applied from the next composited frame.
+  bool SetLayout(const std::vector<Region>& layout);
+
+  // Renders the composited frames to the texture. nullptr if the pipeline
+  // couldn't be created.
+  GstVideoOutput* GetOutput() const { return output_.get(); }
+
+ private:
+  struct Source {
+    GstVideoCompositor* compositor;
+    GstElement* decodebin;
+    GstElement* queue;
+    GstPad* compositor_pad;
+  };
+
+  static void PadAddedHandler(GstElement* decodebin, GstPad* pad,
+                              gpointer user_data);
+  static GstBusSyncReply HandleGstMessage(GstBus* bus, GstMessage* message,
+                                          gpointer user_data);
+  bool CreatePipeline(const std::vector<std::string>& uris);
+  void DestroyPipeline();
+
+  const int32_t width_;
+  const int32_t height_;
+  GstElement* pipeline_ = nullptr;
+  GstElement* compositor_ = nullptr;
+  GstBus* bus_ = nullptr;
+  std::vector<std::unique_ptr<Source>> sources_;
+  std::unique_ptr<GstVideoOutput> output_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_COMPOSITOR_H_
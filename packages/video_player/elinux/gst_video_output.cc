@@ -0,0 +1,435 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gst_video_output.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+namespace {
+// Number of frames queued in front of the conversion of each output. Small
+// not to hold many decoded frames, but decouples the conversions of the
+// outputs sharing a decoder.
+constexpr guint kQueueSizeBuffers = 2;
+
+// The scaled size is kept while the requested size is within this band
+// around it.
+constexpr double kScaleGrowThreshold = 1.1;
+constexpr double kScaleShrinkThreshold = 0.75;
+// Time the requested size must stay out of the band before the caps are
+// renegotiated. Shrinking waits longer since it's only an optimization.
+constexpr auto kScaleGrowDelay = std::chrono::milliseconds(100);
+constexpr auto kScaleShrinkDelay = std::chrono::milliseconds(500);
+
+// Lateness of the frames rendered in the QoS mode, which is the default of
+// the video sinks.
+constexpr gint64 kQosMaxLateness = 20 * GST_MSECOND;
+
+// Cached frames farther than this from each other aren't treated as
+// neighbors if the duration of the frames is unknown.
+constexpr GstClockTime kMaxFrameGap = 100 * GST_MSECOND;
+}  // namespace
+
+GstVideoOutput::GstVideoOutput(OnFrameDecoded on_frame_decoded, bool is_async)
+    : on_frame_decoded_(std::move(on_frame_decoded)) {
+  auto* queue = gst_element_factory_make("queue", NULL);
+  auto* video_scale = gst_element_factory_make("videoscale", NULL);
+  auto* video_convert = gst_element_factory_make("videoconvert", NULL);
+  caps_filter_ = gst_element_factory_make("capsfilter", NULL);
+  video_sink_ = gst_element_factory_make("fakesink", NULL);
+  if (!queue || !video_scale || !video_convert || !caps_filter_ ||
+      !video_sink_) {
+    std::cerr << "Failed to create the elements of a video output"
+              << std::endl;
+    for (auto* element :
+         {queue, video_scale, video_convert, caps_filter_, video_sink_}) {
+      if (element) {
+        gst_object_unref(element);
+      }
+    }
+    caps_filter_ = nullptr;
+    video_sink_ = nullptr;
+    return;
+  }
+
+  video_scale_ = video_scale;
+  video_convert_ = video_convert;
+
+  // Keeps a reference to remove the bin from a running pipeline.
+  bin_ = gst_bin_new(NULL);
+  gst_object_ref_sink(bin_);
+  gst_bin_add_many(GST_BIN(bin_), queue, video_scale, video_convert,
+                   caps_filter_, video_sink_, NULL);
+
+  g_object_set(G_OBJECT(queue), "max-size-buffers", kQueueSizeBuffers,
+               "max-size-bytes", 0, "max-size-time", G_GUINT64_CONSTANT(0),
+               NULL);
+
+  // Sets properties to fakesink to get the callback of a decoded frame. The
+  // sink doesn't keep the last sample since |buffer_| references it.
+  g_object_set(G_OBJECT(video_sink_), "sync", TRUE, "qos", FALSE, "async",
+               is_async ? TRUE : FALSE, "enable-last-sample", FALSE, NULL);
+  g_object_set(G_OBJECT(video_sink_), "signal-handoffs", TRUE, NULL);
+  g_signal_connect(G_OBJECT(video_sink_), "handoff",
+                   G_CALLBACK(HandoffHandler), this);
+  // The prerolled frames are shown while paused, i.e. the first frame before
+  // playing and the frames of the seeks while paused.
+  g_signal_connect(G_OBJECT(video_sink_), "preroll-handoff",
+                   G_CALLBACK(HandoffHandler), this);
+
+  // Adds caps to the converter to convert the color format to RGBA. The size
+  // is added by SetOutputSize() to scale the frames down to the texture size
+  // before the conversion.
+  auto* caps = gst_caps_from_string("video/x-raw,format=RGBA");
+  g_object_set(G_OBJECT(caps_filter_), "caps", caps, NULL);
+  gst_caps_unref(caps);
+  if (!gst_element_link_many(queue, video_scale, video_convert, caps_filter_,
+                             video_sink_, NULL)) {
+    std::cerr << "Failed to link elements" << std::endl;
+  }
+
+  auto* sinkpad = gst_element_get_static_pad(queue, "sink");
+  auto* ghost_sinkpad = gst_ghost_pad_new("sink", sinkpad);
+  gst_pad_set_active(ghost_sinkpad, TRUE);
+  gst_element_add_pad(bin_, ghost_sinkpad);
+  gst_object_unref(sinkpad);
+}
+
+GstVideoOutput::~GstVideoOutput() {
+#ifdef USE_EGL_IMAGE_DMABUF
+  UnrefEGLImage();
+#endif  // USE_EGL_IMAGE_DMABUF
+  Stop();
+
+  if (buffer_) {
+    gst_buffer_unref(buffer_);
+    buffer_ = nullptr;
+  }
+  SetFrameCacheSize(0);
+
+  if (bin_) {
+    gst_object_unref(bin_);
+    bin_ = nullptr;
+  }
+}
+
+void GstVideoOutput::Stop() {
+  if (video_sink_) {
+    g_object_set(G_OBJECT(video_sink_), "signal-handoffs", FALSE, NULL);
+  }
+}
+
+void GstVideoOutput::SetQosEnabled(bool enabled) {
+  if (!bin_) {
+    return;
+  }
+
+  g_object_set(G_OBJECT(video_sink_), "qos", enabled ? TRUE : FALSE,
+               "max-lateness", enabled ? kQosMaxLateness : gint64{-1}, NULL);
+  g_object_set(G_OBJECT(video_scale_), "qos", enabled ? TRUE : FALSE, NULL);
+  g_object_set(G_OBJECT(video_convert_), "qos", enabled ? TRUE : FALSE, NULL);
+}
+
+void GstVideoOutput::SetVideoSize(int32_t width, int32_t height) {
+  std::lock_guard<std::mutex> lock(mutex_scale_);
+  video_width_ = width;
+  video_height_ = height;
+  scaled_width_ = width;
+  scaled_height_ = height;
+}
+
+void GstVideoOutput::SetOutputSize(int32_t width, int32_t height) {
+  if (!caps_filter_ || width <= 0 || height <= 0) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_scale_);
+  if (video_width_ <= 0 || video_height_ <= 0) {
+    return;
+  }
+
+  // Covers the requested size keeping the aspect ratio. Never upscales, and
+  // keeps the size even for the chroma subsampled formats.
+  const double scale =
+      std::min(1.0, std::max(static_cast<double>(width) / video_width_,
+                             static_cast<double>(height) / video_height_));
+  auto target_width = std::max<int32_t>(
+      2, static_cast<int32_t>(std::lround(video_width_ * scale)) & ~1);
+  auto target_height = std::max<int32_t>(
+      2, static_cast<int32_t>(std::lround(video_height_ * scale)) & ~1);
+  if (scale == 1.0) {
+    target_width = video_width_;
+    target_height = video_height_;
+  }
+
+  const bool is_growing = target_width > scaled_width_ * kScaleGrowThreshold ||
+                          (scale == 1.0 && scaled_width_ < video_width_);
+  const bool is_shrinking =
+      target_width < scaled_width_ * kScaleShrinkThreshold;
+  if (!is_growing && !is_shrinking) {
+    is_scale_requested_ = false;
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  if (!is_scale_requested_) {
+    is_scale_requested_ = true;
+    scale_request_time_ = now;
+  }
+  if (now - scale_request_time_ <
+      (is_growing ? kScaleGrowDelay : kScaleShrinkDelay)) {
+    return;
+  }
+
+  is_scale_requested_ = false;
+  scaled_width_ = target_width;
+  scaled_height_ = target_height;
+  const bool is_native =
+      target_width == video_width_ && target_height == video_height_;
+  lock.unlock();
+  ApplyScaledSize(is_native ? 0 : target_width, is_native ? 0 : target_height);
+}
+
+void GstVideoOutput::ApplyScaledSize(int32_t width, int32_t height) {
+  GstCaps* caps;
+  if (width <= 0 || height <= 0) {
+    caps = gst_caps_from_string("video/x-raw,format=RGBA");
+  } else {
+    caps = gst_caps_new_simple("video/x-raw", "format", G_TYPE_STRING, "RGBA",
+                               "width", G_TYPE_INT, width, "height",
+                               G_TYPE_INT, height, NULL);
+  }
+  // capsfilter sends a reconfigure event upstream, and videoscale
+  // renegotiates from the next frame.
+  g_object_set(G_OBJECT(caps_filter_), "caps", caps, NULL);
+  gst_caps_unref(caps);
+}
+
+void GstVideoOutput::CopyFrame(GstVideoOutput& other) {
+  std::shared_lock<std::shared_mutex> other_lock(other.mutex_buffer_);
+  if (!other.buffer_) {
+    return;
+  }
+  std::lock_guard<std::shared_mutex> lock(mutex_buffer_);
+  if (buffer_) {
+    return;
+  }
+  buffer_ = gst_buffer_ref(other.buffer_);
+  frame_width_ = other.frame_width_;
+  frame_height_ = other.frame_height_;
+  frame_pts_ = other.frame_pts_;
+  frame_duration_ = other.frame_duration_;
+#ifdef USE_EGL_IMAGE_DMABUF
+  gst_video_info_ = other.gst_video_info_;
+#endif  // USE_EGL_IMAGE_DMABUF
+}
+
+void GstVideoOutput::SetFrameCacheSize(size_t size) {
+  std::lock_guard<std::shared_mutex> lock(mutex_buffer_);
+  frame_cache_size_ = size;
+  CacheFrameLocked();
+}
+
+GstClockTime GstVideoOutput::GetFramePts() {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  return frame_pts_;
+}
+
+GstClockTime GstVideoOutput::GetFrameDuration() {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  return frame_duration_;
+}
+
+GstClockTime GstVideoOutput::GetDecodedPts() {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  return decoded_pts_;
+}
+
+GstClockTime GstVideoOutput::FindCachedFrame(bool forward) {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  auto current = frame_cache_.find(frame_pts_);
+  if (current == frame_cache_.end()) {
+    return GST_CLOCK_TIME_NONE;
+  }
+  if (forward ? std::next(current) == frame_cache_.end()
+              : current == frame_cache_.begin()) {
+    return GST_CLOCK_TIME_NONE;
+  }
+  auto neighbor = forward ? std::next(current) : std::prev(current);
+
+  // Frames from different positions aren't neighbors even if nothing has
+  // been cached between them.
+  const auto max_gap = GST_CLOCK_TIME_IS_VALID(frame_duration_)
+                           ? frame_duration_ * 3 / 2
+                           : kMaxFrameGap;
+  const auto gap = forward ? neighbor->first - current->first
+                           : current->first - neighbor->first;
+  return gap <= max_gap ? neighbor->first : GST_CLOCK_TIME_NONE;
+}
+
+bool GstVideoOutput::ShowCachedFrame(GstClockTime pts) {
+  {
+    std::lock_guard<std::shared_mutex> lock(mutex_buffer_);
+    auto cached = frame_cache_.find(pts);
+    if (cached == frame_cache_.end()) {
+      return false;
+    }
+    if (buffer_) {
+      gst_buffer_unref(buffer_);
+    }
+    buffer_ = gst_buffer_ref(cached->second.buffer);
+    frame_width_ = cached->second.width;
+    frame_height_ = cached->second.height;
+    frame_pts_ = pts;
+  }
+  if (on_frame_decoded_) {
+    on_frame_decoded_();
+  }
+  return true;
+}
+
+const uint8_t* GstVideoOutput::GetFrameBuffer() {
+  std::lock_guard<std::shared_mutex> lock(mutex_buffer_);
+  if (!buffer_) {
+    return nullptr;
+  }
+
+  // Reallocated here rather than in HandoffHandler since the engine reads the
+  // buffer after this call returns.
+  const size_t pixel_count = static_cast<size_t>(frame_width_) * frame_height_;
+  if (pixel_count > pixels_size_) {
+    pixels_.reset(new uint32_t[pixel_count]);
+    pixels_size_ = pixel_count;
+  }
+  output_width_ = frame_width_;
+  output_height_ = frame_height_;
+
+  gst_buffer_extract(buffer_, 0, pixels_.get(), pixel_count * 4);
+  return reinterpret_cast<const uint8_t*>(pixels_.get());
+}
+
+#ifdef USE_EGL_IMAGE_DMABUF
+void* GstVideoOutput::GetEGLImage(void* egl_display, void* egl_context) {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  if (!buffer_) {
+    return nullptr;
+  }
+  output_width_ = frame_width_;
+  output_height_ = frame_height_;
+
+  GstMemory* memory = gst_buffer_peek_memory(buffer_, 0);
+  if (gst_is_dmabuf_memory(memory)) {
+    UnrefEGLImage();
+
+    gint fd = gst_dmabuf_memory_get_fd(memory);
+    gst_gl_display_egl_ =
+        gst_gl_display_egl_new_with_egl_display(reinterpret_cast<gpointer>(egl_display));
+    gst_gl_ctx_ = gst_gl_context_new_wrapped(
+        GST_GL_DISPLAY_CAST(gst_gl_display_egl_), reinterpret_cast<guintptr>(egl_context),
+        GST_GL_PLATFORM_EGL, GST_GL_API_GLES2);
+
+    gst_gl_context_activate(gst_gl_ctx_, TRUE);
+
+    gst_egl_image_ =
+        gst_egl_image_from_dmabuf(gst_gl_ctx_, fd, &gst_video_info_, 0, 0);
+    return reinterpret_cast<void*>(gst_egl_image_get_image(gst_egl_image_));
+  }
+  return nullptr;
+}
+
+void GstVideoOutput::UnrefEGLImage() {
+  if (gst_egl_image_) {
+    gst_egl_image_unref(gst_egl_image_);
+    gst_object_unref(gst_gl_ctx_);
+    gst_object_unref(gst_gl_display_egl_);
+    gst_egl_image_ = NULL;
+    gst_gl_ctx_ = NULL;
+    gst_gl_display_egl_ = NULL;
+  }
+}
+#endif  // USE_EGL_IMAGE_DMABUF
+
+int64_t GstVideoOutput::GetFrameBufferBytes() {
+  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
+  int64_t bytes = pixels_size_ * 4;
+  if (buffer_) {
+    bytes += gst_buffer_get_size(buffer_);
+  }
+  for (const auto& [pts, frame] : frame_cache_) {
+    if (frame.buffer != buffer_) {
+      bytes += gst_buffer_get_size(frame.buffer);
+    }
+  }
+  return bytes;
+}
+
+// static
+void GstVideoOutput::HandoffHandler(GstElement* fakesink, GstBuffer* buf,
+                                    GstPad* new_pad, gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoOutput*>(user_data);
+  auto* caps = gst_pad_get_current_caps(new_pad);
+  const auto is_new_frame = self->SetFrame(buf, caps);
+  gst_caps_unref(caps);
+  if (is_new_frame && self->on_frame_decoded_) {
+    self->on_frame_decoded_();
+  }
+}
+
+bool GstVideoOutput::SetFrame(GstBuffer* buffer, GstCaps* caps) {
+  auto* structure = gst_caps_get_structure(caps, 0);
+
+  int width;
+  int height;
+  gst_structure_get_int(structure, "width", &width);
+  gst_structure_get_int(structure, "height", &height);
+
+  std::lock_guard<std::shared_mutex> lock(mutex_buffer_);
+  // The prerolled buffer is handed off again when it's rendered.
+  if (buffer == buffer_) {
+    return false;
+  }
+  if (width != frame_width_ || height != frame_height_) {
+    frame_width_ = width;
+    frame_height_ = height;
+#ifdef USE_EGL_IMAGE_DMABUF
+    if (!gst_video_info_from_caps(&gst_video_info_, caps)) {
+      std::cerr << "Failed to get a gst_video_info" << std::endl;
+    }
+#endif  // USE_EGL_IMAGE_DMABUF
+  }
+  if (buffer_) {
+    gst_buffer_unref(buffer_);
+    buffer_ = nullptr;
+  }
+  buffer_ = gst_buffer_ref(buffer);
+  frame_pts_ = GST_BUFFER_PTS(buffer);
+  frame_duration_ = GST_BUFFER_DURATION(buffer);
+  decoded_pts_ = frame_pts_;
+  CacheFrameLocked();
+  return true;
+}
+
+// Adds the shown frame to the cache, and evicts the frames farthest from it
+// while the cache is full.
+void GstVideoOutput::CacheFrameLocked() {
+  if (frame_cache_size_ > 0 && buffer_ && GST_CLOCK_TIME_IS_VALID(frame_pts_) &&
+      frame_cache_.find(frame_pts_) == frame_cache_.end()) {
+    frame_cache_[frame_pts_] = {gst_buffer_ref(buffer_), frame_width_,
+                                frame_height_};
+  }
+
+  while (frame_cache_.size() > frame_cache_size_) {
+    auto first = frame_cache_.begin();
+    auto last = std::prev(frame_cache_.end());
+    const bool is_first_farther =
+        !GST_CLOCK_TIME_IS_VALID(frame_pts_) ||
+        frame_pts_ - std::min(frame_pts_, first->first) >
+            std::max(frame_pts_, last->first) - frame_pts_;
+    auto evicted = is_first_farther ? first : last;
+    gst_buffer_unref(evicted->second.buffer);
+    frame_cache_.erase(evicted);
+  }
+}
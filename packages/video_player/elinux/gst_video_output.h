@@ -0,0 +1,160 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_OUTPUT_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_OUTPUT_H_
+
+#include <gst/gst.h>
+
+#ifdef USE_EGL_IMAGE_DMABUF
+#include <gst/allocators/gstdmabuf.h>
+#include <gst/gl/egl/egl.h>
+#include <gst/gl/gl.h>
+#include <gst/video/video.h>
+#endif  // USE_EGL_IMAGE_DMABUF
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+// A branch of the decoded video rendered to a texture.
+// $ queue ! videoscale ! videoconvert !
+//   capsfilter caps=video/x-raw,format=RGBA ! fakesink
+class GstVideoOutput {
+ public:
+  using OnFrameDecoded = std::function<void()>;
+
+  // If |is_async| is false, the sink doesn't preroll, so that the output can
+  // be added to a running pipeline without changing its state.
+  GstVideoOutput(OnFrameDecoded on_frame_decoded, bool is_async);
+  ~GstVideoOutput();
+
+  // Prevent copying.
+  GstVideoOutput(GstVideoOutput const&) = delete;
+  GstVideoOutput& operator=(GstVideoOutput const&) = delete;
+
+  bool IsValid() const { return bin_ != nullptr; }
+
+  // The bin with a "sink" ghost pad.
+  GstElement* GetBin() const { return bin_; }
+
+  // Stops notifying decoded frames before the pipeline is destroyed.
+  void Stop();
+
+  // Sets the size of the video before scaling.
+  void SetVideoSize(int32_t width, int32_t height);
+
+  // Sets the size of the texture in physical pixels. The frames are scaled
+  // down to cover the size, with hysteresis not to renegotiate the caps on
+  // every step of resize animations.
+  void SetOutputSize(int32_t width, int32_t height);
+
+  // Enables QoS of the sink. Frames later than the allowed lateness are
+  // dropped by the scaler and the converter before their processing, and by
+  // the sink before they're copied. The QoS events also let the decoder skip
+  // frames.
+  void SetQosEnabled(bool enabled);
+
+  // Shows the latest frame of |other| until this output gets its own frame.
+  void CopyFrame(GstVideoOutput& other);
+
+  // Keeps up to |size| decoded frames around the shown frame, so that frame
+  // stepping can show them again without decoding. 0 (default) disables the
+  // cache.
+  void SetFrameCacheSize(size_t size);
+
+  // Timestamp and duration of the shown frame, and the timestamp of the
+  // latest frame from the pipeline. GST_CLOCK_TIME_NONE if unknown.
+  GstClockTime GetFramePts();
+  GstClockTime GetFrameDuration();
+  GstClockTime GetDecodedPts();
+
+  // Timestamp of the cached frame next to the shown frame in the direction,
+  // or GST_CLOCK_TIME_NONE if it isn't cached.
+  GstClockTime FindCachedFrame(bool forward);
+
+  // Shows the cached frame of |pts|. Returns false if it isn't cached.
+  bool ShowCachedFrame(GstClockTime pts);
+
+  // The returned buffer is valid until the next call, and its size can be
+  // gotten from GetFrameWidth() / GetFrameHeight().
+  const uint8_t* GetFrameBuffer();
+#ifdef USE_EGL_IMAGE_DMABUF
+  void* GetEGLImage(void* egl_display, void* egl_context);
+#endif  // USE_EGL_IMAGE_DMABUF
+
+  // Size of the frame returned by the last GetFrameBuffer() / GetEGLImage().
+  int32_t GetFrameWidth() const { return output_width_; };
+  int32_t GetFrameHeight() const { return output_height_; };
+
+  // Bytes of the converted frame buffer and the referenced GstBuffers.
+  int64_t GetFrameBufferBytes();
+
+ private:
+  // Handles both of the "handoff" and the "preroll-handoff" signals.
+  static void HandoffHandler(GstElement* fakesink, GstBuffer* buf,
+                             GstPad* new_pad, gpointer user_data);
+  // Returns false if |buffer| is already the latest frame.
+  bool SetFrame(GstBuffer* buffer, GstCaps* caps);
+  void CacheFrameLocked();
+  void ApplyScaledSize(int32_t width, int32_t height);
+#ifdef USE_EGL_IMAGE_DMABUF
+  void UnrefEGLImage();
+#endif  // USE_EGL_IMAGE_DMABUF
+
+  OnFrameDecoded on_frame_decoded_;
+  GstElement* bin_ = nullptr;
+  GstElement* video_scale_ = nullptr;
+  GstElement* video_convert_ = nullptr;
+  GstElement* caps_filter_ = nullptr;
+  GstElement* video_sink_ = nullptr;
+
+  struct CachedFrame {
+    GstBuffer* buffer;
+    int32_t width;
+    int32_t height;
+  };
+
+  // The shown frame and its size, guarded by |mutex_buffer_|.
+  GstBuffer* buffer_ = nullptr;
+  int32_t frame_width_ = 0;
+  int32_t frame_height_ = 0;
+  GstClockTime frame_pts_ = GST_CLOCK_TIME_NONE;
+  GstClockTime frame_duration_ = GST_CLOCK_TIME_NONE;
+  GstClockTime decoded_pts_ = GST_CLOCK_TIME_NONE;
+  // Recent frames by timestamp, guarded by |mutex_buffer_|.
+  std::map<GstClockTime, CachedFrame> frame_cache_;
+  size_t frame_cache_size_ = 0;
+  std::unique_ptr<uint32_t[]> pixels_;
+  size_t pixels_size_ = 0;
+  std::shared_mutex mutex_buffer_;
+
+  // Size of the frame returned to the texture. Only accessed from the raster
+  // thread.
+  int32_t output_width_ = 0;
+  int32_t output_height_ = 0;
+
+  // Size of the video, and the size set to the caps filter.
+  // |is_scale_requested_| is true while the requested size is out of the
+  // hysteresis band since |scale_request_time_|.
+  int32_t video_width_ = 0;
+  int32_t video_height_ = 0;
+  int32_t scaled_width_ = 0;
+  int32_t scaled_height_ = 0;
+  bool is_scale_requested_ = false;
+  std::chrono::steady_clock::time_point scale_request_time_;
+  std::mutex mutex_scale_;
+
+#ifdef USE_EGL_IMAGE_DMABUF
+  GstVideoInfo gst_video_info_;
+  GstEGLImage* gst_egl_image_ = NULL;
+  GstGLContext* gst_gl_ctx_ = NULL;
+  GstGLDisplayEGL* gst_gl_display_egl_ = NULL;
+#endif  // USE_EGL_IMAGE_DMABUF
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_OUTPUT_H_
@@ -4,18 +4,51 @@
 
 #include "gst_video_player.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
+namespace {
+// Size of the buffers pushed from a cache entry.
+constexpr int64_t kCacheChunkSize = 64 * 1024;
+
+// Releases the cache entry referenced by a buffer wrapping it.
+void ReleaseCacheReader(gpointer data) {
+  delete reinterpret_cast<std::shared_ptr<MediaCache::Reader>*>(data);
+}
+
+// Number of the decoded frames kept around the shown frame once frame
+// stepping is used.
+constexpr size_t kFrameCacheSize = 16;
+// Duration of a frame assumed if the buffers don't have it.
+constexpr GstClockTime kDefaultFrameDuration = GST_SECOND / 30;
+
+// GstPlayFlags of playbin, which aren't exported in the public headers.
+constexpr guint kPlayFlagAudio = 1 << 1;
+constexpr guint kPlayFlagText = 1 << 2;
+constexpr guint kPlayFlagVis = 1 << 3;
+constexpr guint kPlayFlagSoftVolume = 1 << 4;
+constexpr guint kPlayFlagNativeAudio = 1 << 5;
+constexpr guint kPlayFlagNativeVideo = 1 << 6;
+
+// GstAutoplugSelectResult of decodebin, which isn't exported either.
+constexpr gint kAutoplugSelectTry = 0;
+constexpr gint kAutoplugSelectSkip = 2;
+}  // namespace
+
 GstVideoPlayer::GstVideoPlayer(
-    const std::string& uri, std::unique_ptr<VideoPlayerStreamHandler> handler)
-    : stream_handler_(std::move(handler)) {
+    const std::string& uri, std::unique_ptr<VideoPlayerStreamHandler> handler,
+    std::shared_ptr<MediaCache> cache)
+    : stream_handler_(std::move(handler)), cache_(std::move(cache)) {
   gst_.pipeline = nullptr;
   gst_.playbin = nullptr;
-  gst_.video_convert = nullptr;
-  gst_.video_sink = nullptr;
+  gst_.tee = nullptr;
   gst_.output = nullptr;
+  gst_.audio = nullptr;
+  gst_.tempo_convert = nullptr;
+  gst_.scaletempo = nullptr;
+  gst_.audio_sink = nullptr;
   gst_.bus = nullptr;
-  gst_.buffer = nullptr;
 
   uri_ = ParseUri(uri);
   if (!CreatePipeline()) {
@@ -26,9 +59,6 @@ GstVideoPlayer::GstVideoPlayer(
 }
 
 GstVideoPlayer::~GstVideoPlayer() {
-#ifdef USE_EGL_IMAGE_DMABUF
-  UnrefEGLImage();
-#endif  // USE_EGL_IMAGE_DMABUF
   Stop();
   DestroyPipeline();
 }
@@ -44,15 +74,26 @@ bool GstVideoPlayer::Init() {
     return false;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(mutex_streaming_);
+    init_time_ = std::chrono::steady_clock::now();
+  }
+
   // Prerolls before getting information from the pipeline.
   if (!Preroll()) {
     DestroyPipeline();
     return false;
   }
 
-  // Sets internal video size and buffier.
+  // Sets internal video size. The frame buffers are allocated by the first
+  // GetFrameBuffer() of each output.
   GetVideoSize(width_, height_);
-  pixels_.reset(new uint32_t[width_ * height_]);
+  {
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      branch.output->SetVideoSize(width_, height_);
+    }
+  }
 
   stream_handler_->OnNotifyInitialized();
 
@@ -60,12 +101,25 @@ bool GstVideoPlayer::Init() {
 }
 
 bool GstVideoPlayer::Play() {
+  // Key frames only playback is only for scrubbing, and frame stepping may
+  // have reversed the segment or shown a cached frame.
+  if (is_trick_mode_ || stepped_position_ >= 0 ||
+      (segment_rate_ > 0) != (playback_rate_ > 0)) {
+    auto position = GetCurrentPosition();
+    stepped_position_ = -1;
+    if (position >= 0) {
+      ExecuteSeek(position, SeekMode::kAccurate);
+    }
+  }
+  ReleaseFrameCaches();
+
   if (gst_element_set_state(gst_.pipeline, GST_STATE_PLAYING) ==
       GST_STATE_CHANGE_FAILURE) {
     std::cerr << "Failed to change the state to PLAYING" << std::endl;
     return false;
   }
 
+  is_playing_ = true;
   stream_handler_->OnNotifyPlaying(true);
   return true;
 }
@@ -77,6 +131,7 @@ bool GstVideoPlayer::Pause() {
     return false;
   }
 
+  is_playing_ = false;
   stream_handler_->OnNotifyPlaying(false);
   return true;
 }
@@ -88,6 +143,7 @@ bool GstVideoPlayer::Stop() {
     return false;
   }
 
+  is_playing_ = false;
   stream_handler_->OnNotifyPlaying(false);
   return true;
 }
@@ -97,8 +153,12 @@ bool GstVideoPlayer::SetVolume(double volume) {
     return false;
   }
 
+  const bool was_silent = (volume_ == 0);
   volume_ = volume;
   g_object_set(gst_.playbin, "volume", volume, NULL);
+  if (was_silent != (volume == 0)) {
+    UpdatePlayFlags();
+  }
   return true;
 }
 
@@ -107,45 +167,296 @@ bool GstVideoPlayer::SetPlaybackRate(double rate) {
     return false;
   }
 
-  if (rate <= 0) {
+  if (rate == 0) {
     std::cerr << "Rate " << rate << " is not supported" << std::endl;
     return false;
   }
 
-  auto position = GetCurrentPosition();
-  if (position < 0) {
-    return false;
-  }
+  const bool is_pitch_corrected = gst_.audio && pitch_correction_ && rate > 0;
+  gint audio_count = 0;
+  g_object_get(gst_.playbin, "n-audio", &audio_count, NULL);
+  UpdateScaletempo(rate);
+
+  // Key frames only playback needs a flushing seek to stop, and scaletempo
+  // stretches the audio by the rate of the segment, which isn't updated by
+  // instant rate changes. The direction and the position of the segment
+  // are also changed only by flushing seeks.
+  if (is_trick_mode_ || (is_pitch_corrected && audio_count > 0) ||
+      stepped_position_ >= 0 || (rate > 0) != (segment_rate_ > 0) ||
+      !SetInstantPlaybackRate(rate)) {
+    auto position = GetCurrentPosition();
+    if (position < 0) {
+      return false;
+    }
 
-  if (!gst_element_seek(gst_.pipeline, rate, GST_FORMAT_TIME,
-                        GST_SEEK_FLAG_FLUSH, GST_SEEK_TYPE_SET,
-                        position * GST_MSECOND, GST_SEEK_TYPE_SET,
-                        GST_CLOCK_TIME_NONE)) {
-    std::cerr << "Failed to set playback rate to " << rate
-              << " (gst_element_seek failed)" << std::endl;
-    return false;
+    // Reverse playback needs accurate seeks not to jump to a key frame.
+    const int flags =
+        GST_SEEK_FLAG_FLUSH | (rate < 0 ? GST_SEEK_FLAG_ACCURATE : 0);
+    if (!SeekSegment(rate, flags, position * GST_MSECOND)) {
+      std::cerr << "Failed to set playback rate to " << rate
+                << " (gst_element_seek failed)" << std::endl;
+      return false;
+    }
+    stepped_position_ = -1;
+    ReleaseFrameCaches();
+  } else {
+    segment_rate_ = rate;
   }
 
   playback_rate_ = rate;
-  mute_ = (rate < 0.5 || rate > 2);
+  is_trick_mode_ = false;
+  // The audio can't be followed backward or far from 1.0x without pitch
+  // correction.
+  mute_ = rate < 0 || (!is_pitch_corrected && (rate < 0.5 || rate > 2));
   g_object_set(gst_.playbin, "mute", mute_, NULL);
 
   return true;
 }
 
+bool GstVideoPlayer::SetPitchCorrection(bool enabled) {
+  if (pitch_correction_ == enabled) {
+    return true;
+  }
+  pitch_correction_ = enabled;
+  if (playback_rate_ == 1.0) {
+    return true;
+  }
+  return SetPlaybackRate(playback_rate_);
+}
+
+// Changes the rate from the next buffers without flushing the queued data.
+// Returns false if it's not supported by GStreamer or by the demuxer, or if
+// the pipeline hasn't prerolled.
+bool GstVideoPlayer::SetInstantPlaybackRate(double rate) {
+#if GST_CHECK_VERSION(1, 18, 0)
+  GstState state;
+  gst_element_get_state(gst_.pipeline, &state, NULL, 0);
+  if (state < GST_STATE_PAUSED) {
+    return false;
+  }
+  return gst_element_seek(gst_.pipeline, rate, GST_FORMAT_TIME,
+                          GST_SEEK_FLAG_INSTANT_RATE_CHANGE, GST_SEEK_TYPE_NONE,
+                          0, GST_SEEK_TYPE_NONE, 0);
+#else
+  return false;
+#endif  // GST_CHECK_VERSION(1, 18, 0)
+}
+
 bool GstVideoPlayer::SetSeek(int64_t position) {
+  if (!gst_.pipeline) {
+    return false;
+  }
+  stepped_position_ = -1;
+  ReleaseFrameCaches();
+
+  // Flushing seeks complete asynchronously only in PAUSED or PLAYING.
+  GstState state;
+  gst_element_get_state(gst_.pipeline, &state, NULL, 0);
+  if (state < GST_STATE_PAUSED) {
+    return ExecuteSeek(position, seek_mode_);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_seek_);
+    // Rapid successive seeks (e.g. scrubbing) are coalesced, and only the
+    // latest target is executed after the ongoing seek.
+    if (is_seeking_) {
+      if (pending_seek_position_ >= 0) {
+        seek_stats_.coalesced_count++;
+      }
+      pending_seek_position_ = position;
+      return true;
+    }
+    is_seeking_ = true;
+    seek_start_time_ = std::chrono::steady_clock::now();
+  }
+
+  if (!ExecuteSeek(position, seek_mode_)) {
+    std::lock_guard<std::mutex> lock(mutex_seek_);
+    is_seeking_ = false;
+    return false;
+  }
+  return true;
+}
+
+bool GstVideoPlayer::StepFrame(bool forward) {
+  if (!gst_.pipeline || is_playing_) {
+    return false;
+  }
+
+  std::vector<GstVideoOutput*> outputs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      branch.output->SetFrameCacheSize(kFrameCacheSize);
+      outputs.push_back(branch.output.get());
+    }
+  }
+  if (outputs.empty()) {
+    return false;
+  }
+  // The outputs get the same frames from the tee, so the first one decides.
+  auto* primary = outputs.front();
+  const auto shown_pts = primary->GetFramePts();
+  if (!GST_CLOCK_TIME_IS_VALID(shown_pts)) {
+    return false;
+  }
+
+  // Shows the neighbor frame from the cache without decoding.
+  const auto cached_pts = primary->FindCachedFrame(forward);
+  if (GST_CLOCK_TIME_IS_VALID(cached_pts)) {
+    for (auto* output : outputs) {
+      output->ShowCachedFrame(cached_pts);
+    }
+    stepped_position_ = cached_pts / GST_MSECOND;
+    return true;
+  }
+  stepped_position_ = -1;
+
+  // The pipeline continues from its last frame in the same direction. In
+  // reverse, the decoder decodes a GOP once and outputs its frames backward,
+  // so the steps don't decode the GOP again.
+  const double rate = forward ? std::abs(playback_rate_)
+                              : -std::abs(playback_rate_);
+  if ((segment_rate_ > 0) == forward && shown_pts == primary->GetDecodedPts()) {
+    return gst_element_send_event(
+        gst_.pipeline, gst_event_new_step(GST_FORMAT_BUFFERS, 1,
+                                          std::abs(rate), TRUE, FALSE));
+  }
+
+  // Otherwise, restarts from the shown frame in the direction of the step.
+  // The first frame of a reverse segment is the one before its stop.
+  auto duration = primary->GetFrameDuration();
+  if (!GST_CLOCK_TIME_IS_VALID(duration)) {
+    duration = kDefaultFrameDuration;
+  }
+  const gint64 position = forward ? shown_pts + duration : shown_pts;
+  if (!SeekSegment(rate, GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE,
+                   position)) {
+    std::cerr << "Failed to step a frame" << std::endl;
+    return false;
+  }
+  is_trick_mode_ = false;
+  return true;
+}
+
+// The frames cached by StepFrame() are released when leaving frame stepping.
+void GstVideoPlayer::ReleaseFrameCaches() {
+  std::lock_guard<std::mutex> lock(mutex_outputs_);
+  for (auto& branch : outputs_) {
+    branch.output->SetFrameCacheSize(0);
+  }
+}
+
+void GstVideoPlayer::SetSeekMode(SeekMode mode) { seek_mode_ = mode; }
+
+GstVideoPlayer::SeekStats GstVideoPlayer::GetSeekStats() {
+  std::lock_guard<std::mutex> lock(mutex_seek_);
+  return seek_stats_;
+}
+
+bool GstVideoPlayer::ExecuteSeek(int64_t position, SeekMode mode) {
+  int flags = GST_SEEK_FLAG_FLUSH;
+  switch (mode) {
+    case SeekMode::kKeyUnit:
+      flags |= GST_SEEK_FLAG_KEY_UNIT;
+      break;
+    case SeekMode::kKeyUnitSnapBefore:
+      flags |= GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_BEFORE;
+      break;
+    case SeekMode::kKeyUnitSnapAfter:
+      flags |= GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_SNAP_AFTER;
+      break;
+    case SeekMode::kAccurate:
+      flags |= GST_SEEK_FLAG_ACCURATE;
+      break;
+    case SeekMode::kTrickMode:
+      flags |= GST_SEEK_FLAG_KEY_UNIT | GST_SEEK_FLAG_TRICKMODE |
+               GST_SEEK_FLAG_TRICKMODE_KEY_UNITS |
+               GST_SEEK_FLAG_TRICKMODE_NO_AUDIO;
+      break;
+  }
+
   auto nanosecond = position * 1000 * 1000;
-  if (!gst_element_seek(
-          gst_.pipeline, playback_rate_, GST_FORMAT_TIME,
-          (GstSeekFlags)(GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT),
-          GST_SEEK_TYPE_SET, nanosecond, GST_SEEK_TYPE_SET,
-          GST_CLOCK_TIME_NONE)) {
+  if (!SeekSegment(playback_rate_, flags, nanosecond)) {
     std::cerr << "Failed to seek " << nanosecond << std::endl;
     return false;
   }
+  is_trick_mode_ = (mode == SeekMode::kTrickMode);
   return true;
 }
 
+// Seeks to |position| in nsec at |rate|. Reverse segments play from the
+// position toward the start of the stream.
+bool GstVideoPlayer::SeekSegment(double rate, int flags, gint64 position) {
+  const auto seek_flags = static_cast<GstSeekFlags>(flags);
+  const auto result =
+      rate > 0 ? gst_element_seek(gst_.pipeline, rate, GST_FORMAT_TIME,
+                                  seek_flags, GST_SEEK_TYPE_SET, position,
+                                  GST_SEEK_TYPE_SET, GST_CLOCK_TIME_NONE)
+               : gst_element_seek(gst_.pipeline, rate, GST_FORMAT_TIME,
+                                  seek_flags, GST_SEEK_TYPE_SET, 0,
+                                  GST_SEEK_TYPE_SET, position);
+  if (result) {
+    segment_rate_ = rate;
+  }
+  return result;
+}
+
+// Called when the pipeline has prerolled at the new position.
+void GstVideoPlayer::CompleteSeek() {
+  std::lock_guard<std::mutex> lock(mutex_seek_);
+  if (!is_seeking_ || is_seek_queued_) {
+    return;
+  }
+
+  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - seek_start_time_)
+                      .count();
+  seek_stats_.seek_count++;
+  seek_stats_.last_duration = duration;
+  seek_stats_.max_duration = std::max(seek_stats_.max_duration, duration);
+  seek_stats_.total_duration += duration;
+
+  if (pending_seek_position_ >= 0 && !is_destroying_) {
+    ScheduleSeekLocked();
+  } else {
+    pending_seek_position_ = -1;
+    is_seeking_ = false;
+  }
+}
+
+// Seeking from the streaming threads may deadlock, so the pending seek is
+// executed from the thread pool of GStreamer.
+void GstVideoPlayer::ScheduleSeekLocked() {
+  is_seek_queued_ = true;
+  scheduled_seek_calls_++;
+  seek_start_time_ = std::chrono::steady_clock::now();
+  gst_element_call_async(gst_.pipeline, PendingSeekHandler, this, NULL);
+}
+
+// static
+void GstVideoPlayer::PendingSeekHandler(GstElement* pipeline,
+                                        gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  std::unique_lock<std::mutex> lock(self->mutex_seek_);
+  auto position = self->pending_seek_position_;
+  self->pending_seek_position_ = -1;
+  self->is_seek_queued_ = false;
+  auto result = false;
+  if (!self->is_destroying_ && position >= 0) {
+    lock.unlock();
+    result = self->ExecuteSeek(position, self->seek_mode_);
+    lock.lock();
+  }
+
+  if (!result) {
+    self->is_seeking_ = false;
+  }
+  self->scheduled_seek_calls_--;
+  self->cond_seek_.notify_all();
+}
+
 int64_t GstVideoPlayer::GetDuration() {
   GstFormat fmt = GST_FORMAT_TIME;
   gint64 duration_msec;
@@ -160,8 +471,12 @@ int64_t GstVideoPlayer::GetDuration() {
 int64_t GstVideoPlayer::GetCurrentPosition() {
   gint64 position = 0;
 
-  // Sometimes we get an error when playing streaming videos.
-  if (!gst_element_query_position(gst_.pipeline, GST_FORMAT_TIME, &position)) {
+  // A frame shown from the frame cache is off the position of the pipeline.
+  if (stepped_position_ >= 0) {
+    position = stepped_position_ * GST_MSECOND;
+  } else if (!gst_element_query_position(gst_.pipeline, GST_FORMAT_TIME,
+                                         &position)) {
+    // Sometimes we get an error when playing streaming videos.
     std::cerr << "Failed to get current position" << std::endl;
     return -1;
   }
@@ -178,69 +493,373 @@ int64_t GstVideoPlayer::GetCurrentPosition() {
       lock.unlock();
 
       if (auto_repeat_) {
-        SetSeek(0);
+        // Reverse playback repeats from the end.
+        SetSeek(playback_rate_ > 0 ? 0 : std::max<int64_t>(GetDuration(), 0));
       } else {
         stream_handler_->OnNotifyCompleted();
       }
     }
   }
 
+  // Buffering and QoS events also need to be thrown in the main thread.
+  DispatchBufferingEvents();
+  DispatchQosEvents();
+
   return position / GST_MSECOND;
 }
 
-#ifdef USE_EGL_IMAGE_DMABUF
-void* GstVideoPlayer::GetEGLImage(void* egl_display, void* egl_context) {
-  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
-  if (!gst_.buffer) {
-    return nullptr;
+void GstVideoPlayer::SetStreamSelection(const StreamSelection& selection) {
+  stream_selection_ = selection;
+  UpdatePlayFlags();
+}
+
+// Applies the stream selection and the volume to the flags of playbin. While
+// no audio is rendered, playbin removes the audio sink and the conversion and
+// volume elements in front of it.
+void GstVideoPlayer::UpdatePlayFlags() {
+  if (!gst_.playbin) {
+    return;
+  }
+
+  guint flags = 0;
+  g_object_get(gst_.playbin, "flags", &flags, NULL);
+  const auto old_flags = flags;
+  const auto& selection = stream_selection_;
+  if (selection.video_only || volume_ == 0) {
+    flags &= ~(kPlayFlagAudio | kPlayFlagVis | kPlayFlagSoftVolume);
+  } else {
+    flags |= kPlayFlagAudio | kPlayFlagSoftVolume;
+  }
+  if (selection.video_only || !selection.text) {
+    flags &= ~kPlayFlagText;
+  } else {
+    flags |= kPlayFlagText;
+  }
+  flags = selection.native_video ? (flags | kPlayFlagNativeVideo)
+                                 : (flags & ~kPlayFlagNativeVideo);
+  flags = selection.native_audio ? (flags | kPlayFlagNativeAudio)
+                                 : (flags & ~kPlayFlagNativeAudio);
+  if (flags != old_flags) {
+    g_object_set(gst_.playbin, "flags", flags, NULL);
+  }
+}
+
+void GstVideoPlayer::SetStreamingConfig(const StreamingConfig& config) {
+  streaming_config_ = config;
+  if (!gst_.playbin) {
+    return;
+  }
+
+  if (config.connection_speed > 0) {
+    g_object_set(gst_.playbin, "connection-speed",
+                 static_cast<guint64>(config.connection_speed), NULL);
+  }
+  if (config.buffer_duration >= 0) {
+    g_object_set(gst_.playbin, "buffer-duration",
+                 static_cast<gint64>(config.buffer_duration * GST_MSECOND),
+                 NULL);
+  }
+  if (config.buffer_size >= 0) {
+    g_object_set(gst_.playbin, "buffer-size",
+                 static_cast<gint>(config.buffer_size), NULL);
+  }
+}
+
+GstVideoPlayer::StreamingStats GstVideoPlayer::GetStreamingStats() {
+  std::lock_guard<std::mutex> lock(mutex_streaming_);
+  auto stats = streaming_stats_;
+  if (is_buffering_ && stats.startup_latency >= 0) {
+    // Includes the ongoing rebuffering.
+    stats.rebuffer_duration +=
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - buffering_start_time_)
+            .count();
   }
+  return stats;
+}
+
+std::vector<std::pair<int64_t, int64_t>> GstVideoPlayer::GetBufferedRanges() {
+  std::vector<std::pair<int64_t, int64_t>> ranges;
+  if (!gst_.pipeline) {
+    return ranges;
+  }
+
+  auto* query = gst_query_new_buffering(GST_FORMAT_TIME);
+  if (gst_element_query(gst_.pipeline, query)) {
+    GstFormat format;
+    gst_query_parse_buffering_range(query, &format, NULL, NULL, NULL);
+    if (format == GST_FORMAT_TIME) {
+      auto n_ranges = gst_query_get_n_buffering_ranges(query);
+      for (guint i = 0; i < n_ranges; i++) {
+        gint64 start;
+        gint64 stop;
+        if (gst_query_parse_nth_buffering_range(query, i, &start, &stop) &&
+            start >= 0 && stop >= 0) {
+          ranges.emplace_back(start / GST_MSECOND, stop / GST_MSECOND);
+        }
+      }
+    }
+  }
+  gst_query_unref(query);
+
+  return ranges;
+}
 
-  GstMemory* memory = gst_buffer_peek_memory(gst_.buffer, 0);
-  if (gst_is_dmabuf_memory(memory)) {
-    UnrefEGLImage();
+GstVideoPlayer::ResourceUsage GstVideoPlayer::GetResourceUsage() {
+  ResourceUsage usage;
+  {
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      usage.frame_buffer_bytes += branch.output->GetFrameBufferBytes();
+    }
+  }
+  usage.streaming_thread_count = streaming_thread_count_;
+  if (!gst_.pipeline) {
+    return usage;
+  }
 
-    gint fd = gst_dmabuf_memory_get_fd(memory);
-    gst_gl_display_egl_ =
-        gst_gl_display_egl_new_with_egl_display(reinterpret_cast<gpointer>(egl_display));
-    gst_gl_ctx_ = gst_gl_context_new_wrapped(
-        GST_GL_DISPLAY_CAST(gst_gl_display_egl_), reinterpret_cast<guintptr>(egl_context),
-        GST_GL_PLATFORM_EGL, GST_GL_API_GLES2);
+  // The levels of multiqueue are per pad and aren't exposed as properties, so
+  // only queue and queue2 (and downloadbuffer) are accounted.
+  auto* iterator = gst_bin_iterate_recurse(GST_BIN(gst_.pipeline));
+  GValue item = G_VALUE_INIT;
+  bool done = false;
+  while (!done) {
+    switch (gst_iterator_next(iterator, &item)) {
+      case GST_ITERATOR_OK: {
+        auto* element = GST_ELEMENT(g_value_get_object(&item));
+        auto* klass = G_OBJECT_GET_CLASS(element);
+        if (g_object_class_find_property(klass, "current-level-bytes") &&
+            g_object_class_find_property(klass, "current-level-buffers")) {
+          guint bytes = 0;
+          guint buffers = 0;
+          g_object_get(element, "current-level-bytes", &bytes,
+                       "current-level-buffers", &buffers, NULL);
+          usage.queued_bytes += bytes;
+          usage.queued_buffers += buffers;
+          usage.queue_count++;
+        }
+        auto* factory = gst_element_get_factory(element);
+        if (usage.decoder.empty() && factory && !GST_IS_BIN(element) &&
+            gst_element_factory_list_is_type(
+                factory, GST_ELEMENT_FACTORY_TYPE_DECODER |
+                             GST_ELEMENT_FACTORY_TYPE_MEDIA_VIDEO)) {
+          usage.decoder = GST_OBJECT_NAME(factory);
+        }
+        g_value_reset(&item);
+        break;
+      }
+      case GST_ITERATOR_RESYNC:
+        gst_iterator_resync(iterator);
+        usage.queued_bytes = 0;
+        usage.queued_buffers = 0;
+        usage.queue_count = 0;
+        usage.decoder.clear();
+        break;
+      default:
+        done = true;
+        break;
+    }
+  }
+  g_value_unset(&item);
+  gst_iterator_free(iterator);
+
+  return usage;
+}
+
+void GstVideoPlayer::SetAdaptiveQuality(bool enabled) {
+  adaptive_quality_ = enabled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      branch.output->SetQosEnabled(enabled);
+    }
+  }
+  // The decoders ignore the stale QoS values once the sinks stop sending
+  // them, so they're left as they are when disabled.
+  if (!gst_.pipeline || !enabled) {
+    return;
+  }
+
+  // The decoders plugged later are handled by DeepElementAddedHandler().
+  auto* iterator = gst_bin_iterate_recurse(GST_BIN(gst_.pipeline));
+  while (gst_iterator_foreach(
+             iterator,
+             [](const GValue* item, gpointer user_data) {
+               auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+               self->ApplyAdaptiveQuality(
+                   GST_ELEMENT(g_value_get_object(item)));
+             },
+             this) == GST_ITERATOR_RESYNC) {
+    gst_iterator_resync(iterator);
+  }
+  gst_iterator_free(iterator);
+}
+
+GstVideoPlayer::QosStats GstVideoPlayer::GetQosStats() {
+  std::lock_guard<std::mutex> lock(mutex_qos_);
+  return qos_stats_;
+}
+
+// Lets the video decoders handle the QoS events from the sinks. Late frames
+// are dropped before decoding, and decoders such as avdec_* skip the
+// non-reference frames while the pipeline is lagging.
+void GstVideoPlayer::ApplyAdaptiveQuality(GstElement* element) {
+  auto* factory = gst_element_get_factory(element);
+  if (!factory || GST_IS_BIN(element) ||
+      !gst_element_factory_list_is_type(
+          factory, GST_ELEMENT_FACTORY_TYPE_DECODER |
+                       GST_ELEMENT_FACTORY_TYPE_MEDIA_VIDEO) ||
+      !g_object_class_find_property(G_OBJECT_GET_CLASS(element), "qos")) {
+    return;
+  }
+  g_object_set(element, "qos", TRUE, NULL);
+}
+
+// Accumulates the QoS messages posted by the video outputs and the video
+// decoders. The counters of each element are reset by flushing seeks, so the
+// latest ones of the elements are summed up.
+void GstVideoPlayer::UpdateQosStats(GstMessage* message) {
+  auto* source = GST_MESSAGE_SRC(message);
+  if (!GST_IS_ELEMENT(source)) {
+    return;
+  }
+  auto* factory = gst_element_get_factory(GST_ELEMENT(source));
+  const bool is_output =
+      gst_.output &&
+      gst_object_has_as_ancestor(source, GST_OBJECT(gst_.output));
+  const bool is_video_decoder =
+      factory && gst_element_factory_list_is_type(
+                     factory, GST_ELEMENT_FACTORY_TYPE_DECODER |
+                                  GST_ELEMENT_FACTORY_TYPE_MEDIA_VIDEO);
+  if (!is_output && !is_video_decoder) {
+    return;
+  }
 
-    gst_gl_context_activate(gst_gl_ctx_, TRUE);
+  GstFormat format;
+  guint64 processed = 0;
+  guint64 dropped = 0;
+  gint64 jitter = 0;
+  gdouble proportion = 1.0;
+  gst_message_parse_qos_stats(message, &format, &processed, &dropped);
+  gst_message_parse_qos_values(message, &jitter, &proportion, NULL);
+  if (format != GST_FORMAT_BUFFERS && format != GST_FORMAT_DEFAULT) {
+    return;
+  }
 
-    gst_egl_image_ =
-        gst_egl_image_from_dmabuf(gst_gl_ctx_, fd, &gst_video_info_, 0, 0);
-    return reinterpret_cast<void*>(gst_egl_image_get_image(gst_egl_image_));
+  std::lock_guard<std::mutex> lock(mutex_qos_);
+  qos_counts_[GST_OBJECT_NAME(source)] = {processed, dropped, is_output};
+  qos_stats_.processed = 0;
+  qos_stats_.dropped = 0;
+  for (const auto& [name, counts] : qos_counts_) {
+    if (counts.is_output) {
+      qos_stats_.processed =
+          std::max<uint64_t>(qos_stats_.processed, counts.processed);
+    }
+    qos_stats_.dropped += counts.dropped;
+  }
+  if (is_output) {
+    qos_stats_.jitter = jitter / GST_USECOND;
+    qos_stats_.proportion = proportion;
   }
-  return nullptr;
+  qos_update_pending_ = true;
 }
 
-void GstVideoPlayer::UnrefEGLImage() {
-  if (gst_egl_image_) {
-    gst_egl_image_unref(gst_egl_image_);
-    gst_object_unref(gst_gl_ctx_);
-    gst_object_unref(gst_gl_display_egl_);
-    gst_egl_image_ = NULL;
-    gst_gl_ctx_ = NULL;
-    gst_gl_display_egl_ = NULL;
+void GstVideoPlayer::DispatchQosEvents() {
+  std::unique_lock<std::mutex> lock(mutex_qos_);
+  if (!qos_update_pending_) {
+    return;
   }
+  qos_update_pending_ = false;
+  const auto stats = qos_stats_;
+  lock.unlock();
+
+  stream_handler_->OnNotifyQosUpdate(stats.processed, stats.dropped,
+                                     stats.jitter, stats.proportion);
 }
-#endif  // USE_EGL_IMAGE_DMABUF
 
-const uint8_t* GstVideoPlayer::GetFrameBuffer() {
-  std::shared_lock<std::shared_mutex> lock(mutex_buffer_);
-  if (!gst_.buffer) {
+GstVideoOutput* GstVideoPlayer::AddOutput(
+    GstVideoOutput::OnFrameDecoded on_frame_decoded) {
+  if (!gst_.tee) {
+    return nullptr;
+  }
+
+  // An output added before the preroll takes part in it. Later outputs join
+  // the running pipeline without prerolling, otherwise the pipeline would
+  // wait for them to preroll before continuing.
+  GstState state;
+  gst_element_get_state(gst_.pipeline, &state, NULL, 0);
+  auto output = std::make_unique<GstVideoOutput>(
+      [this, on_frame_decoded]() {
+        OnFrameDecoded();
+        if (on_frame_decoded) {
+          on_frame_decoded();
+        }
+      },
+      state < GST_STATE_PAUSED);
+  if (!output->IsValid()) {
     return nullptr;
   }
 
-  const uint32_t pixel_bytes = width_ * height_ * 4;
-  gst_buffer_extract(gst_.buffer, 0, pixels_.get(), pixel_bytes);
-  return reinterpret_cast<const uint8_t*>(pixels_.get());
+  auto* bin = output->GetBin();
+  gst_bin_add(GST_BIN(gst_.output), bin);
+  gst_element_sync_state_with_parent(bin);
+
+  auto* tee_pad = gst_element_get_request_pad(gst_.tee, "src_%u");
+  auto* sink_pad = gst_element_get_static_pad(bin, "sink");
+  auto result = gst_pad_link(tee_pad, sink_pad);
+  gst_object_unref(sink_pad);
+  if (result != GST_PAD_LINK_OK) {
+    std::cerr << "Failed to link an output" << std::endl;
+    gst_element_release_request_pad(gst_.tee, tee_pad);
+    gst_object_unref(tee_pad);
+    gst_element_set_state(bin, GST_STATE_NULL);
+    gst_bin_remove(GST_BIN(gst_.output), bin);
+    return nullptr;
+  }
+
+  output->SetQosEnabled(adaptive_quality_);
+
+  std::lock_guard<std::mutex> lock(mutex_outputs_);
+  if (width_ > 0 && height_ > 0) {
+    output->SetVideoSize(width_, height_);
+  }
+  // Shows the current frame until the new branch gets the next one, which
+  // may take long while paused.
+  if (!outputs_.empty()) {
+    output->CopyFrame(*outputs_.front().output);
+  }
+  auto* raw_output = output.get();
+  outputs_.push_back({std::move(output), tee_pad});
+  return raw_output;
+}
+
+void GstVideoPlayer::RemoveOutput(GstVideoOutput* output) {
+  std::lock_guard<std::mutex> lock(mutex_outputs_);
+  auto it = std::find_if(
+      outputs_.begin(), outputs_.end(),
+      [output](const OutputBranch& branch) {
+        return branch.output.get() == output;
+      });
+  if (it == outputs_.end()) {
+    return;
+  }
+
+  it->output->Stop();
+  if (it->tee_pad) {
+    // tee drops the released pad even while pushing a buffer to it, so the
+    // other outputs keep playing.
+    gst_element_release_request_pad(gst_.tee, it->tee_pad);
+    gst_object_unref(it->tee_pad);
+    auto* bin = it->output->GetBin();
+    gst_element_set_state(bin, GST_STATE_NULL);
+    gst_bin_remove(GST_BIN(gst_.output), bin);
+  }
+  outputs_.erase(it);
 }
 
 // Creats a video pipeline using playbin.
-// $ playbin uri=<file> video-sink="videoconvert ! video/x-raw,format=RGBA !
-// fakesink"
+// $ playbin uri=<file> video-sink="tee allow-not-linked=true"
+// Each output added by AddOutput() is a branch of the tee.
 bool GstVideoPlayer::CreatePipeline() {
   gst_.pipeline = gst_pipeline_new("pipeline");
   if (!gst_.pipeline) {
@@ -252,14 +871,9 @@ bool GstVideoPlayer::CreatePipeline() {
     std::cerr << "Failed to create a source" << std::endl;
     return false;
   }
-  gst_.video_convert = gst_element_factory_make("videoconvert", "videoconvert");
-  if (!gst_.video_convert) {
-    std::cerr << "Failed to create a videoconvert" << std::endl;
-    return false;
-  }
-  gst_.video_sink = gst_element_factory_make("fakesink", "videosink");
-  if (!gst_.video_sink) {
-    std::cerr << "Failed to create a videosink" << std::endl;
+  gst_.tee = gst_element_factory_make("tee", "tee");
+  if (!gst_.tee) {
+    std::cerr << "Failed to create a tee" << std::endl;
     return false;
   }
   gst_.output = gst_bin_new("output");
@@ -274,38 +888,128 @@ bool GstVideoPlayer::CreatePipeline() {
   }
   gst_bus_set_sync_handler(gst_.bus, HandleGstMessage, this, NULL);
 
-  // Sets properties to fakesink to get the callback of a decoded frame.
-  g_object_set(G_OBJECT(gst_.video_sink), "sync", TRUE, "qos", FALSE, NULL);
-  g_object_set(G_OBJECT(gst_.video_sink), "signal-handoffs", TRUE, NULL);
-  g_signal_connect(G_OBJECT(gst_.video_sink), "handoff",
-                   G_CALLBACK(HandoffHandler), this);
-  gst_bin_add_many(GST_BIN(gst_.output), gst_.video_convert, gst_.video_sink,
-                   NULL);
+  // Applies the streaming config to adaptive demuxers created by playbin.
+  g_signal_connect(G_OBJECT(gst_.pipeline), "deep-element-added",
+                   G_CALLBACK(DeepElementAddedHandler), this);
 
-  // Adds caps to the converter to convert the color format to RGBA.
-  auto* caps = gst_caps_from_string("video/x-raw,format=RGBA");
-  auto link_ok =
-      gst_element_link_filtered(gst_.video_convert, gst_.video_sink, caps);
-  gst_caps_unref(caps);
-  if (!link_ok) {
-    std::cerr << "Failed to link elements" << std::endl;
-    return false;
-  }
+  // Outputs are linked and unlinked while playing.
+  g_object_set(G_OBJECT(gst_.tee), "allow-not-linked", TRUE, NULL);
+  gst_bin_add(GST_BIN(gst_.output), gst_.tee);
 
-  auto* sinkpad = gst_element_get_static_pad(gst_.video_convert, "sink");
+  auto* sinkpad = gst_element_get_static_pad(gst_.tee, "sink");
   auto* ghost_sinkpad = gst_ghost_pad_new("sink", sinkpad);
   gst_pad_set_active(ghost_sinkpad, TRUE);
   gst_element_add_pad(gst_.output, ghost_sinkpad);
   gst_object_unref(sinkpad);
 
+  CreateAudioSink();
+
+  // Serves the stream from the cache if it has been downloaded before,
+  // otherwise stores the downloaded bytes to the cache.
+  std::string playbin_uri = uri_;
+  if (cache_ && MediaCache::IsCacheable(uri_)) {
+    cache_reader_ = cache_->OpenReader(uri_);
+    if (cache_reader_) {
+      playbin_uri = "appsrc://";
+    } else {
+      cache_writer_ = cache_->OpenWriter(uri_);
+    }
+  }
+  g_signal_connect(gst_.playbin, "source-setup", G_CALLBACK(SourceSetup),
+                   this);
+
   // Sets properties to playbin.
-  g_object_set(gst_.playbin, "uri", uri_.c_str(), NULL);
+  g_object_set(gst_.playbin, "uri", playbin_uri.c_str(), NULL);
   g_object_set(gst_.playbin, "video-sink", gst_.output, NULL);
   gst_bin_add_many(GST_BIN(gst_.pipeline), gst_.playbin, NULL);
 
   return true;
 }
 
+// Creates the audio sink with a scaletempo stage, which is linked only while
+// the rate isn't 1.0 so that normal playback pays nothing for it.
+// $ [audioconvert ! scaletempo !] autoaudiosink
+// If scaletempo isn't available, playbin uses its default audio sink.
+void GstVideoPlayer::CreateAudioSink() {
+  auto* tempo_convert = gst_element_factory_make("audioconvert", NULL);
+  auto* scaletempo = gst_element_factory_make("scaletempo", NULL);
+  auto* audio_sink = gst_element_factory_make("autoaudiosink", NULL);
+  if (!tempo_convert || !scaletempo || !audio_sink) {
+    std::cerr << "Failed to create a scaletempo stage" << std::endl;
+    for (auto* element : {tempo_convert, scaletempo, audio_sink}) {
+      if (element) {
+        gst_object_unref(element);
+      }
+    }
+    return;
+  }
+
+  gst_.audio = gst_bin_new("audio");
+  gst_bin_add_many(GST_BIN(gst_.audio), tempo_convert, scaletempo, audio_sink,
+                   NULL);
+  gst_element_link(tempo_convert, scaletempo);
+
+  auto* sinkpad = gst_element_get_static_pad(audio_sink, "sink");
+  auto* ghost_sinkpad = gst_ghost_pad_new("sink", sinkpad);
+  gst_pad_set_active(ghost_sinkpad, TRUE);
+  gst_element_add_pad(gst_.audio, ghost_sinkpad);
+  gst_object_unref(sinkpad);
+
+  gst_.tempo_convert = tempo_convert;
+  gst_.scaletempo = scaletempo;
+  gst_.audio_sink = audio_sink;
+  g_object_set(gst_.playbin, "audio-sink", gst_.audio, NULL);
+}
+
+// Links or bypasses scaletempo for |rate|. The pads are relinked while no
+// data flows into the audio sink, and the sticky events (caps and segment)
+// are sent again to the new path.
+void GstVideoPlayer::UpdateScaletempo(double rate) {
+  if (!gst_.audio) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_scaletempo_);
+    is_scaletempo_requested_ = pitch_correction_ && rate > 0 && rate != 1.0;
+    if (is_scaletempo_requested_ == is_scaletempo_linked_) {
+      return;
+    }
+  }
+  auto* sinkpad = gst_element_get_static_pad(gst_.audio, "sink");
+  gst_pad_add_probe(sinkpad, GST_PAD_PROBE_TYPE_IDLE, ScaletempoSwitchProbe,
+                    this, NULL);
+  gst_object_unref(sinkpad);
+}
+
+// static
+GstPadProbeReturn GstVideoPlayer::ScaletempoSwitchProbe(GstPad* pad,
+                                                        GstPadProbeInfo* info,
+                                                        gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_scaletempo_);
+  // A later request may have been applied by an earlier probe.
+  if (self->is_scaletempo_requested_ == self->is_scaletempo_linked_) {
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  auto* ghost_pad = GST_GHOST_PAD(pad);
+  if (self->is_scaletempo_requested_) {
+    auto* tempo_sinkpad =
+        gst_element_get_static_pad(self->gst_.tempo_convert, "sink");
+    gst_ghost_pad_set_target(ghost_pad, tempo_sinkpad);
+    gst_object_unref(tempo_sinkpad);
+    gst_element_link(self->gst_.scaletempo, self->gst_.audio_sink);
+  } else {
+    gst_element_unlink(self->gst_.scaletempo, self->gst_.audio_sink);
+    auto* sinkpad = gst_element_get_static_pad(self->gst_.audio_sink, "sink");
+    gst_ghost_pad_set_target(ghost_pad, sinkpad);
+    gst_object_unref(sinkpad);
+  }
+  self->is_scaletempo_linked_ = self->is_scaletempo_requested_;
+  return GST_PAD_PROBE_REMOVE;
+}
+
 bool GstVideoPlayer::Preroll() {
   if (!gst_.playbin) {
     return false;
@@ -317,6 +1021,14 @@ bool GstVideoPlayer::Preroll() {
     return false;
   }
 
+  // Live sources don't preroll, and they mustn't be paused while buffering.
+  // They aren't cached since they have no end.
+  is_live_ = (result == GST_STATE_CHANGE_NO_PREROLL);
+  if (is_live_) {
+    std::lock_guard<std::mutex> lock(mutex_cache_);
+    cache_writer_ = nullptr;
+  }
+
   // Waits until the state becomes GST_STATE_PAUSED.
   if (result == GST_STATE_CHANGE_ASYNC) {
     GstState state;
@@ -331,17 +1043,33 @@ bool GstVideoPlayer::Preroll() {
 }
 
 void GstVideoPlayer::DestroyPipeline() {
-  if (gst_.video_sink) {
-    g_object_set(G_OBJECT(gst_.video_sink), "signal-handoffs", FALSE, NULL);
+  {
+    // The outputs are kept until RemoveOutput() or the destruction since the
+    // caller holds them, but stop notifying frames here.
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      branch.output->Stop();
+    }
   }
 
   if (gst_.pipeline) {
+    // Waits for the pending seek not to be executed after destruction.
+    std::unique_lock<std::mutex> lock(mutex_seek_);
+    is_destroying_ = true;
+    cond_seek_.wait(lock, [this] { return scheduled_seek_calls_ == 0; });
+    lock.unlock();
+
     gst_element_set_state(gst_.pipeline, GST_STATE_NULL);
   }
 
-  if (gst_.buffer) {
-    gst_buffer_unref(gst_.buffer);
-    gst_.buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_outputs_);
+    for (auto& branch : outputs_) {
+      if (branch.tee_pad) {
+        gst_object_unref(branch.tee_pad);
+        branch.tee_pad = nullptr;
+      }
+    }
   }
 
   if (gst_.bus) {
@@ -362,13 +1090,14 @@ void GstVideoPlayer::DestroyPipeline() {
     gst_.output = nullptr;
   }
 
-  if (gst_.video_sink) {
-    gst_.video_sink = nullptr;
+  if (gst_.tee) {
+    gst_.tee = nullptr;
   }
 
-  if (gst_.video_convert) {
-    gst_.video_convert = nullptr;
-  }
+  gst_.audio = nullptr;
+  gst_.tempo_convert = nullptr;
+  gst_.scaletempo = nullptr;
+  gst_.audio_sink = nullptr;
 }
 
 std::string GstVideoPlayer::ParseUri(const std::string& uri) {
@@ -388,13 +1117,14 @@ std::string GstVideoPlayer::ParseUri(const std::string& uri) {
 }
 
 void GstVideoPlayer::GetVideoSize(int32_t& width, int32_t& height) {
-  if (!gst_.pipeline || !gst_.video_sink) {
+  if (!gst_.pipeline || !gst_.tee) {
     std::cerr
         << "Failed to get video size. The pileline hasn't initialized yet.";
     return;
   }
 
-  auto* sink_pad = gst_element_get_static_pad(gst_.video_sink, "sink");
+  // The caps before the scaling of the outputs.
+  auto* sink_pad = gst_element_get_static_pad(gst_.tee, "sink");
   if (!sink_pad) {
     std::cerr << "Failed to get a pad";
     return;
@@ -418,47 +1148,267 @@ void GstVideoPlayer::GetVideoSize(int32_t& width, int32_t& height) {
   gst_structure_get_int(structure, "width", &width);
   gst_structure_get_int(structure, "height", &height);
 
-#ifdef USE_EGL_IMAGE_DMABUF
-  gboolean res = gst_video_info_from_caps(&gst_video_info_, caps);
-  if (!res) {
-    std::cerr << "Failed to get a gst_video_info" << std::endl;
-    gst_caps_unref(caps);
-    gst_object_unref(sink_pad);
+  gst_caps_unref(caps);
+  gst_object_unref(sink_pad);
+}
+
+void GstVideoPlayer::ApplyStreamingConfig(GstElement* element) {
+  auto* klass = G_OBJECT_GET_CLASS(element);
+  const auto& config = streaming_config_;
+
+  // adaptivedemux2 based demuxers (hlsdemux2, dashdemux2) support both limits.
+  // The legacy dashdemux only supports max-bitrate, and hlsdemux only selects
+  // the variant based on the connection speed.
+  if (config.min_bitrate > 0 &&
+      g_object_class_find_property(klass, "min-bitrate")) {
+    g_object_set(element, "min-bitrate", config.min_bitrate, NULL);
+  }
+  if (config.max_bitrate > 0) {
+    if (g_object_class_find_property(klass, "max-bitrate")) {
+      g_object_set(element, "max-bitrate", config.max_bitrate, NULL);
+    } else if (g_object_class_find_property(klass, "connection-speed")) {
+      guint speed = config.max_bitrate / 1000;
+      if (config.connection_speed > 0 && config.connection_speed < speed) {
+        speed = config.connection_speed;
+      }
+      g_object_set(element, "connection-speed", speed, NULL);
+    }
+  }
+}
+
+void GstVideoPlayer::UpdateBufferingState(int32_t percent) {
+  std::lock_guard<std::mutex> lock(mutex_streaming_);
+  buffering_percent_ = percent;
+  buffering_update_pending_ = true;
+
+  if (percent < 100 && !is_buffering_) {
+    is_buffering_ = true;
+    buffering_start_pending_ = true;
+    buffering_start_time_ = std::chrono::steady_clock::now();
+  } else if (percent >= 100 && is_buffering_) {
+    is_buffering_ = false;
+    buffering_end_pending_ = true;
+
+    // Buffering before the first frame is a part of the startup latency.
+    if (streaming_stats_.startup_latency >= 0) {
+      streaming_stats_.rebuffer_count++;
+      streaming_stats_.rebuffer_duration +=
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - buffering_start_time_)
+              .count();
+    }
+  }
+}
+
+void GstVideoPlayer::DispatchBufferingEvents() {
+  std::unique_lock<std::mutex> lock(mutex_streaming_);
+  auto start_pending = buffering_start_pending_;
+  auto update_pending = buffering_update_pending_;
+  auto end_pending = buffering_end_pending_;
+  auto is_buffering = is_buffering_;
+  auto percent = buffering_percent_;
+  buffering_start_pending_ = false;
+  buffering_update_pending_ = false;
+  buffering_end_pending_ = false;
+  lock.unlock();
+
+  if (start_pending) {
+    stream_handler_->OnNotifyBufferingStart();
+  }
+  if (update_pending) {
+    stream_handler_->OnNotifyBufferingUpdate(percent);
+  }
+  if (end_pending) {
+    stream_handler_->OnNotifyBufferingEnd();
+  }
+
+  // Holds the playback until the buffer is filled not to stutter.
+  if (is_live_ || !is_playing_ || start_pending == end_pending) {
     return;
   }
-#endif  // USE_EGL_IMAGE_DMABUF
+  auto state = is_buffering ? GST_STATE_PAUSED : GST_STATE_PLAYING;
+  if (gst_element_set_state(gst_.pipeline, state) ==
+      GST_STATE_CHANGE_FAILURE) {
+    std::cerr << "Failed to change the state while buffering" << std::endl;
+  }
+}
 
-  gst_caps_unref(caps);
-  gst_object_unref(sink_pad);
+// Called from the streaming threads of the outputs.
+void GstVideoPlayer::OnFrameDecoded() {
+  std::lock_guard<std::mutex> lock(mutex_streaming_);
+  if (streaming_stats_.startup_latency < 0) {
+    streaming_stats_.startup_latency =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - init_time_)
+            .count();
+  }
 }
 
 // static
-void GstVideoPlayer::HandoffHandler(GstElement* fakesink, GstBuffer* buf,
-                                    GstPad* new_pad, gpointer user_data) {
+void GstVideoPlayer::SourceSetup(GstElement* playbin, GstElement* source,
+                                 gpointer user_data) {
   auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
-  auto* caps = gst_pad_get_current_caps(new_pad);
-  auto* structure = gst_caps_get_structure(caps, 0);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  if (self->cache_reader_) {
+    gst_util_set_object_arg(G_OBJECT(source), "stream-type", "random-access");
+    g_object_set(G_OBJECT(source), "format", GST_FORMAT_BYTES, "size",
+                 static_cast<gint64>(self->cache_reader_->GetSize()), NULL);
+    g_signal_connect(G_OBJECT(source), "need-data",
+                     G_CALLBACK(CacheNeedDataHandler), self);
+    g_signal_connect(G_OBJECT(source), "seek-data",
+                     G_CALLBACK(CacheSeekDataHandler), self);
+  } else if (self->cache_writer_) {
+    auto* src_pad = gst_element_get_static_pad(source, "src");
+    if (src_pad) {
+      gst_pad_add_probe(src_pad,
+                        static_cast<GstPadProbeType>(
+                            GST_PAD_PROBE_TYPE_BUFFER |
+                            GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM),
+                        CacheWriteProbe, self, NULL);
+      gst_object_unref(src_pad);
+    }
+  }
+}
 
-  int width;
-  int height;
-  gst_structure_get_int(structure, "width", &width);
-  gst_structure_get_int(structure, "height", &height);
-  gst_caps_unref(caps);
-  if (width != self->width_ || height != self->height_) {
-    self->width_ = width;
-    self->height_ = height;
-    self->pixels_.reset(new uint32_t[width * height]);
-    std::cout << "Pixel buffer size: width = " << width
-              << ", height = " << height << std::endl;
+// static
+void GstVideoPlayer::CacheNeedDataHandler(GstElement* appsrc, guint length,
+                                          gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  const auto& reader = self->cache_reader_;
+  GstFlowReturn ret;
+  if (!reader || self->cache_read_offset_ >= reader->GetSize()) {
+    g_signal_emit_by_name(appsrc, "end-of-stream", &ret);
+    return;
+  }
+
+  auto size = std::min<int64_t>(kCacheChunkSize,
+                                reader->GetSize() - self->cache_read_offset_);
+  if (length > 0 && length < size) {
+    size = length;
+  }
+
+  // Wraps the memory-mapped file without copying it. The buffer keeps the
+  // entry mapped while it's queued downstream.
+  auto* buffer = gst_buffer_new_wrapped_full(
+      GST_MEMORY_FLAG_READONLY, const_cast<uint8_t*>(reader->GetData()),
+      reader->GetSize(), self->cache_read_offset_, size,
+      new std::shared_ptr<MediaCache::Reader>(reader), ReleaseCacheReader);
+  GST_BUFFER_OFFSET(buffer) = self->cache_read_offset_;
+  g_signal_emit_by_name(appsrc, "push-buffer", buffer, &ret);
+  gst_buffer_unref(buffer);
+
+  self->cache_read_offset_ += size;
+  reader->NotifyRead(size);
+}
+
+// static
+gboolean GstVideoPlayer::CacheSeekDataHandler(GstElement* appsrc,
+                                              guint64 offset,
+                                              gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  if (!self->cache_reader_ ||
+      static_cast<int64_t>(offset) > self->cache_reader_->GetSize()) {
+    return FALSE;
+  }
+  self->cache_read_offset_ = offset;
+  return TRUE;
+}
+
+// static
+GstPadProbeReturn GstVideoPlayer::CacheWriteProbe(GstPad* pad,
+                                                  GstPadProbeInfo* info,
+                                                  gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  std::lock_guard<std::mutex> lock(self->mutex_cache_);
+  auto& writer = self->cache_writer_;
+  if (!writer) {
+    return GST_PAD_PROBE_REMOVE;
+  }
+
+  // Range requests after seeking start a new segment in bytes.
+  if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
+    auto* event = GST_PAD_PROBE_INFO_EVENT(info);
+    if (GST_EVENT_TYPE(event) == GST_EVENT_SEGMENT) {
+      const GstSegment* segment;
+      gst_event_parse_segment(event, &segment);
+      if (segment->format == GST_FORMAT_BYTES) {
+        self->cache_write_offset_ = segment->start;
+      }
+    } else if (GST_EVENT_TYPE(event) == GST_EVENT_CAPS) {
+      GstCaps* caps;
+      gst_event_parse_caps(event, &caps);
+      auto* structure = gst_caps_get_structure(caps, 0);
+      if (structure) {
+        writer->SetContentType(gst_structure_get_name(structure));
+      }
+    }
+  } else {
+    if (writer->GetContentLength() < 0) {
+      gint64 length;
+      if (gst_pad_query_duration(pad, GST_FORMAT_BYTES, &length)) {
+        writer->SetContentLength(length);
+      }
+    }
+
+    auto* buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    int64_t offset = GST_BUFFER_OFFSET_IS_VALID(buffer)
+                         ? GST_BUFFER_OFFSET(buffer)
+                         : self->cache_write_offset_;
+    GstMapInfo map;
+    if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+      writer->Write(offset, map.data, map.size);
+      gst_buffer_unmap(buffer, &map);
+    }
+    self->cache_write_offset_ = offset + gst_buffer_get_size(buffer);
+  }
+
+  // The writer is released once the entry is committed or discarded, e.g.
+  // for the manifests of adaptive streams.
+  if (writer->IsClosed()) {
+    writer = nullptr;
+    return GST_PAD_PROBE_REMOVE;
+  }
+  return GST_PAD_PROBE_OK;
+}
+
+// static
+void GstVideoPlayer::DeepElementAddedHandler(GstBin* pipeline, GstBin* sub_bin,
+                                             GstElement* element,
+                                             gpointer user_data) {
+  auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+  auto* factory = gst_element_get_factory(element);
+  if (factory && gst_element_factory_list_is_type(
+                     factory, GST_ELEMENT_FACTORY_TYPE_DEMUXER)) {
+    self->ApplyStreamingConfig(element);
+  }
+  if (self->adaptive_quality_) {
+    self->ApplyAdaptiveQuality(element);
   }
 
-  std::lock_guard<std::shared_mutex> lock(self->mutex_buffer_);
-  if (self->gst_.buffer) {
-    gst_buffer_unref(self->gst_.buffer);
-    self->gst_.buffer = nullptr;
+  // Playbin doesn't render the audio of video only players, but decodebin
+  // still plugs the parsers and the decoders for it.
+  if (factory && self->stream_selection_.video_only &&
+      g_strcmp0(GST_OBJECT_NAME(factory), "decodebin") == 0) {
+    g_signal_connect(element, "autoplug-select",
+                     G_CALLBACK(AutoplugSelectHandler), self);
   }
-  self->gst_.buffer = gst_buffer_ref(buf);
-  self->stream_handler_->OnNotifyFrameDecoded();
+}
+
+// static
+// Leaves the audio streams of video only players unlinked. The demuxers keep
+// pushing the video while the audio pads return not-linked.
+gint GstVideoPlayer::AutoplugSelectHandler(GstElement* decodebin, GstPad* pad,
+                                           GstCaps* caps,
+                                           GstElementFactory* factory,
+                                           gpointer user_data) {
+  auto* structure = gst_caps_get_structure(caps, 0);
+  if (structure &&
+      g_str_has_prefix(gst_structure_get_name(structure), "audio/")) {
+    return kAutoplugSelectSkip;
+  }
+  return kAutoplugSelectTry;
 }
 
 // static
@@ -472,6 +1422,37 @@ GstBusSyncReply GstVideoPlayer::HandleGstMessage(GstBus* bus,
       self->is_completed_ = true;
       break;
     }
+    case GST_MESSAGE_ASYNC_DONE: {
+      auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+      if (GST_MESSAGE_SRC(message) == GST_OBJECT(self->gst_.pipeline)) {
+        self->CompleteSeek();
+      }
+      break;
+    }
+    case GST_MESSAGE_STREAM_STATUS: {
+      auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+      GstStreamStatusType type;
+      GstElement* owner;
+      gst_message_parse_stream_status(message, &type, &owner);
+      if (type == GST_STREAM_STATUS_TYPE_ENTER) {
+        self->streaming_thread_count_++;
+      } else if (type == GST_STREAM_STATUS_TYPE_LEAVE) {
+        self->streaming_thread_count_--;
+      }
+      break;
+    }
+    case GST_MESSAGE_BUFFERING: {
+      auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+      gint percent;
+      gst_message_parse_buffering(message, &percent);
+      self->UpdateBufferingState(percent);
+      break;
+    }
+    case GST_MESSAGE_QOS: {
+      auto* self = reinterpret_cast<GstVideoPlayer*>(user_data);
+      self->UpdateQosStats(message);
+      break;
+    }
     case GST_MESSAGE_WARNING: {
       gchar* debug;
       GError* error;
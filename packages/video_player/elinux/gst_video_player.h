@@ -7,24 +7,113 @@
 
 #include <gst/gst.h>
 
-#ifdef USE_EGL_IMAGE_DMABUF
-#include <gst/allocators/gstdmabuf.h>
-#include <gst/gl/egl/egl.h>
-#include <gst/gl/gl.h>
-#include <gst/video/video.h>
-#endif  // USE_EGL_IMAGE_DMABUF
-
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "gst_video_output.h"
+#include "media_cache.h"
 #include "video_player_stream_handler.h"
 
 class GstVideoPlayer {
  public:
+  // Tuning parameters for network (HLS/DASH/progressive) streams.
+  struct StreamingConfig {
+    // Hint of the network connection speed in kbps. 0 means unknown.
+    uint64_t connection_speed = 0;
+    // Bitrate limits in bps for the variant selection of adaptivedemux.
+    // 0 means no limit.
+    uint32_t min_bitrate = 0;
+    uint32_t max_bitrate = 0;
+    // Target buffering duration in msec and size in bytes. -1 means default.
+    int64_t buffer_duration = -1;
+    int32_t buffer_size = -1;
+  };
+
+  // Streams rendered by the player, applied to the flags of playbin.
+  struct StreamSelection {
+    // Renders only the video. The audio streams aren't decoded at all.
+    bool video_only = false;
+    // Renders subtitles over the video.
+    bool text = true;
+    // Skips the color conversion and the scaling of playbin when the sinks
+    // accept the decoded formats.
+    bool native_video = false;
+    // Skips the audio conversion and the resampling of playbin when the
+    // sinks accept the decoded formats.
+    bool native_audio = false;
+  };
+
+  // Latencies of a playback session in msec.
+  struct StreamingStats {
+    int64_t startup_latency = -1;
+    int32_t rebuffer_count = 0;
+    int64_t rebuffer_duration = 0;
+  };
+
+  // Strategies of seeking.
+  enum class SeekMode {
+    // Seeks to the nearest key frame. Fast, but may land far from the target
+    // on long-GOP content.
+    kKeyUnit = 0,
+    // Seeks to the key frame at or before the target.
+    kKeyUnitSnapBefore = 1,
+    // Seeks to the key frame at or after the target.
+    kKeyUnitSnapAfter = 2,
+    // Decodes from the previous key frame up to the exact target.
+    kAccurate = 3,
+    // Decodes only key frames. Suitable for scrubbing.
+    kTrickMode = 4,
+  };
+
+  // Durations of seeks in msec from the request to the completion of the
+  // preroll at the new position.
+  struct SeekStats {
+    int32_t seek_count = 0;
+    // Number of seeks replaced by a later one before they were executed.
+    int32_t coalesced_count = 0;
+    int64_t last_duration = -1;
+    int64_t max_duration = 0;
+    int64_t total_duration = 0;
+  };
+
+  // Statistics of the QoS messages of the video elements.
+  struct QosStats {
+    // Frames passed through the video outputs, and frames dropped by the
+    // decoder, the converters and the sinks for being late.
+    uint64_t processed = 0;
+    uint64_t dropped = 0;
+    // Lateness of the last frame at the sink in usec. Negative if early.
+    int64_t jitter = 0;
+    // Processing rate requested to the upstream relative to real time.
+    // Larger than 1.0 while the pipeline can't keep up.
+    double proportion = 1.0;
+  };
+
+  // Memory and threads held by the pipeline.
+  struct ResourceUsage {
+    // Bytes of the converted frame buffers and the referenced GstBuffers of
+    // all outputs.
+    int64_t frame_buffer_bytes = 0;
+    // Bytes and buffers waiting in the queue and queue2 elements.
+    int64_t queued_bytes = 0;
+    int32_t queued_buffers = 0;
+    int32_t queue_count = 0;
+    int32_t streaming_thread_count = 0;
+    // Factory name of the video decoder, or empty before it's plugged.
+    std::string decoder;
+  };
+
   GstVideoPlayer(const std::string& uri,
-                 std::unique_ptr<VideoPlayerStreamHandler> handler);
+                 std::unique_ptr<VideoPlayerStreamHandler> handler,
+                 std::shared_ptr<MediaCache> cache = nullptr);
   ~GstVideoPlayer();
 
   static void GstLibraryLoad();
@@ -34,16 +123,45 @@ class GstVideoPlayer {
   bool Play();
   bool Pause();
   bool Stop();
+  // The audio branch is removed while the volume is 0.
   bool SetVolume(double volume);
+  // Negative rates play backward from the current position.
   bool SetPlaybackRate(double rate);
+  // Stretches the audio keeping its pitch at rates other than 1.0 if
+  // scaletempo is available. Disabled by default, since scaletempo follows
+  // only the rate of the segment and every rate change then needs a
+  // flushing seek instead of an instant rate change. While disabled, the
+  // audio is muted at the rates it's hard to follow.
+  bool SetPitchCorrection(bool enabled);
   void SetAutoRepeat(bool auto_repeat) { auto_repeat_ = auto_repeat; };
   bool SetSeek(int64_t position);
+  // Shows the next or the previous frame while paused. The frames around the
+  // shown frame are cached, so that stepping back and forth doesn't decode
+  // them again.
+  bool StepFrame(bool forward);
+  void SetSeekMode(SeekMode mode);
+  SeekStats GetSeekStats();
   int64_t GetDuration();
   int64_t GetCurrentPosition();
-  const uint8_t* GetFrameBuffer();
-#ifdef USE_EGL_IMAGE_DMABUF
-  void* GetEGLImage(void* egl_display, void* egl_context);
-#endif  // USE_EGL_IMAGE_DMABUF
+  void SetStreamingConfig(const StreamingConfig& config);
+  // Must be called before Init() to skip decoding the audio.
+  void SetStreamSelection(const StreamSelection& selection);
+  StreamingStats GetStreamingStats();
+  std::vector<std::pair<int64_t, int64_t>> GetBufferedRanges();
+  ResourceUsage GetResourceUsage();
+  // Adapts the quality to the CPU load. Late frames are dropped before the
+  // conversion and the copy, and decoders skip frames to catch up, instead
+  // of drifting out of A/V sync. Disabled by default.
+  void SetAdaptiveQuality(bool enabled);
+  QosStats GetQosStats();
+  // Adds a branch rendering the decoded video to a texture, so that one
+  // decode can feed multiple textures. |on_frame_decoded| is called from a
+  // streaming thread on every frame of the branch. The returned output is
+  // owned by the player and valid until RemoveOutput() or the destruction.
+  GstVideoOutput* AddOutput(GstVideoOutput::OnFrameDecoded on_frame_decoded);
+  // Detaches |output| from the pipeline without stopping the other outputs.
+  void RemoveOutput(GstVideoOutput* output);
+  // Size of the video.
   int32_t GetWidth() const { return width_; };
   int32_t GetHeight() const { return height_; };
 
@@ -51,46 +169,136 @@ class GstVideoPlayer {
   struct GstVideoElements {
     GstElement* pipeline;
     GstElement* playbin;
-    GstElement* video_convert;
-    GstElement* video_sink;
+    GstElement* tee;
     GstElement* output;
+    GstElement* audio;
+    GstElement* tempo_convert;
+    GstElement* scaletempo;
+    GstElement* audio_sink;
     GstBus* bus;
-    GstBuffer* buffer;
   };
 
-  static void HandoffHandler(GstElement* fakesink, GstBuffer* buf,
-                             GstPad* new_pad, gpointer user_data);
+  // An output and the request pad of the tee feeding it.
+  struct OutputBranch {
+    std::unique_ptr<GstVideoOutput> output;
+    GstPad* tee_pad;
+  };
+
   static GstBusSyncReply HandleGstMessage(GstBus* bus, GstMessage* message,
                                           gpointer user_data);
+  static void SourceSetup(GstElement* playbin, GstElement* source,
+                          gpointer user_data);
+  static void CacheNeedDataHandler(GstElement* appsrc, guint length,
+                                   gpointer user_data);
+  static gboolean CacheSeekDataHandler(GstElement* appsrc, guint64 offset,
+                                       gpointer user_data);
+  static GstPadProbeReturn CacheWriteProbe(GstPad* pad, GstPadProbeInfo* info,
+                                           gpointer user_data);
+  static void DeepElementAddedHandler(GstBin* pipeline, GstBin* sub_bin,
+                                      GstElement* element, gpointer user_data);
+  static gint AutoplugSelectHandler(GstElement* decodebin, GstPad* pad,
+                                    GstCaps* caps, GstElementFactory* factory,
+                                    gpointer user_data);
+  static void PendingSeekHandler(GstElement* pipeline, gpointer user_data);
+  static GstPadProbeReturn ScaletempoSwitchProbe(GstPad* pad,
+                                                 GstPadProbeInfo* info,
+                                                 gpointer user_data);
   std::string ParseUri(const std::string& uri);
   bool CreatePipeline();
+  void CreateAudioSink();
+  void UpdateScaletempo(double rate);
+  void UpdatePlayFlags();
   void DestroyPipeline();
   bool Preroll();
   void GetVideoSize(int32_t& width, int32_t& height);
-#ifdef USE_EGL_IMAGE_DMABUF
-  void UnrefEGLImage();
-#endif  // USE_EGL_IMAGE_DMABUF
+  void OnFrameDecoded();
+  void ApplyStreamingConfig(GstElement* element);
+  void UpdateBufferingState(int32_t percent);
+  void DispatchBufferingEvents();
+  void ApplyAdaptiveQuality(GstElement* element);
+  void UpdateQosStats(GstMessage* message);
+  void DispatchQosEvents();
+  bool SetInstantPlaybackRate(double rate);
+  bool SeekSegment(double rate, int flags, gint64 position);
+  bool ExecuteSeek(int64_t position, SeekMode mode);
+  void CompleteSeek();
+  void ScheduleSeekLocked();
+  void ReleaseFrameCaches();
 
   GstVideoElements gst_;
   std::string uri_;
-  std::unique_ptr<uint32_t[]> pixels_;
-  int32_t width_;
-  int32_t height_;
+  int32_t width_ = 0;
+  int32_t height_ = 0;
+  std::vector<OutputBranch> outputs_;
+  std::mutex mutex_outputs_;
   double volume_ = 1.0;
+  StreamSelection stream_selection_;
   double playback_rate_ = 1.0;
   bool mute_ = false;
+  bool pitch_correction_ = false;
+  // Whether scaletempo should be / is linked in front of the audio sink,
+  // guarded by |mutex_scaletempo_|.
+  bool is_scaletempo_requested_ = false;
+  bool is_scaletempo_linked_ = false;
+  std::mutex mutex_scaletempo_;
   bool auto_repeat_ = false;
   bool is_completed_ = false;
   std::mutex mutex_event_completed_;
-  std::shared_mutex mutex_buffer_;
-  std::unique_ptr<VideoPlayerStreamHandler> stream_handler_;
 
-#ifdef USE_EGL_IMAGE_DMABUF
-  GstVideoInfo gst_video_info_;
-  GstEGLImage* gst_egl_image_ = NULL;
-  GstGLContext* gst_gl_ctx_ = NULL;
-  GstGLDisplayEGL* gst_gl_display_egl_ = NULL;
-#endif  // USE_EGL_IMAGE_DMABUF
+  // Read by DeepElementAddedHandler() on streaming threads.
+  std::atomic<bool> adaptive_quality_{false};
+  // Latest counters of each element posting QoS messages, and whether the
+  // stats changed since they were notified, guarded by |mutex_qos_|.
+  QosStats qos_stats_;
+  struct QosCounts {
+    guint64 processed;
+    guint64 dropped;
+    bool is_output;
+  };
+  std::map<std::string, QosCounts> qos_counts_;
+  bool qos_update_pending_ = false;
+  std::mutex mutex_qos_;
+
+  StreamingConfig streaming_config_;
+  bool is_live_ = false;
+  bool is_playing_ = false;
+  bool is_buffering_ = false;
+  bool buffering_start_pending_ = false;
+  bool buffering_update_pending_ = false;
+  bool buffering_end_pending_ = false;
+  int32_t buffering_percent_ = 100;
+  std::chrono::steady_clock::time_point init_time_;
+  std::chrono::steady_clock::time_point buffering_start_time_;
+  StreamingStats streaming_stats_;
+  std::mutex mutex_streaming_;
+
+  SeekMode seek_mode_ = SeekMode::kKeyUnit;
+  bool is_trick_mode_ = false;
+  // Rate of the current segment, which is reversed by frame stepping while
+  // paused. Restored to |playback_rate_| by Play().
+  double segment_rate_ = 1.0;
+  // Position in msec of the frame shown from the frame cache, or -1 if the
+  // frame of the pipeline is shown.
+  int64_t stepped_position_ = -1;
+  bool is_seeking_ = false;
+  bool is_seek_queued_ = false;
+  int32_t scheduled_seek_calls_ = 0;
+  bool is_destroying_ = false;
+  int64_t pending_seek_position_ = -1;
+  std::chrono::steady_clock::time_point seek_start_time_;
+  SeekStats seek_stats_;
+  std::mutex mutex_seek_;
+  std::condition_variable cond_seek_;
+
+  std::shared_ptr<MediaCache> cache_;
+  // Shared with the buffers wrapping the mapped entry.
+  std::shared_ptr<MediaCache::Reader> cache_reader_;
+  std::unique_ptr<MediaCache::Writer> cache_writer_;
+  int64_t cache_read_offset_ = 0;
+  int64_t cache_write_offset_ = 0;
+  std::mutex mutex_cache_;
+  std::atomic<int32_t> streaming_thread_count_{0};
+  std::unique_ptr<VideoPlayerStreamHandler> stream_handler_;
 };
 
 #endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_GST_VIDEO_PLAYER_H_
@@ -0,0 +1,157 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MEDIA_CACHE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MEDIA_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// On-disk cache of network media files. Entries are addressed by the SHA-256
+// of their URI, filled while they are downloaded for the first time and
+// served from memory-mapped files after that. The least recently used entries
+// are evicted when the total size exceeds the limit.
+//
+// packages/audioplayers/elinux keeps a copy of this file and media_cache.cc,
+// since the plugins can't share sources. Copy the changes there as well.
+class MediaCache {
+ public:
+  struct Stats {
+    int64_t hit_count = 0;
+    int64_t miss_count = 0;
+    int64_t read_bytes = 0;
+    int64_t written_bytes = 0;
+    int64_t eviction_count = 0;
+    int64_t total_size = 0;
+  };
+
+  // A complete entry mapped into memory. The entry isn't evicted while it's
+  // opened.
+  class Reader {
+   public:
+    ~Reader();
+
+    // Prevent copying.
+    Reader(Reader const&) = delete;
+    Reader& operator=(Reader const&) = delete;
+
+    const uint8_t* GetData() const { return data_; }
+    int64_t GetSize() const { return size_; }
+
+    // Counts the bytes served from this entry.
+    void NotifyRead(int64_t bytes);
+
+   private:
+    friend class MediaCache;
+    Reader(MediaCache* cache, const std::string& key, const uint8_t* data,
+           int64_t size);
+
+    MediaCache* cache_;
+    const std::string key_;
+    const uint8_t* data_;
+    const int64_t size_;
+  };
+
+  // Stores the byte ranges of an entry being downloaded. The ranges may arrive
+  // in any order (e.g. range requests after seeking), and the entry is
+  // committed once they cover the whole content. An incomplete entry is
+  // discarded when the writer is destroyed.
+  class Writer {
+   public:
+    ~Writer();
+
+    // Prevent copying.
+    Writer(Writer const&) = delete;
+    Writer& operator=(Writer const&) = delete;
+
+    // Discards the entry if |length| exceeds the size of the cache.
+    void SetContentLength(int64_t length);
+    int64_t GetContentLength() const { return content_length_; }
+    // Discards the entry if |type| is a manifest of an adaptive stream or a
+    // live radio stream.
+    void SetContentType(const std::string& type);
+    // Discards the entry if the content length isn't known or exceeded, or
+    // if the content at offset 0 is a manifest of an adaptive stream, which
+    // may be served without the extension.
+    void Write(int64_t offset, const uint8_t* data, int64_t size);
+    // Whether the entry has been committed or discarded.
+    bool IsClosed() const { return closed_; }
+
+   private:
+    friend class MediaCache;
+    Writer(MediaCache* cache, const std::string& key, int fd);
+
+    bool IsComplete() const;
+    void Discard();
+
+    MediaCache* cache_;
+    const std::string key_;
+    int fd_;
+    int64_t content_length_ = -1;
+    bool closed_ = false;
+    // Written byte ranges. The key is the start and the value is the end.
+    std::map<int64_t, int64_t> ranges_;
+  };
+
+  MediaCache(const std::string& directory, int64_t max_size);
+  ~MediaCache() = default;
+
+  // Prevent copying.
+  MediaCache(MediaCache const&) = delete;
+  MediaCache& operator=(MediaCache const&) = delete;
+
+  static std::string GetDefaultDirectory(const std::string& name);
+
+  // Only http(s) streams are cached. The manifests of adaptive streams
+  // (HLS/DASH) aren't, since the demuxers resolve the URIs of the segments
+  // relative to them and live playlists are updated. Live streams aren't
+  // cached either.
+  static bool IsCacheable(const std::string& uri);
+  static bool IsCacheableType(const std::string& type);
+
+  // Returns nullptr if the entry hasn't been cached yet.
+  std::unique_ptr<Reader> OpenReader(const std::string& uri);
+
+  // Returns nullptr if the entry is already being written.
+  std::unique_ptr<Writer> OpenWriter(const std::string& uri);
+
+  Stats GetStats();
+
+  const std::string& GetDirectory() const { return directory_; }
+
+  // Evicts the least recently used entries if they exceed the new size.
+  void SetMaxSize(int64_t max_size);
+
+ private:
+  struct Entry {
+    int64_t size = 0;
+    uint64_t last_access = 0;
+    int32_t readers = 0;
+  };
+
+  std::string GetKey(const std::string& uri) const;
+  std::string GetPath(const std::string& key) const;
+  void LoadIndex();
+  void ReleaseReader(const std::string& key);
+  void ReleaseWriter(const std::string& key, bool complete, int64_t size);
+  void AddWrittenBytes(int64_t bytes);
+  void AddReadBytes(int64_t bytes);
+  int64_t GetMaxSize();
+  void EvictLocked();
+
+  const std::string directory_;
+  int64_t max_size_;
+  uint64_t access_count_ = 0;
+  Stats stats_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_set<std::string> writing_keys_;
+  std::mutex mutex_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MEDIA_CACHE_H_
@@ -0,0 +1,64 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_CONFIG_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_CONFIG_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class CacheConfigMessage {
+ public:
+  CacheConfigMessage() = default;
+  ~CacheConfigMessage() = default;
+
+  // Prevent copying.
+  CacheConfigMessage(CacheConfigMessage const&) = default;
+  CacheConfigMessage& operator=(CacheConfigMessage const&) = default;
+
+  void SetDirectory(const std::string& directory) { directory_ = directory; }
+
+  std::string GetDirectory() const { return directory_; }
+
+  void SetMaxSize(int64_t max_size) { max_size_ = max_size; }
+
+  int64_t GetMaxSize() const { return max_size_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("directory"),
+         flutter::EncodableValue(directory_)},
+        {flutter::EncodableValue("maxSize"),
+         flutter::EncodableValue(max_size_)}};
+    return flutter::EncodableValue(map);
+  }
+
+  static CacheConfigMessage FromMap(const flutter::EncodableValue& value) {
+    CacheConfigMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& directory =
+          map[flutter::EncodableValue("directory")];
+      if (std::holds_alternative<std::string>(directory)) {
+        message.SetDirectory(std::get<std::string>(directory));
+      }
+
+      flutter::EncodableValue& max_size =
+          map[flutter::EncodableValue("maxSize")];
+      if (std::holds_alternative<int32_t>(max_size) ||
+          std::holds_alternative<int64_t>(max_size)) {
+        message.SetMaxSize(max_size.LongValue());
+      }
+    }
+
+    return message;
+  }
+
+ private:
+  std::string directory_;
+  int64_t max_size_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_CONFIG_MESSAGE_H_
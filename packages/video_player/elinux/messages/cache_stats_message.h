@@ -0,0 +1,74 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_STATS_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_STATS_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class CacheStatsMessage {
+ public:
+  CacheStatsMessage() = default;
+  ~CacheStatsMessage() = default;
+
+  // Prevent copying.
+  CacheStatsMessage(CacheStatsMessage const&) = default;
+  CacheStatsMessage& operator=(CacheStatsMessage const&) = default;
+
+  void SetHitCount(int64_t hit_count) { hit_count_ = hit_count; }
+
+  int64_t GetHitCount() const { return hit_count_; }
+
+  void SetMissCount(int64_t miss_count) { miss_count_ = miss_count; }
+
+  int64_t GetMissCount() const { return miss_count_; }
+
+  void SetReadBytes(int64_t read_bytes) { read_bytes_ = read_bytes; }
+
+  int64_t GetReadBytes() const { return read_bytes_; }
+
+  void SetWrittenBytes(int64_t written_bytes) {
+    written_bytes_ = written_bytes;
+  }
+
+  int64_t GetWrittenBytes() const { return written_bytes_; }
+
+  void SetEvictionCount(int64_t eviction_count) {
+    eviction_count_ = eviction_count;
+  }
+
+  int64_t GetEvictionCount() const { return eviction_count_; }
+
+  void SetTotalSize(int64_t total_size) { total_size_ = total_size; }
+
+  int64_t GetTotalSize() const { return total_size_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("hitCount"),
+         flutter::EncodableValue(hit_count_)},
+        {flutter::EncodableValue("missCount"),
+         flutter::EncodableValue(miss_count_)},
+        {flutter::EncodableValue("readBytes"),
+         flutter::EncodableValue(read_bytes_)},
+        {flutter::EncodableValue("writtenBytes"),
+         flutter::EncodableValue(written_bytes_)},
+        {flutter::EncodableValue("evictionCount"),
+         flutter::EncodableValue(eviction_count_)},
+        {flutter::EncodableValue("totalSize"),
+         flutter::EncodableValue(total_size_)}};
+    return flutter::EncodableValue(map);
+  }
+
+ private:
+  int64_t hit_count_ = 0;
+  int64_t miss_count_ = 0;
+  int64_t read_bytes_ = 0;
+  int64_t written_bytes_ = 0;
+  int64_t eviction_count_ = 0;
+  int64_t total_size_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CACHE_STATS_MESSAGE_H_
@@ -0,0 +1,60 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_LAYOUT_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_LAYOUT_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <vector>
+
+#include "compositor_region_message.h"
+
+class CompositorLayoutMessage {
+ public:
+  CompositorLayoutMessage() = default;
+  ~CompositorLayoutMessage() = default;
+
+  // Prevent copying.
+  CompositorLayoutMessage(CompositorLayoutMessage const&) = default;
+  CompositorLayoutMessage& operator=(CompositorLayoutMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetRegions(const std::vector<CompositorRegionMessage>& regions) {
+    regions_ = regions;
+  }
+
+  const std::vector<CompositorRegionMessage>& GetRegions() const {
+    return regions_;
+  }
+
+  static CompositorLayoutMessage FromMap(const flutter::EncodableValue& value) {
+    CompositorLayoutMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& texture_id =
+          map[flutter::EncodableValue("textureId")];
+      if (std::holds_alternative<int32_t>(texture_id) ||
+          std::holds_alternative<int64_t>(texture_id)) {
+        message.SetTextureId(texture_id.LongValue());
+      }
+
+      message.SetRegions(CompositorRegionMessage::FromList(
+          map[flutter::EncodableValue("regions")]));
+    }
+
+    return message;
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  std::vector<CompositorRegionMessage> regions_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_LAYOUT_MESSAGE_H_
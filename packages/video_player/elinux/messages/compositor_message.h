@@ -0,0 +1,87 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <string>
+#include <vector>
+
+#include "compositor_region_message.h"
+
+class CompositorMessage {
+ public:
+  CompositorMessage() = default;
+  ~CompositorMessage() = default;
+
+  // Prevent copying.
+  CompositorMessage(CompositorMessage const&) = default;
+  CompositorMessage& operator=(CompositorMessage const&) = default;
+
+  void SetUris(const std::vector<std::string>& uris) { uris_ = uris; }
+
+  const std::vector<std::string>& GetUris() const { return uris_; }
+
+  void SetWidth(int64_t width) { width_ = width; }
+
+  int64_t GetWidth() const { return width_; }
+
+  void SetHeight(int64_t height) { height_ = height; }
+
+  int64_t GetHeight() const { return height_; }
+
+  void SetRegions(const std::vector<CompositorRegionMessage>& regions) {
+    regions_ = regions;
+  }
+
+  const std::vector<CompositorRegionMessage>& GetRegions() const {
+    return regions_;
+  }
+
+  static CompositorMessage FromMap(const flutter::EncodableValue& value) {
+    CompositorMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& uris = map[flutter::EncodableValue("uris")];
+      if (std::holds_alternative<flutter::EncodableList>(uris)) {
+        std::vector<std::string> values;
+        for (const auto& uri : std::get<flutter::EncodableList>(uris)) {
+          if (std::holds_alternative<std::string>(uri)) {
+            values.push_back(std::get<std::string>(uri));
+          }
+        }
+        message.SetUris(values);
+      }
+
+      flutter::EncodableValue& width = map[flutter::EncodableValue("width")];
+      if (std::holds_alternative<int32_t>(width) ||
+          std::holds_alternative<int64_t>(width)) {
+        message.SetWidth(width.LongValue());
+      }
+
+      flutter::EncodableValue& height = map[flutter::EncodableValue("height")];
+      if (std::holds_alternative<int32_t>(height) ||
+          std::holds_alternative<int64_t>(height)) {
+        message.SetHeight(height.LongValue());
+      }
+
+      message.SetRegions(CompositorRegionMessage::FromList(
+          map[flutter::EncodableValue("regions")]));
+    }
+
+    return message;
+  }
+
+ private:
+  std::vector<std::string> uris_;
+  int64_t width_ = 0;
+  int64_t height_ = 0;
+  std::vector<CompositorRegionMessage> regions_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_MESSAGE_H_
@@ -0,0 +1,111 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_REGION_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_REGION_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <vector>
+
+class CompositorRegionMessage {
+ public:
+  CompositorRegionMessage() = default;
+  ~CompositorRegionMessage() = default;
+
+  // Prevent copying.
+  CompositorRegionMessage(CompositorRegionMessage const&) = default;
+  CompositorRegionMessage& operator=(CompositorRegionMessage const&) = default;
+
+  void SetSource(int64_t source) { source_ = source; }
+
+  int64_t GetSource() const { return source_; }
+
+  void SetX(int64_t x) { x_ = x; }
+
+  int64_t GetX() const { return x_; }
+
+  void SetY(int64_t y) { y_ = y; }
+
+  int64_t GetY() const { return y_; }
+
+  void SetWidth(int64_t width) { width_ = width; }
+
+  int64_t GetWidth() const { return width_; }
+
+  void SetHeight(int64_t height) { height_ = height; }
+
+  int64_t GetHeight() const { return height_; }
+
+  void SetZOrder(int64_t z_order) { z_order_ = z_order; }
+
+  int64_t GetZOrder() const { return z_order_; }
+
+  static CompositorRegionMessage FromMap(const flutter::EncodableValue& value) {
+    CompositorRegionMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& source = map[flutter::EncodableValue("source")];
+      if (std::holds_alternative<int32_t>(source) ||
+          std::holds_alternative<int64_t>(source)) {
+        message.SetSource(source.LongValue());
+      }
+
+      flutter::EncodableValue& x = map[flutter::EncodableValue("x")];
+      if (std::holds_alternative<int32_t>(x) ||
+          std::holds_alternative<int64_t>(x)) {
+        message.SetX(x.LongValue());
+      }
+
+      flutter::EncodableValue& y = map[flutter::EncodableValue("y")];
+      if (std::holds_alternative<int32_t>(y) ||
+          std::holds_alternative<int64_t>(y)) {
+        message.SetY(y.LongValue());
+      }
+
+      flutter::EncodableValue& width = map[flutter::EncodableValue("width")];
+      if (std::holds_alternative<int32_t>(width) ||
+          std::holds_alternative<int64_t>(width)) {
+        message.SetWidth(width.LongValue());
+      }
+
+      flutter::EncodableValue& height = map[flutter::EncodableValue("height")];
+      if (std::holds_alternative<int32_t>(height) ||
+          std::holds_alternative<int64_t>(height)) {
+        message.SetHeight(height.LongValue());
+      }
+
+      flutter::EncodableValue& z_order = map[flutter::EncodableValue("zOrder")];
+      if (std::holds_alternative<int32_t>(z_order) ||
+          std::holds_alternative<int64_t>(z_order)) {
+        message.SetZOrder(z_order.LongValue());
+      }
+    }
+
+    return message;
+  }
+
+  static std::vector<CompositorRegionMessage> FromList(
+      const flutter::EncodableValue& value) {
+    std::vector<CompositorRegionMessage> regions;
+    if (std::holds_alternative<flutter::EncodableList>(value)) {
+      for (const auto& region : std::get<flutter::EncodableList>(value)) {
+        regions.push_back(FromMap(region));
+      }
+    }
+    return regions;
+  }
+
+ private:
+  int64_t source_ = 0;
+  int64_t x_ = 0;
+  int64_t y_ = 0;
+  int64_t width_ = 0;
+  int64_t height_ = 0;
+  int64_t z_order_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_COMPOSITOR_REGION_MESSAGE_H_
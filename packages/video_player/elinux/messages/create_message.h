@@ -37,6 +37,26 @@ class CreateMessage {
 
   std::string GetFormatHint() const { return format_hint_; }
 
+  void SetShare(bool share) { share_ = share; }
+
+  bool GetShare() const { return share_; }
+
+  void SetVideoOnly(bool video_only) { video_only_ = video_only; }
+
+  bool GetVideoOnly() const { return video_only_; }
+
+  void SetText(bool text) { text_ = text; }
+
+  bool GetText() const { return text_; }
+
+  void SetNativeVideo(bool native_video) { native_video_ = native_video; }
+
+  bool GetNativeVideo() const { return native_video_; }
+
+  void SetNativeAudio(bool native_audio) { native_audio_ = native_audio; }
+
+  bool GetNativeAudio() const { return native_audio_; }
+
   flutter::EncodableValue ToMap() {
     // todo: Add httpHeaders.
     flutter::EncodableMap map = {
@@ -45,7 +65,15 @@ class CreateMessage {
         {flutter::EncodableValue("packageName"),
          flutter::EncodableValue(package_name_)},
         {flutter::EncodableValue("formatHint"),
-         flutter::EncodableValue(format_hint_)}};
+         flutter::EncodableValue(format_hint_)},
+        {flutter::EncodableValue("share"), flutter::EncodableValue(share_)},
+        {flutter::EncodableValue("videoOnly"),
+         flutter::EncodableValue(video_only_)},
+        {flutter::EncodableValue("text"), flutter::EncodableValue(text_)},
+        {flutter::EncodableValue("nativeVideo"),
+         flutter::EncodableValue(native_video_)},
+        {flutter::EncodableValue("nativeAudio"),
+         flutter::EncodableValue(native_audio_)}};
     return flutter::EncodableValue(map);
   }
 
@@ -75,6 +103,34 @@ class CreateMessage {
       if (std::holds_alternative<std::string>(formatHint)) {
         message.SetFormatHint(std::get<std::string>(formatHint));
       }
+
+      flutter::EncodableValue& share = map[flutter::EncodableValue("share")];
+      if (std::holds_alternative<bool>(share)) {
+        message.SetShare(std::get<bool>(share));
+      }
+
+      flutter::EncodableValue& videoOnly =
+          map[flutter::EncodableValue("videoOnly")];
+      if (std::holds_alternative<bool>(videoOnly)) {
+        message.SetVideoOnly(std::get<bool>(videoOnly));
+      }
+
+      flutter::EncodableValue& text = map[flutter::EncodableValue("text")];
+      if (std::holds_alternative<bool>(text)) {
+        message.SetText(std::get<bool>(text));
+      }
+
+      flutter::EncodableValue& nativeVideo =
+          map[flutter::EncodableValue("nativeVideo")];
+      if (std::holds_alternative<bool>(nativeVideo)) {
+        message.SetNativeVideo(std::get<bool>(nativeVideo));
+      }
+
+      flutter::EncodableValue& nativeAudio =
+          map[flutter::EncodableValue("nativeAudio")];
+      if (std::holds_alternative<bool>(nativeAudio)) {
+        message.SetNativeAudio(std::get<bool>(nativeAudio));
+      }
     }
 
     return message;
@@ -85,6 +141,11 @@ class CreateMessage {
   std::string uri_;
   std::string package_name_;
   std::string format_hint_;
+  bool share_ = false;
+  bool video_only_ = false;
+  bool text_ = true;
+  bool native_video_ = false;
+  bool native_audio_ = false;
 };
 
 #endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_CREATE_MESSAGE_H_
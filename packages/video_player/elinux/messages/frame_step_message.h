@@ -0,0 +1,63 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_FRAME_STEP_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_FRAME_STEP_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class FrameStepMessage {
+ public:
+  FrameStepMessage() = default;
+  ~FrameStepMessage() = default;
+
+  // Prevent copying.
+  FrameStepMessage(FrameStepMessage const&) = default;
+  FrameStepMessage& operator=(FrameStepMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetForward(bool forward) { forward_ = forward; }
+
+  bool GetForward() const { return forward_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {{flutter::EncodableValue("textureId"),
+                                  flutter::EncodableValue(texture_id_)},
+                                 {flutter::EncodableValue("forward"),
+                                  flutter::EncodableValue(forward_)}};
+    return flutter::EncodableValue(map);
+  }
+
+  static FrameStepMessage FromMap(const flutter::EncodableValue& value) {
+    FrameStepMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& texture_id =
+          map[flutter::EncodableValue("textureId")];
+      if (std::holds_alternative<int32_t>(texture_id) ||
+          std::holds_alternative<int64_t>(texture_id)) {
+        message.SetTextureId(texture_id.LongValue());
+      }
+
+      flutter::EncodableValue& forward =
+          map[flutter::EncodableValue("forward")];
+      if (std::holds_alternative<bool>(forward)) {
+        message.SetForward(std::get<bool>(forward));
+      }
+    }
+
+    return message;
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  bool forward_ = true;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_FRAME_STEP_MESSAGE_H_
@@ -5,12 +5,27 @@
 #ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_MESSAGES_H_
 #define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_MESSAGES_H_
 
+#include "adaptive_quality_message.h"
+#include "cache_config_message.h"
+#include "cache_stats_message.h"
+#include "compositor_layout_message.h"
+#include "compositor_message.h"
+#include "compositor_region_message.h"
 #include "create_message.h"
+#include "frame_step_message.h"
 #include "looping_message.h"
 #include "mix_with_others_message.h"
+#include "pitch_correction_message.h"
 #include "playback_speed_message.h"
 #include "position_message.h"
+#include "resource_usage_message.h"
+#include "seek_mode_message.h"
+#include "seek_stats_message.h"
+#include "streaming_config_message.h"
+#include "streaming_stats_message.h"
 #include "texture_message.h"
+#include "thumbnail_message.h"
+#include "thumbnail_request_message.h"
 #include "volume_message.h"
 
 #endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_MESSAGES_H_
@@ -0,0 +1,85 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_RESOURCE_USAGE_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_RESOURCE_USAGE_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <string>
+
+class ResourceUsageMessage {
+ public:
+  ResourceUsageMessage() = default;
+  ~ResourceUsageMessage() = default;
+
+  // Prevent copying.
+  ResourceUsageMessage(ResourceUsageMessage const&) = default;
+  ResourceUsageMessage& operator=(ResourceUsageMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetFrameBufferBytes(int64_t frame_buffer_bytes) {
+    frame_buffer_bytes_ = frame_buffer_bytes;
+  }
+
+  int64_t GetFrameBufferBytes() const { return frame_buffer_bytes_; }
+
+  void SetQueuedBytes(int64_t queued_bytes) { queued_bytes_ = queued_bytes; }
+
+  int64_t GetQueuedBytes() const { return queued_bytes_; }
+
+  void SetQueuedBuffers(int64_t queued_buffers) {
+    queued_buffers_ = queued_buffers;
+  }
+
+  int64_t GetQueuedBuffers() const { return queued_buffers_; }
+
+  void SetQueueCount(int64_t queue_count) { queue_count_ = queue_count; }
+
+  int64_t GetQueueCount() const { return queue_count_; }
+
+  void SetStreamingThreadCount(int64_t streaming_thread_count) {
+    streaming_thread_count_ = streaming_thread_count;
+  }
+
+  int64_t GetStreamingThreadCount() const { return streaming_thread_count_; }
+
+  void SetDecoder(const std::string& decoder) { decoder_ = decoder; }
+
+  const std::string& GetDecoder() const { return decoder_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("textureId"),
+         flutter::EncodableValue(texture_id_)},
+        {flutter::EncodableValue("frameBufferBytes"),
+         flutter::EncodableValue(frame_buffer_bytes_)},
+        {flutter::EncodableValue("queuedBytes"),
+         flutter::EncodableValue(queued_bytes_)},
+        {flutter::EncodableValue("queuedBuffers"),
+         flutter::EncodableValue(queued_buffers_)},
+        {flutter::EncodableValue("queueCount"),
+         flutter::EncodableValue(queue_count_)},
+        {flutter::EncodableValue("streamingThreadCount"),
+         flutter::EncodableValue(streaming_thread_count_)},
+        {flutter::EncodableValue("decoder"),
+         flutter::EncodableValue(decoder_)}};
+    return flutter::EncodableValue(map);
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  int64_t frame_buffer_bytes_ = 0;
+  int64_t queued_bytes_ = 0;
+  int64_t queued_buffers_ = 0;
+  int64_t queue_count_ = 0;
+  int64_t streaming_thread_count_ = 0;
+  std::string decoder_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_RESOURCE_USAGE_MESSAGE_H_
@@ -0,0 +1,64 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_MODE_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_MODE_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class SeekModeMessage {
+ public:
+  SeekModeMessage() = default;
+  ~SeekModeMessage() = default;
+
+  // Prevent copying.
+  SeekModeMessage(SeekModeMessage const&) = default;
+  SeekModeMessage& operator=(SeekModeMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetSeekMode(int64_t seek_mode) { seek_mode_ = seek_mode; }
+
+  int64_t GetSeekMode() const { return seek_mode_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {{flutter::EncodableValue("textureId"),
+                                  flutter::EncodableValue(texture_id_)},
+                                 {flutter::EncodableValue("seekMode"),
+                                  flutter::EncodableValue(seek_mode_)}};
+    return flutter::EncodableValue(map);
+  }
+
+  static SeekModeMessage FromMap(const flutter::EncodableValue& value) {
+    SeekModeMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& texture_id =
+          map[flutter::EncodableValue("textureId")];
+      if (std::holds_alternative<int32_t>(texture_id) ||
+          std::holds_alternative<int64_t>(texture_id)) {
+        message.SetTextureId(texture_id.LongValue());
+      }
+
+      flutter::EncodableValue& seek_mode =
+          map[flutter::EncodableValue("seekMode")];
+      if (std::holds_alternative<int32_t>(seek_mode) ||
+          std::holds_alternative<int64_t>(seek_mode)) {
+        message.SetSeekMode(seek_mode.LongValue());
+      }
+    }
+
+    return message;
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  int64_t seek_mode_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_MODE_MESSAGE_H_
@@ -0,0 +1,76 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_STATS_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_STATS_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class SeekStatsMessage {
+ public:
+  SeekStatsMessage() = default;
+  ~SeekStatsMessage() = default;
+
+  // Prevent copying.
+  SeekStatsMessage(SeekStatsMessage const&) = default;
+  SeekStatsMessage& operator=(SeekStatsMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetSeekCount(int64_t seek_count) { seek_count_ = seek_count; }
+
+  int64_t GetSeekCount() const { return seek_count_; }
+
+  void SetCoalescedCount(int64_t coalesced_count) {
+    coalesced_count_ = coalesced_count;
+  }
+
+  int64_t GetCoalescedCount() const { return coalesced_count_; }
+
+  void SetLastDuration(int64_t last_duration) {
+    last_duration_ = last_duration;
+  }
+
+  int64_t GetLastDuration() const { return last_duration_; }
+
+  void SetMaxDuration(int64_t max_duration) { max_duration_ = max_duration; }
+
+  int64_t GetMaxDuration() const { return max_duration_; }
+
+  void SetTotalDuration(int64_t total_duration) {
+    total_duration_ = total_duration;
+  }
+
+  int64_t GetTotalDuration() const { return total_duration_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("textureId"),
+         flutter::EncodableValue(texture_id_)},
+        {flutter::EncodableValue("seekCount"),
+         flutter::EncodableValue(seek_count_)},
+        {flutter::EncodableValue("coalescedCount"),
+         flutter::EncodableValue(coalesced_count_)},
+        {flutter::EncodableValue("lastDuration"),
+         flutter::EncodableValue(last_duration_)},
+        {flutter::EncodableValue("maxDuration"),
+         flutter::EncodableValue(max_duration_)},
+        {flutter::EncodableValue("totalDuration"),
+         flutter::EncodableValue(total_duration_)}};
+    return flutter::EncodableValue(map);
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  int64_t seek_count_ = 0;
+  int64_t coalesced_count_ = 0;
+  int64_t last_duration_ = -1;
+  int64_t max_duration_ = 0;
+  int64_t total_duration_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_SEEK_STATS_MESSAGE_H_
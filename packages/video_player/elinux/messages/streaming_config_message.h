@@ -0,0 +1,111 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_CONFIG_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_CONFIG_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class StreamingConfigMessage {
+ public:
+  StreamingConfigMessage() = default;
+  ~StreamingConfigMessage() = default;
+
+  // Prevent copying.
+  StreamingConfigMessage(StreamingConfigMessage const&) = default;
+  StreamingConfigMessage& operator=(StreamingConfigMessage const&) = default;
+
+  void SetConnectionSpeed(int64_t connection_speed) {
+    connection_speed_ = connection_speed;
+  }
+
+  int64_t GetConnectionSpeed() const { return connection_speed_; }
+
+  void SetMinBitrate(int64_t min_bitrate) { min_bitrate_ = min_bitrate; }
+
+  int64_t GetMinBitrate() const { return min_bitrate_; }
+
+  void SetMaxBitrate(int64_t max_bitrate) { max_bitrate_ = max_bitrate; }
+
+  int64_t GetMaxBitrate() const { return max_bitrate_; }
+
+  void SetBufferDuration(int64_t buffer_duration) {
+    buffer_duration_ = buffer_duration;
+  }
+
+  int64_t GetBufferDuration() const { return buffer_duration_; }
+
+  void SetBufferSize(int64_t buffer_size) { buffer_size_ = buffer_size; }
+
+  int64_t GetBufferSize() const { return buffer_size_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("connectionSpeed"),
+         flutter::EncodableValue(connection_speed_)},
+        {flutter::EncodableValue("minBitrate"),
+         flutter::EncodableValue(min_bitrate_)},
+        {flutter::EncodableValue("maxBitrate"),
+         flutter::EncodableValue(max_bitrate_)},
+        {flutter::EncodableValue("bufferDuration"),
+         flutter::EncodableValue(buffer_duration_)},
+        {flutter::EncodableValue("bufferSize"),
+         flutter::EncodableValue(buffer_size_)}};
+    return flutter::EncodableValue(map);
+  }
+
+  static StreamingConfigMessage FromMap(const flutter::EncodableValue& value) {
+    StreamingConfigMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& connection_speed =
+          map[flutter::EncodableValue("connectionSpeed")];
+      if (std::holds_alternative<int32_t>(connection_speed) ||
+          std::holds_alternative<int64_t>(connection_speed)) {
+        message.SetConnectionSpeed(connection_speed.LongValue());
+      }
+
+      flutter::EncodableValue& min_bitrate =
+          map[flutter::EncodableValue("minBitrate")];
+      if (std::holds_alternative<int32_t>(min_bitrate) ||
+          std::holds_alternative<int64_t>(min_bitrate)) {
+        message.SetMinBitrate(min_bitrate.LongValue());
+      }
+
+      flutter::EncodableValue& max_bitrate =
+          map[flutter::EncodableValue("maxBitrate")];
+      if (std::holds_alternative<int32_t>(max_bitrate) ||
+          std::holds_alternative<int64_t>(max_bitrate)) {
+        message.SetMaxBitrate(max_bitrate.LongValue());
+      }
+
+      flutter::EncodableValue& buffer_duration =
+          map[flutter::EncodableValue("bufferDuration")];
+      if (std::holds_alternative<int32_t>(buffer_duration) ||
+          std::holds_alternative<int64_t>(buffer_duration)) {
+        message.SetBufferDuration(buffer_duration.LongValue());
+      }
+
+      flutter::EncodableValue& buffer_size =
+          map[flutter::EncodableValue("bufferSize")];
+      if (std::holds_alternative<int32_t>(buffer_size) ||
+          std::holds_alternative<int64_t>(buffer_size)) {
+        message.SetBufferSize(buffer_size.LongValue());
+      }
+    }
+
+    return message;
+  }
+
+ private:
+  int64_t connection_speed_ = 0;
+  int64_t min_bitrate_ = 0;
+  int64_t max_bitrate_ = 0;
+  int64_t buffer_duration_ = -1;
+  int64_t buffer_size_ = -1;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_CONFIG_MESSAGE_H_
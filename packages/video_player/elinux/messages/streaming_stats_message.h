@@ -0,0 +1,62 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_STATS_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_STATS_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+class StreamingStatsMessage {
+ public:
+  StreamingStatsMessage() = default;
+  ~StreamingStatsMessage() = default;
+
+  // Prevent copying.
+  StreamingStatsMessage(StreamingStatsMessage const&) = default;
+  StreamingStatsMessage& operator=(StreamingStatsMessage const&) = default;
+
+  void SetTextureId(int64_t texture_id) { texture_id_ = texture_id; }
+
+  int64_t GetTextureId() const { return texture_id_; }
+
+  void SetStartupLatency(int64_t startup_latency) {
+    startup_latency_ = startup_latency;
+  }
+
+  int64_t GetStartupLatency() const { return startup_latency_; }
+
+  void SetRebufferCount(int64_t rebuffer_count) {
+    rebuffer_count_ = rebuffer_count;
+  }
+
+  int64_t GetRebufferCount() const { return rebuffer_count_; }
+
+  void SetRebufferDuration(int64_t rebuffer_duration) {
+    rebuffer_duration_ = rebuffer_duration;
+  }
+
+  int64_t GetRebufferDuration() const { return rebuffer_duration_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("textureId"),
+         flutter::EncodableValue(texture_id_)},
+        {flutter::EncodableValue("startupLatency"),
+         flutter::EncodableValue(startup_latency_)},
+        {flutter::EncodableValue("rebufferCount"),
+         flutter::EncodableValue(rebuffer_count_)},
+        {flutter::EncodableValue("rebufferDuration"),
+         flutter::EncodableValue(rebuffer_duration_)}};
+    return flutter::EncodableValue(map);
+  }
+
+ private:
+  int64_t texture_id_ = 0;
+  int64_t startup_latency_ = -1;
+  int64_t rebuffer_count_ = 0;
+  int64_t rebuffer_duration_ = 0;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_STREAMING_STATS_MESSAGE_H_
@@ -0,0 +1,55 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <vector>
+
+class ThumbnailMessage {
+ public:
+  ThumbnailMessage() = default;
+  ~ThumbnailMessage() = default;
+
+  // Prevent copying.
+  ThumbnailMessage(ThumbnailMessage const&) = default;
+  ThumbnailMessage& operator=(ThumbnailMessage const&) = default;
+
+  void SetPosition(int64_t position) { position_ = position; }
+
+  int64_t GetPosition() const { return position_; }
+
+  void SetWidth(int64_t width) { width_ = width; }
+
+  int64_t GetWidth() const { return width_; }
+
+  void SetHeight(int64_t height) { height_ = height; }
+
+  int64_t GetHeight() const { return height_; }
+
+  void SetData(const std::vector<uint8_t>& data) { data_ = data; }
+
+  const std::vector<uint8_t>& GetData() const { return data_; }
+
+  flutter::EncodableValue ToMap() {
+    flutter::EncodableMap map = {
+        {flutter::EncodableValue("position"),
+         flutter::EncodableValue(position_)},
+        {flutter::EncodableValue("width"), flutter::EncodableValue(width_)},
+        {flutter::EncodableValue("height"), flutter::EncodableValue(height_)},
+        {flutter::EncodableValue("data"), flutter::EncodableValue(data_)}};
+    return flutter::EncodableValue(map);
+  }
+
+ private:
+  int64_t position_ = 0;
+  int64_t width_ = 0;
+  int64_t height_ = 0;
+  std::vector<uint8_t> data_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_MESSAGE_H_
@@ -0,0 +1,110 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_REQUEST_MESSAGE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_REQUEST_MESSAGE_H_
+
+#include <flutter/binary_messenger.h>
+#include <flutter/encodable_value.h>
+
+#include <string>
+#include <vector>
+
+class ThumbnailRequestMessage {
+ public:
+  ThumbnailRequestMessage() = default;
+  ~ThumbnailRequestMessage() = default;
+
+  // Prevent copying.
+  ThumbnailRequestMessage(ThumbnailRequestMessage const&) = default;
+  ThumbnailRequestMessage& operator=(ThumbnailRequestMessage const&) = default;
+
+  void SetAsset(const std::string& asset) { asset_ = asset; }
+
+  const std::string& GetAsset() const { return asset_; }
+
+  void SetUri(const std::string& uri) { uri_ = uri; }
+
+  const std::string& GetUri() const { return uri_; }
+
+  void SetPositions(const std::vector<int64_t>& positions) {
+    positions_ = positions;
+  }
+
+  const std::vector<int64_t>& GetPositions() const { return positions_; }
+
+  void SetWidth(int64_t width) { width_ = width; }
+
+  int64_t GetWidth() const { return width_; }
+
+  void SetHeight(int64_t height) { height_ = height; }
+
+  int64_t GetHeight() const { return height_; }
+
+  void SetFormat(const std::string& format) { format_ = format; }
+
+  const std::string& GetFormat() const { return format_; }
+
+  static ThumbnailRequestMessage FromMap(const flutter::EncodableValue& value) {
+    ThumbnailRequestMessage message;
+    if (std::holds_alternative<flutter::EncodableMap>(value)) {
+      auto map = std::get<flutter::EncodableMap>(value);
+
+      flutter::EncodableValue& asset = map[flutter::EncodableValue("asset")];
+      if (std::holds_alternative<std::string>(asset)) {
+        message.SetAsset(std::get<std::string>(asset));
+      }
+
+      flutter::EncodableValue& uri = map[flutter::EncodableValue("uri")];
+      if (std::holds_alternative<std::string>(uri)) {
+        message.SetUri(std::get<std::string>(uri));
+      }
+
+      flutter::EncodableValue& positions =
+          map[flutter::EncodableValue("positions")];
+      if (std::holds_alternative<flutter::EncodableList>(positions)) {
+        std::vector<int64_t> values;
+        const auto& list = std::get<flutter::EncodableList>(positions);
+        for (const auto& position : list) {
+          if (std::holds_alternative<int32_t>(position) ||
+              std::holds_alternative<int64_t>(position)) {
+            values.push_back(position.LongValue());
+          }
+        }
+        message.SetPositions(values);
+      } else if (std::holds_alternative<std::vector<int64_t>>(positions)) {
+        message.SetPositions(std::get<std::vector<int64_t>>(positions));
+      }
+
+      flutter::EncodableValue& width = map[flutter::EncodableValue("width")];
+      if (std::holds_alternative<int32_t>(width) ||
+          std::holds_alternative<int64_t>(width)) {
+        message.SetWidth(width.LongValue());
+      }
+
+      flutter::EncodableValue& height = map[flutter::EncodableValue("height")];
+      if (std::holds_alternative<int32_t>(height) ||
+          std::holds_alternative<int64_t>(height)) {
+        message.SetHeight(height.LongValue());
+      }
+
+      flutter::EncodableValue& format = map[flutter::EncodableValue("format")];
+      if (std::holds_alternative<std::string>(format)) {
+        message.SetFormat(std::get<std::string>(format));
+      }
+    }
+
+    return message;
+  }
+
+ private:
+  std::string asset_;
+  std::string uri_;
+  std::vector<int64_t> positions_;
+  int64_t width_ = 0;
+  int64_t height_ = 0;
+  std::string format_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_MESSAGES_THUMBNAIL_REQUEST_MESSAGE_H_
@@ -0,0 +1,150 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "thumbnail_service.h"
+
+#include <algorithm>
+#include <utility>
+
+ThumbnailService::ThumbnailService(size_t num_workers, size_t max_cache_size)
+    : num_workers_(std::max<size_t>(num_workers, 1)),
+      max_cache_size_(max_cache_size) {}
+
+ThumbnailService::~ThumbnailService() {
+  std::deque<std::unique_ptr<Job>> jobs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_jobs_);
+    is_stopping_ = true;
+    jobs.swap(jobs_);
+  }
+  cond_jobs_.notify_all();
+  // The queued jobs are replied with the thumbnails found in the cache when
+  // they were requested.
+  for (auto& job : jobs) {
+    job->callback(std::move(job->thumbnails));
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThumbnailService::Extract(const Request& request, Callback callback) {
+  auto job = std::make_unique<Job>();
+  job->request = request;
+  job->callback = std::move(callback);
+
+  // Replies immediately if all the thumbnails are cached.
+  auto all_cached = true;
+  for (const auto position : request.positions) {
+    auto thumbnail = LookupCache(GetCacheKey(request, position));
+    all_cached &= (thumbnail != nullptr);
+    job->thumbnails.push_back(std::move(thumbnail));
+  }
+  if (all_cached) {
+    job->callback(std::move(job->thumbnails));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_jobs_);
+  jobs_.push_back(std::move(job));
+  // Workers are started lazily not to spend threads on apps without
+  // thumbnails.
+  if (workers_.size() < num_workers_) {
+    workers_.emplace_back(&ThumbnailService::WorkerLoop, this);
+  }
+  cond_jobs_.notify_one();
+}
+
+void ThumbnailService::WorkerLoop() {
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_jobs_);
+      cond_jobs_.wait(lock, [this] { return is_stopping_ || !jobs_.empty(); });
+      if (is_stopping_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    Process(*job);
+    job->callback(std::move(job->thumbnails));
+  }
+}
+
+void ThumbnailService::Process(Job& job) {
+  const auto& request = job.request;
+  GstFrameExtractor extractor(request.uri, request.width, request.height);
+  if (!extractor.Open()) {
+    return;
+  }
+
+  // Extracts the missing thumbnails in the timeline order to seek forward.
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < request.positions.size(); i++) {
+    if (!job.thumbnails[i]) {
+      indices.push_back(i);
+    }
+  }
+  std::sort(indices.begin(), indices.end(), [&request](size_t a, size_t b) {
+    return request.positions[a] < request.positions[b];
+  });
+
+  for (const auto i : indices) {
+    const auto position = request.positions[i];
+    auto key = GetCacheKey(request, position);
+    // The same position may be requested twice in a batch.
+    auto thumbnail = LookupCache(key);
+    if (!thumbnail) {
+      auto frame = std::make_shared<Thumbnail>();
+      if (!extractor.ExtractFrame(position, request.format, *frame)) {
+        continue;
+      }
+      thumbnail = frame;
+      InsertCache(key, thumbnail);
+    }
+    job.thumbnails[i] = std::move(thumbnail);
+  }
+}
+
+std::string ThumbnailService::GetCacheKey(const Request& request,
+                                          int64_t position) const {
+  return request.uri + "#" + std::to_string(position) + "@" +
+         std::to_string(request.width) + "x" + std::to_string(request.height) +
+         "." + std::to_string(static_cast<int>(request.format));
+}
+
+std::shared_ptr<const ThumbnailService::Thumbnail>
+ThumbnailService::LookupCache(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_cache_);
+  auto itr = cache_index_.find(key);
+  if (itr == cache_index_.end()) {
+    return nullptr;
+  }
+  cache_.splice(cache_.begin(), cache_, itr->second);
+  return itr->second->second;
+}
+
+void ThumbnailService::InsertCache(const std::string& key,
+                                   std::shared_ptr<const Thumbnail> thumbnail) {
+  const auto size = thumbnail->data.size();
+  if (size > max_cache_size_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_cache_);
+  if (cache_index_.find(key) != cache_index_.end()) {
+    return;
+  }
+  cache_.emplace_front(key, std::move(thumbnail));
+  cache_index_[key] = cache_.begin();
+  cache_size_ += size;
+
+  while (cache_size_ > max_cache_size_) {
+    const auto& lru = cache_.back();
+    cache_size_ -= lru.second->data.size();
+    cache_index_.erase(lru.first);
+    cache_.pop_back();
+  }
+}
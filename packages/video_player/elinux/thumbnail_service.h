@@ -0,0 +1,84 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_THUMBNAIL_SERVICE_H_
+#define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_THUMBNAIL_SERVICE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gst_frame_extractor.h"
+
+// Extracts thumbnails for video timelines on a pool of worker threads. The
+// timestamps of a request are extracted in one pipeline, and the encoded
+// thumbnails are kept in an in-memory LRU cache.
+class ThumbnailService {
+ public:
+  using Thumbnail = GstFrameExtractor::Frame;
+
+  struct Request {
+    std::string uri;
+    // Timestamps in msec.
+    std::vector<int64_t> positions;
+    int32_t width = 0;
+    int32_t height = 0;
+    GstFrameExtractor::ImageFormat format =
+        GstFrameExtractor::ImageFormat::kJpeg;
+  };
+
+  // Called with the thumbnails in the order of the requested positions. The
+  // failed ones are nullptr. It may be called from a worker thread.
+  using Callback =
+      std::function<void(std::vector<std::shared_ptr<const Thumbnail>>)>;
+
+  ThumbnailService(size_t num_workers, size_t max_cache_size);
+  // Calls the callbacks of all the requests, with nullptr for the thumbnails
+  // not extracted yet, and waits for the workers.
+  ~ThumbnailService();
+
+  // Prevent copying.
+  ThumbnailService(ThumbnailService const&) = delete;
+  ThumbnailService& operator=(ThumbnailService const&) = delete;
+
+  void Extract(const Request& request, Callback callback);
+
+ private:
+  struct Job {
+    Request request;
+    std::vector<std::shared_ptr<const Thumbnail>> thumbnails;
+    Callback callback;
+  };
+
+  void WorkerLoop();
+  void Process(Job& job);
+  std::string GetCacheKey(const Request& request, int64_t position) const;
+  std::shared_ptr<const Thumbnail> LookupCache(const std::string& key);
+  void InsertCache(const std::string& key,
+                   std::shared_ptr<const Thumbnail> thumbnail);
+
+  const size_t num_workers_;
+  const size_t max_cache_size_;
+  std::vector<std::thread> workers_;
+  std::deque<std::unique_ptr<Job>> jobs_;
+  bool is_stopping_ = false;
+  std::mutex mutex_jobs_;
+  std::condition_variable cond_jobs_;
+
+  // Most recently used thumbnails are at the front.
+  std::list<std::pair<std::string, std::shared_ptr<const Thumbnail>>> cache_;
+  std::unordered_map<std::string, decltype(cache_)::iterator> cache_index_;
+  size_t cache_size_ = 0;
+  std::mutex mutex_cache_;
+};
+
+#endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_THUMBNAIL_SERVICE_H_
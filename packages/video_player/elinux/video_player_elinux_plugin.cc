@@ -14,10 +14,19 @@
 #include <flutter/standard_method_codec.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "gst_video_compositor.h"
 #include "gst_video_player.h"
 #include "messages/messages.h"
+#include "thumbnail_service.h"
 #include "video_player_stream_handler_impl.h"
 
 namespace {
@@ -41,8 +50,45 @@ constexpr char kVideoPlayerApiChannelPositionName[] =
     "dev.flutter.pigeon.VideoPlayerApi.position";
 constexpr char kVideoPlayerApiChannelSetPlaybackSpeedName[] =
     "dev.flutter.pigeon.VideoPlayerApi.setPlaybackSpeed";
+constexpr char kVideoPlayerApiChannelSetPitchCorrectionName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setPitchCorrection";
+constexpr char kVideoPlayerApiChannelSetAdaptiveQualityName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setAdaptiveQuality";
+constexpr char kVideoPlayerApiChannelStepFrameName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.stepFrame";
 constexpr char kVideoPlayerApiChannelSeekToName[] =
     "dev.flutter.pigeon.VideoPlayerApi.seekTo";
+constexpr char kVideoPlayerApiChannelSetStreamingConfigName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setStreamingConfig";
+constexpr char kVideoPlayerApiChannelStreamingStatsName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.streamingStats";
+constexpr char kVideoPlayerApiChannelSetCacheConfigName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setCacheConfig";
+constexpr char kVideoPlayerApiChannelCacheStatsName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.cacheStats";
+constexpr char kVideoPlayerApiChannelSetSeekModeName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setSeekMode";
+constexpr char kVideoPlayerApiChannelSeekStatsName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.seekStats";
+constexpr char kVideoPlayerApiChannelThumbnailsName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.thumbnails";
+constexpr char kVideoPlayerApiChannelResourceUsageName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.resourceUsage";
+constexpr char kVideoPlayerApiChannelPreloadName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.preload";
+constexpr char kVideoPlayerApiChannelCancelPreloadName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.cancelPreload";
+constexpr char kVideoPlayerApiChannelCreateCompositorName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.createCompositor";
+constexpr char kVideoPlayerApiChannelSetCompositorLayoutName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.setCompositorLayout";
+constexpr char kVideoPlayerApiChannelDisposeCompositorName[] =
+    "dev.flutter.pigeon.VideoPlayerApi.disposeCompositor";
+
+constexpr char kMediaCacheDirectoryName[] = "video_player_elinux";
+
+constexpr size_t kThumbnailWorkerCount = 2;
+constexpr size_t kThumbnailCacheSize = 16 * 1024 * 1024;
 
 constexpr char kVideoPlayerVideoEventsChannelName[] =
     "flutter.io/videoPlayer/videoEvents";
@@ -50,6 +96,44 @@ constexpr char kVideoPlayerVideoEventsChannelName[] =
 constexpr char kEncodableMapkeyResult[] = "result";
 constexpr char kEncodableMapkeyError[] = "error";
 
+ResourceUsageMessage ToResourceUsageMessage(
+    int64_t texture_id, const GstVideoPlayer::ResourceUsage& usage) {
+  ResourceUsageMessage message;
+  message.SetTextureId(texture_id);
+  message.SetFrameBufferBytes(usage.frame_buffer_bytes);
+  message.SetQueuedBytes(usage.queued_bytes);
+  message.SetQueuedBuffers(usage.queued_buffers);
+  message.SetQueueCount(usage.queue_count);
+  message.SetStreamingThreadCount(usage.streaming_thread_count);
+  message.SetDecoder(usage.decoder);
+  return message;
+}
+
+GstVideoPlayer::StreamSelection ToStreamSelection(const CreateMessage& meta) {
+  GstVideoPlayer::StreamSelection selection;
+  selection.video_only = meta.GetVideoOnly();
+  selection.text = meta.GetText();
+  selection.native_video = meta.GetNativeVideo();
+  selection.native_audio = meta.GetNativeAudio();
+  return selection;
+}
+
+std::vector<GstVideoCompositor::Region> ToCompositorLayout(
+    const std::vector<CompositorRegionMessage>& regions) {
+  std::vector<GstVideoCompositor::Region> layout;
+  for (const auto& message : regions) {
+    GstVideoCompositor::Region region;
+    region.source = message.GetSource();
+    region.x = message.GetX();
+    region.y = message.GetY();
+    region.width = message.GetWidth();
+    region.height = message.GetHeight();
+    region.z_order = message.GetZOrder();
+    layout.push_back(region);
+  }
+  return layout;
+}
+
 class VideoPlayerPlugin : public flutter::Plugin {
  public:
   static void RegisterWithRegistrar(flutter::PluginRegistrar* registrar);
@@ -68,6 +152,14 @@ class VideoPlayerPlugin : public flutter::Plugin {
       DisposePlayer(texture_id);
       itr = players_.erase(itr);
     }
+    for (auto itr = compositors_.begin(); itr != compositors_.end();) {
+      auto texture_id = itr->first;
+      DisposeCompositor(texture_id);
+      itr = compositors_.erase(itr);
+    }
+    // Waits for the prerolls in progress.
+    preloads_.clear();
+    detached_preloads_.clear();
 
     GstVideoPlayer::GstLibraryUnload();
   }
@@ -75,7 +167,19 @@ class VideoPlayerPlugin : public flutter::Plugin {
  private:
   struct FlutterVideoPlayer {
     int64_t texture_id;
-    std::unique_ptr<GstVideoPlayer> player;
+    // Texture id of the player which created the decode. The same as
+    // |texture_id| unless the decode is shared.
+    int64_t source_id;
+    // The decode shared by the players created with the share flag for the
+    // same uri, and the branch of it rendered to this texture.
+    std::shared_ptr<GstVideoPlayer> player;
+    GstVideoOutput* output = nullptr;
+    std::string shared_uri;
+    // Whether the decode has been initialized. Only initialized decodes are
+    // shared. Set from the background thread for an adopted preload which is
+    // still prerolling.
+    std::shared_ptr<std::atomic<bool>> is_initialized =
+        std::make_shared<std::atomic<bool>>(false);
     std::unique_ptr<flutter::TextureVariant> texture;
     std::unique_ptr<FlutterDesktopPixelBuffer> buffer;
 #ifdef USE_EGL_IMAGE_DMABUF
@@ -86,6 +190,37 @@ class VideoPlayerPlugin : public flutter::Plugin {
     std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> event_sink;
   };
 
+  // Result of the preroll of a preloaded player, shared with the background
+  // thread running it.
+  struct PrerollState {
+    std::mutex mutex;
+    bool done = false;
+    bool succeeded = false;
+    // Set when the player is adopted before the preroll finishes. Called on
+    // the background thread.
+    std::function<void(bool)> on_done;
+  };
+
+  // A player prerolled in the background before a texture is created for
+  // it. It's adopted by the next player created for the same uri.
+  struct PreloadedPlayer {
+    std::shared_ptr<GstVideoPlayer> player;
+    GstVideoOutput* output = nullptr;
+    // Texture id of the adopting player, or -1 before the adoption.
+    std::shared_ptr<std::atomic<int64_t>> source_id;
+    std::shared_ptr<PrerollState> preroll;
+    std::future<void> task;
+  };
+
+  struct FlutterVideoCompositor {
+    std::unique_ptr<GstVideoCompositor> compositor;
+    std::unique_ptr<flutter::TextureVariant> texture;
+    std::unique_ptr<FlutterDesktopPixelBuffer> buffer;
+#ifdef USE_EGL_IMAGE_DMABUF
+    std::unique_ptr<FlutterDesktopEGLImage> egl_image;
+#endif  // USE_EGL_IMAGE_DMABUF
+  };
+
   void HandleInitializeMethodCall(
       const flutter::EncodableValue& message,
       flutter::MessageReply<flutter::EncodableValue> reply);
@@ -113,18 +248,84 @@ class VideoPlayerPlugin : public flutter::Plugin {
   void HandleSetPlaybackSpeedMethodCall(
       const flutter::EncodableValue& message,
       flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetPitchCorrectionMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetAdaptiveQualityMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleStepFrameMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
   void HandleSeekToMethodCall(
       const flutter::EncodableValue& message,
       flutter::MessageReply<flutter::EncodableValue> reply);
   void HandlePositionMethodCall(
       const flutter::EncodableValue& message,
       flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetStreamingConfigMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleStreamingStatsMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetCacheConfigMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleCacheStatsMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetSeekModeMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSeekStatsMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleThumbnailsMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleResourceUsageMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandlePreloadMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleCancelPreloadMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleCreateCompositorMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleSetCompositorLayoutMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
+  void HandleDisposeCompositorMethodCall(
+      const flutter::EncodableValue& message,
+      flutter::MessageReply<flutter::EncodableValue> reply);
 
   void SendInitializedEventMessage(int64_t texture_id);
   void SendPlayCompletedEventMessage(int64_t texture_id);
   void SendIsPlayingStateUpdate(int64_t texture_id, bool is_playing);
+  void SendBufferingStartEventMessage(int64_t texture_id);
+  void SendBufferingUpdateEventMessage(int64_t texture_id, int32_t percent);
+  void SendBufferingEndEventMessage(int64_t texture_id);
+  void SendQosUpdateEventMessage(int64_t texture_id, uint64_t processed,
+                                 uint64_t dropped, int64_t jitter,
+                                 double proportion);
+
+  std::string GetMediaUri(const CreateMessage& meta);
+  // Notifies the events of a decode to all textures sharing it.
+  std::unique_ptr<VideoPlayerStreamHandler> CreateStreamHandler(
+      std::shared_ptr<std::atomic<int64_t>> source_id);
+  // Texture ids of the players sharing the decode created by |source_id|.
+  std::vector<int64_t> GetSharedTextureIds(int64_t source_id);
+  FlutterVideoPlayer* FindSharedPlayer(const std::string& uri);
+  // Keeps the task of a preload which is adopted or cancelled until it
+  // finishes, without waiting for it on the platform thread.
+  void DetachPreload(std::future<void> task);
 
   void DisposePlayer(int64_t texture_id);
+  void DisposeCompositor(int64_t texture_id);
 
   flutter::EncodableValue WrapError(const std::string& message,
                                     const std::string& code = std::string(),
@@ -135,6 +336,13 @@ class VideoPlayerPlugin : public flutter::Plugin {
   flutter::PluginRegistrar* plugin_registrar_;
   flutter::TextureRegistrar* texture_registrar_;
   std::unordered_map<int64_t, std::unique_ptr<FlutterVideoPlayer>> players_;
+  std::unordered_map<int64_t, std::unique_ptr<FlutterVideoCompositor>>
+      compositors_;
+  std::unordered_map<std::string, std::unique_ptr<PreloadedPlayer>> preloads_;
+  std::vector<std::future<void>> detached_preloads_;
+  GstVideoPlayer::StreamingConfig streaming_config_;
+  std::shared_ptr<MediaCache> media_cache_;
+  std::unique_ptr<ThumbnailService> thumbnail_service_;
 };
 
 // static
@@ -242,6 +450,41 @@ void VideoPlayerPlugin::RegisterWithRegistrar(
         });
   }
 
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(),
+            kVideoPlayerApiChannelSetPitchCorrectionName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetPitchCorrectionMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(),
+            kVideoPlayerApiChannelSetAdaptiveQualityName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetAdaptiveQualityMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelStepFrameName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleStepFrameMethodCall(message, reply);
+        });
+  }
+
   {
     auto channel =
         std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
@@ -264,6 +507,152 @@ void VideoPlayerPlugin::RegisterWithRegistrar(
         });
   }
 
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(),
+            kVideoPlayerApiChannelSetStreamingConfigName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetStreamingConfigMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelStreamingStatsName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleStreamingStatsMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelSetCacheConfigName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetCacheConfigMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelCacheStatsName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleCacheStatsMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelSetSeekModeName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetSeekModeMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelSeekStatsName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSeekStatsMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelThumbnailsName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleThumbnailsMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelResourceUsageName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleResourceUsageMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelPreloadName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandlePreloadMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelCancelPreloadName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleCancelPreloadMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(), kVideoPlayerApiChannelCreateCompositorName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleCreateCompositorMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(),
+            kVideoPlayerApiChannelSetCompositorLayoutName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleSetCompositorLayoutMethodCall(message, reply);
+        });
+  }
+
+  {
+    auto channel =
+        std::make_unique<flutter::BasicMessageChannel<flutter::EncodableValue>>(
+            registrar->messenger(),
+            kVideoPlayerApiChannelDisposeCompositorName,
+            &flutter::StandardMessageCodec::GetInstance());
+    channel->SetMessageHandler(
+        [plugin_pointer = plugin.get()](const auto& message, auto reply) {
+          plugin_pointer->HandleDisposeCompositorMethodCall(message, reply);
+        });
+  }
+
   registrar->AddPlugin(std::move(plugin));
 }
 
@@ -278,6 +667,15 @@ void VideoPlayerPlugin::HandleInitializeMethodCall(
     DisposePlayer(texture_id);
     itr = players_.erase(itr);
   }
+  for (auto itr = compositors_.begin(); itr != compositors_.end();) {
+    auto texture_id = itr->first;
+    DisposeCompositor(texture_id);
+    itr = compositors_.erase(itr);
+  }
+  for (auto& [uri, preloaded] : preloads_) {
+    DetachPreload(std::move(preloaded->task));
+  }
+  preloads_.clear();
 
   flutter::EncodableMap result;
 
@@ -290,14 +688,7 @@ void VideoPlayerPlugin::HandleCreateMethodCall(
     const flutter::EncodableValue& message,
     flutter::MessageReply<flutter::EncodableValue> reply) {
   auto meta = CreateMessage::FromMap(message);
-  std::string uri;
-  if (!meta.GetAsset().empty()) {
-    // todo: gets propery path of the Flutter project.
-    std::string flutter_project_path = GetExecutableDirectory() + "/data/";
-    uri = flutter_project_path + "flutter_assets/" + meta.GetAsset();
-  } else {
-    uri = meta.GetUri();
-  }
+  const auto uri = GetMediaUri(meta);
 
   auto instance = std::make_unique<FlutterVideoPlayer>();
 #ifdef USE_EGL_IMAGE_DMABUF
@@ -307,13 +698,14 @@ void VideoPlayerPlugin::HandleCreateMethodCall(
           [instance = instance.get()](
               size_t width, size_t height, void* egl_display,
               void* egl_context) -> const FlutterDesktopEGLImage* {
-            if (!instance->player) {
+            if (!instance->output) {
               return nullptr;
             }
-            instance->egl_image->width = instance->player->GetWidth();
-            instance->egl_image->height = instance->player->GetHeight();
+            instance->output->SetOutputSize(width, height);
             instance->egl_image->egl_image =
-                instance->player->GetEGLImage(egl_display, egl_context);
+                instance->output->GetEGLImage(egl_display, egl_context);
+            instance->egl_image->width = instance->output->GetFrameWidth();
+            instance->egl_image->height = instance->output->GetFrameHeight();
             return instance->egl_image.get();
           }));
 #else
@@ -322,12 +714,15 @@ void VideoPlayerPlugin::HandleCreateMethodCall(
       std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
           [instance = instance.get()](
               size_t width, size_t height) -> const FlutterDesktopPixelBuffer* {
-            if (!instance->player) {
+            if (!instance->output) {
               return nullptr;
             }
-            instance->buffer->width = instance->player->GetWidth();
-            instance->buffer->height = instance->player->GetHeight();
-            instance->buffer->buffer = instance->player->GetFrameBuffer();
+            // Renders the frames at the size of the texture on the screen
+            // instead of the size of the video.
+            instance->output->SetOutputSize(width, height);
+            instance->buffer->buffer = instance->output->GetFrameBuffer();
+            instance->buffer->width = instance->output->GetFrameWidth();
+            instance->buffer->height = instance->output->GetFrameHeight();
             return instance->buffer.get();
           }));
 #endif  // USE_EGL_IMAGE_DMABUF
@@ -361,32 +756,103 @@ void VideoPlayerPlugin::HandleCreateMethodCall(
     event_channel->SetStreamHandler(std::move(event_channel_handler));
     instance->event_channel = std::move(event_channel);
   }
-  {
-    auto player_handler = std::make_unique<VideoPlayerStreamHandlerImpl>(
-        // OnNotifyInitialized
-        [texture_id, host = this]() {
-          host->SendInitializedEventMessage(texture_id);
-        },
-        // OnNotifyFrameDecoded
-        [texture_id, host = this]() {
-          host->texture_registrar_->MarkTextureFrameAvailable(texture_id);
-        },
-        // OnNotifyCompleted
-        [texture_id, host = this]() {
-          host->SendPlayCompletedEventMessage(texture_id);
-        },
-        [texture_id, host = this](bool is_playing) {
-          host->SendIsPlayingStateUpdate(texture_id, is_playing);
-        });
-    instance->player =
-        std::make_unique<GstVideoPlayer>(uri, std::move(player_handler));
-    players_[texture_id] = std::move(instance);
-  }
+  instance->source_id = texture_id;
 
   flutter::EncodableMap value;
   TextureMessage result;
 
-  bool ok = players_[texture_id]->player->Init();
+  // Attaches the texture to the decode of a shared player for the same uri
+  // as a new output instead of decoding the stream again.
+  auto on_frame_decoded = [texture_id, host = this]() {
+    host->texture_registrar_->MarkTextureFrameAvailable(texture_id);
+  };
+  if (meta.GetShare()) {
+    instance->shared_uri = uri;
+    auto* shared = FindSharedPlayer(uri);
+    if (shared) {
+      instance->output = shared->player->AddOutput(on_frame_decoded);
+      if (instance->output) {
+        instance->player = shared->player;
+        instance->source_id = shared->source_id;
+        instance->is_initialized->store(true);
+        players_[texture_id] = std::move(instance);
+
+        result.SetTextureId(texture_id);
+        value.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                      result.ToMap());
+        reply(flutter::EncodableValue(value));
+        return;
+      }
+    }
+  }
+
+  // Adopts the player preloaded for the uri. If it's still prerolling, the
+  // reply is sent once the preroll finishes instead of waiting for it here.
+  auto preload = preloads_.find(uri);
+  if (preload != preloads_.end()) {
+    auto preloaded = std::move(preload->second);
+    preloads_.erase(preload);
+    DetachPreload(std::move(preloaded->task));
+
+    auto on_adopted = [source_id = preloaded->source_id,
+                       is_initialized = instance->is_initialized, texture_id,
+                       reply, host = this](bool succeeded) {
+      flutter::EncodableMap value;
+      if (succeeded) {
+        // Events of the decode are sent to the texture from now on.
+        source_id->store(texture_id);
+        is_initialized->store(true);
+        // The prerolled frame was taken before the texture was registered.
+        host->texture_registrar_->MarkTextureFrameAvailable(texture_id);
+
+        TextureMessage result;
+        result.SetTextureId(texture_id);
+        value.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                      result.ToMap());
+      } else {
+        auto error_message =
+            "Failed to initialize the player with texture id: " +
+            std::to_string(texture_id);
+        value.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                      flutter::EncodableValue(host->WrapError(error_message)));
+      }
+      reply(flutter::EncodableValue(value));
+    };
+
+    std::unique_lock<std::mutex> lock(preloaded->preroll->mutex);
+    if (!preloaded->preroll->done) {
+      instance->player = preloaded->player;
+      instance->output = preloaded->output;
+      players_[texture_id] = std::move(instance);
+      preloaded->preroll->on_done = std::move(on_adopted);
+      return;
+    }
+    if (preloaded->preroll->succeeded) {
+      lock.unlock();
+      instance->player = preloaded->player;
+      instance->output = preloaded->output;
+      players_[texture_id] = std::move(instance);
+      on_adopted(true);
+      return;
+    }
+    // Creates a new player if the preload has failed.
+  }
+
+  {
+    instance->player = std::make_shared<GstVideoPlayer>(
+        uri,
+        CreateStreamHandler(std::make_shared<std::atomic<int64_t>>(texture_id)),
+        media_cache_);
+    instance->player->SetStreamingConfig(streaming_config_);
+    instance->player->SetStreamSelection(ToStreamSelection(meta));
+    // Added before Init() to take part in the preroll.
+    instance->output = instance->player->AddOutput(on_frame_decoded);
+    players_[texture_id] = std::move(instance);
+  }
+
+  bool ok = players_[texture_id]->output &&
+            players_[texture_id]->player->Init();
+  players_[texture_id]->is_initialized->store(ok);
   if (ok) {
     result.SetTextureId(texture_id);
     value.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
@@ -562,15 +1028,15 @@ void VideoPlayerPlugin::HandleSetPlaybackSpeedMethodCall(
   reply(flutter::EncodableValue(result));
 }
 
-void VideoPlayerPlugin::HandleSeekToMethodCall(
+void VideoPlayerPlugin::HandleSetPitchCorrectionMethodCall(
     const flutter::EncodableValue& message,
     flutter::MessageReply<flutter::EncodableValue> reply) {
-  auto parameter = PositionMessage::FromMap(message);
+  auto parameter = PitchCorrectionMessage::FromMap(message);
   const auto texture_id = parameter.GetTextureId();
   flutter::EncodableMap result;
 
   if (players_.find(texture_id) != players_.end()) {
-    players_[texture_id]->player->SetSeek(parameter.GetPosition());
+    players_[texture_id]->player->SetPitchCorrection(parameter.GetEnabled());
     result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
                    flutter::EncodableValue());
   } else {
@@ -582,22 +1048,519 @@ void VideoPlayerPlugin::HandleSeekToMethodCall(
   reply(flutter::EncodableValue(result));
 }
 
-void VideoPlayerPlugin::SendInitializedEventMessage(int64_t texture_id) {
-  if (players_.find(texture_id) == players_.end() ||
-      !players_[texture_id]->event_sink) {
-    return;
+void VideoPlayerPlugin::HandleSetAdaptiveQualityMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = AdaptiveQualityMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    players_[texture_id]->player->SetAdaptiveQuality(parameter.GetEnabled());
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
   }
+  reply(flutter::EncodableValue(result));
+}
 
-  auto duration = players_[texture_id]->player->GetDuration();
-  auto width = players_[texture_id]->player->GetWidth();
-  auto height = players_[texture_id]->player->GetHeight();
-  flutter::EncodableMap encodables = {
-      {flutter::EncodableValue("event"),
-       flutter::EncodableValue("initialized")},
-      {flutter::EncodableValue("duration"), flutter::EncodableValue(duration)},
-      {flutter::EncodableValue("width"), flutter::EncodableValue(width)},
-      {flutter::EncodableValue("height"), flutter::EncodableValue(height)}};
-  flutter::EncodableValue event(encodables);
+void VideoPlayerPlugin::HandleStepFrameMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = FrameStepMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    players_[texture_id]->player->StepFrame(parameter.GetForward());
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleSeekToMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = PositionMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    players_[texture_id]->player->SetSeek(parameter.GetPosition());
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleSetStreamingConfigMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = StreamingConfigMessage::FromMap(message);
+
+  // The config is applied to the players created after this call.
+  streaming_config_.connection_speed =
+      std::max<int64_t>(parameter.GetConnectionSpeed(), 0);
+  streaming_config_.min_bitrate =
+      std::max<int64_t>(parameter.GetMinBitrate(), 0);
+  streaming_config_.max_bitrate =
+      std::max<int64_t>(parameter.GetMaxBitrate(), 0);
+  streaming_config_.buffer_duration = parameter.GetBufferDuration();
+  streaming_config_.buffer_size = parameter.GetBufferSize();
+
+  flutter::EncodableMap result;
+  result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                 flutter::EncodableValue());
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleStreamingStatsMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = TextureMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    auto stats = players_[texture_id]->player->GetStreamingStats();
+    StreamingStatsMessage send_message;
+    send_message.SetTextureId(texture_id);
+    send_message.SetStartupLatency(stats.startup_latency);
+    send_message.SetRebufferCount(stats.rebuffer_count);
+    send_message.SetRebufferDuration(stats.rebuffer_duration);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   send_message.ToMap());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleSetCacheConfigMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = CacheConfigMessage::FromMap(message);
+
+  // The cache is used by the players created after this call. The players
+  // already created keep using the previous one. The instance is reused for
+  // the same directory, so that its writers and readers stay accounted.
+  if (parameter.GetMaxSize() > 0) {
+    auto directory = parameter.GetDirectory();
+    if (directory.empty()) {
+      directory = MediaCache::GetDefaultDirectory(kMediaCacheDirectoryName);
+    }
+    if (media_cache_ && media_cache_->GetDirectory() == directory) {
+      media_cache_->SetMaxSize(parameter.GetMaxSize());
+    } else {
+      media_cache_ =
+          std::make_shared<MediaCache>(directory, parameter.GetMaxSize());
+    }
+  } else {
+    media_cache_ = nullptr;
+  }
+
+  flutter::EncodableMap result;
+  result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                 flutter::EncodableValue());
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleCacheStatsMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  CacheStatsMessage send_message;
+  if (media_cache_) {
+    auto stats = media_cache_->GetStats();
+    send_message.SetHitCount(stats.hit_count);
+    send_message.SetMissCount(stats.miss_count);
+    send_message.SetReadBytes(stats.read_bytes);
+    send_message.SetWrittenBytes(stats.written_bytes);
+    send_message.SetEvictionCount(stats.eviction_count);
+    send_message.SetTotalSize(stats.total_size);
+  }
+
+  flutter::EncodableMap result;
+  result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                 send_message.ToMap());
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleSetSeekModeMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = SeekModeMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  const auto seek_mode = parameter.GetSeekMode();
+  flutter::EncodableMap result;
+
+  if (seek_mode < static_cast<int64_t>(GstVideoPlayer::SeekMode::kKeyUnit) ||
+      seek_mode > static_cast<int64_t>(GstVideoPlayer::SeekMode::kTrickMode)) {
+    auto error_message = "Unknown seek mode: " + std::to_string(seek_mode);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  } else if (players_.find(texture_id) != players_.end()) {
+    players_[texture_id]->player->SetSeekMode(
+        static_cast<GstVideoPlayer::SeekMode>(seek_mode));
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleSeekStatsMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = TextureMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    auto stats = players_[texture_id]->player->GetSeekStats();
+    SeekStatsMessage send_message;
+    send_message.SetTextureId(texture_id);
+    send_message.SetSeekCount(stats.seek_count);
+    send_message.SetCoalescedCount(stats.coalesced_count);
+    send_message.SetLastDuration(stats.last_duration);
+    send_message.SetMaxDuration(stats.max_duration);
+    send_message.SetTotalDuration(stats.total_duration);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   send_message.ToMap());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleThumbnailsMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto meta = ThumbnailRequestMessage::FromMap(message);
+  ThumbnailService::Request request;
+  if (!meta.GetAsset().empty()) {
+    std::string flutter_project_path = GetExecutableDirectory() + "/data/";
+    request.uri = flutter_project_path + "flutter_assets/" + meta.GetAsset();
+  } else {
+    request.uri = meta.GetUri();
+  }
+  request.positions = meta.GetPositions();
+  request.width = meta.GetWidth();
+  request.height = meta.GetHeight();
+  if (meta.GetFormat() == "png") {
+    request.format = GstFrameExtractor::ImageFormat::kPng;
+  }
+
+  if (request.uri.empty() || request.width < 0 || request.height < 0) {
+    flutter::EncodableMap result;
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(
+                       WrapError("Invalid thumbnail request")));
+    reply(flutter::EncodableValue(result));
+    return;
+  }
+
+  if (!thumbnail_service_) {
+    thumbnail_service_ = std::make_unique<ThumbnailService>(
+        kThumbnailWorkerCount, kThumbnailCacheSize);
+  }
+
+  // The reply may be sent from a worker thread of the service, since
+  // responses to platform messages can be sent from any thread.
+  thumbnail_service_->Extract(
+      request,
+      [reply](std::vector<std::shared_ptr<const ThumbnailService::Thumbnail>>
+                  thumbnails) {
+        flutter::EncodableList list;
+        for (const auto& thumbnail : thumbnails) {
+          if (!thumbnail) {
+            list.push_back(flutter::EncodableValue());
+            continue;
+          }
+          ThumbnailMessage send_message;
+          send_message.SetPosition(thumbnail->position);
+          send_message.SetWidth(thumbnail->width);
+          send_message.SetHeight(thumbnail->height);
+          send_message.SetData(thumbnail->data);
+          list.push_back(send_message.ToMap());
+        }
+        flutter::EncodableMap result;
+        result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                       flutter::EncodableValue(list));
+        reply(flutter::EncodableValue(result));
+      });
+}
+
+void VideoPlayerPlugin::HandleResourceUsageMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = TextureMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (players_.find(texture_id) != players_.end()) {
+    auto usage = players_[texture_id]->player->GetResourceUsage();
+    auto send_message = ToResourceUsageMessage(texture_id, usage);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   send_message.ToMap());
+  } else {
+    auto error_message = "Couldn't find the player with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandlePreloadMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto meta = CreateMessage::FromMap(message);
+  const auto uri = GetMediaUri(meta);
+  flutter::EncodableMap result;
+
+  if (uri.empty() || preloads_.find(uri) != preloads_.end()) {
+    auto error_message = "Invalid or already preloaded uri: " + uri;
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+    reply(flutter::EncodableValue(result));
+    return;
+  }
+
+  auto preloaded = std::make_unique<PreloadedPlayer>();
+  preloaded->source_id = std::make_shared<std::atomic<int64_t>>(-1);
+  preloaded->player = std::make_shared<GstVideoPlayer>(
+      uri, CreateStreamHandler(preloaded->source_id), media_cache_);
+  preloaded->player->SetStreamingConfig(streaming_config_);
+  preloaded->player->SetStreamSelection(ToStreamSelection(meta));
+  preloaded->output = preloaded->player->AddOutput(
+      [source_id = preloaded->source_id, host = this]() {
+        const auto texture_id = source_id->load();
+        if (texture_id >= 0) {
+          host->texture_registrar_->MarkTextureFrameAvailable(texture_id);
+        }
+      });
+  if (!preloaded->output) {
+    auto error_message = "Failed to create a player for " + uri;
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+    reply(flutter::EncodableValue(result));
+    return;
+  }
+
+  // Prerolls on a background thread not to block the platform thread, and
+  // replies with the resources held by the prerolled player.
+  preloaded->preroll = std::make_shared<PrerollState>();
+  preloaded->task = std::async(
+      std::launch::async, [player = preloaded->player,
+                           preroll = preloaded->preroll, reply, uri,
+                           host = this]() {
+        const bool succeeded = player->Init();
+        flutter::EncodableMap result;
+        if (succeeded) {
+          auto send_message =
+              ToResourceUsageMessage(-1, player->GetResourceUsage());
+          result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                         send_message.ToMap());
+        } else {
+          auto error_message = "Failed to preload " + uri;
+          result.emplace(
+              flutter::EncodableValue(kEncodableMapkeyError),
+              flutter::EncodableValue(host->WrapError(error_message)));
+        }
+        reply(flutter::EncodableValue(result));
+
+        std::function<void(bool)> on_done;
+        {
+          std::lock_guard<std::mutex> lock(preroll->mutex);
+          preroll->done = true;
+          preroll->succeeded = succeeded;
+          on_done = std::move(preroll->on_done);
+        }
+        if (on_done) {
+          on_done(succeeded);
+        }
+      });
+  preloads_[uri] = std::move(preloaded);
+}
+
+void VideoPlayerPlugin::HandleCancelPreloadMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto meta = CreateMessage::FromMap(message);
+  flutter::EncodableMap result;
+
+  // The preroll in progress isn't waited for. The player is released once
+  // it finishes.
+  auto preload = preloads_.find(GetMediaUri(meta));
+  if (preload != preloads_.end()) {
+    DetachPreload(std::move(preload->second->task));
+    preloads_.erase(preload);
+  }
+  result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                 flutter::EncodableValue());
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleCreateCompositorMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto meta = CompositorMessage::FromMap(message);
+  flutter::EncodableMap value;
+  if (meta.GetUris().empty() || meta.GetWidth() <= 0 ||
+      meta.GetHeight() <= 0) {
+    value.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                  flutter::EncodableValue(
+                      WrapError("Invalid compositor request")));
+    reply(flutter::EncodableValue(value));
+    return;
+  }
+
+  auto instance = std::make_unique<FlutterVideoCompositor>();
+#ifdef USE_EGL_IMAGE_DMABUF
+  instance->egl_image = std::make_unique<FlutterDesktopEGLImage>();
+  instance->texture =
+      std::make_unique<flutter::TextureVariant>(flutter::EGLImageTexture(
+          [instance = instance.get()](
+              size_t width, size_t height, void* egl_display,
+              void* egl_context) -> const FlutterDesktopEGLImage* {
+            if (!instance->compositor || !instance->compositor->GetOutput()) {
+              return nullptr;
+            }
+            auto* output = instance->compositor->GetOutput();
+            output->SetOutputSize(width, height);
+            instance->egl_image->egl_image =
+                output->GetEGLImage(egl_display, egl_context);
+            instance->egl_image->width = output->GetFrameWidth();
+            instance->egl_image->height = output->GetFrameHeight();
+            return instance->egl_image.get();
+          }));
+#else
+  instance->buffer = std::make_unique<FlutterDesktopPixelBuffer>();
+  instance->texture =
+      std::make_unique<flutter::TextureVariant>(flutter::PixelBufferTexture(
+          [instance = instance.get()](
+              size_t width, size_t height) -> const FlutterDesktopPixelBuffer* {
+            if (!instance->compositor || !instance->compositor->GetOutput()) {
+              return nullptr;
+            }
+            auto* output = instance->compositor->GetOutput();
+            output->SetOutputSize(width, height);
+            instance->buffer->buffer = output->GetFrameBuffer();
+            instance->buffer->width = output->GetFrameWidth();
+            instance->buffer->height = output->GetFrameHeight();
+            return instance->buffer.get();
+          }));
+#endif  // USE_EGL_IMAGE_DMABUF
+  const auto texture_id =
+      texture_registrar_->RegisterTexture(instance->texture.get());
+
+  instance->compositor = std::make_unique<GstVideoCompositor>(
+      meta.GetUris(), meta.GetWidth(), meta.GetHeight(), [texture_id, host = this]() {
+        host->texture_registrar_->MarkTextureFrameAvailable(texture_id);
+      });
+  auto* compositor = instance->compositor.get();
+  compositors_[texture_id] = std::move(instance);
+
+  if (compositor->GetOutput() &&
+      compositor->SetLayout(ToCompositorLayout(meta.GetRegions())) &&
+      compositor->Play()) {
+    TextureMessage result;
+    result.SetTextureId(texture_id);
+    value.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                  result.ToMap());
+  } else {
+    DisposeCompositor(texture_id);
+    compositors_.erase(texture_id);
+    value.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                  flutter::EncodableValue(
+                      WrapError("Failed to create a compositor")));
+  }
+  reply(flutter::EncodableValue(value));
+}
+
+void VideoPlayerPlugin::HandleSetCompositorLayoutMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = CompositorLayoutMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (compositors_.find(texture_id) != compositors_.end() &&
+      compositors_[texture_id]->compositor->SetLayout(
+          ToCompositorLayout(parameter.GetRegions()))) {
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Failed to set the layout of the compositor: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::HandleDisposeCompositorMethodCall(
+    const flutter::EncodableValue& message,
+    flutter::MessageReply<flutter::EncodableValue> reply) {
+  auto parameter = TextureMessage::FromMap(message);
+  const auto texture_id = parameter.GetTextureId();
+  flutter::EncodableMap result;
+
+  if (compositors_.find(texture_id) != compositors_.end()) {
+    DisposeCompositor(texture_id);
+    compositors_.erase(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyResult),
+                   flutter::EncodableValue());
+  } else {
+    auto error_message = "Couldn't find the compositor with texture id: " +
+                         std::to_string(texture_id);
+    result.emplace(flutter::EncodableValue(kEncodableMapkeyError),
+                   flutter::EncodableValue(WrapError(error_message)));
+  }
+  reply(flutter::EncodableValue(result));
+}
+
+void VideoPlayerPlugin::SendInitializedEventMessage(int64_t texture_id) {
+  if (players_.find(texture_id) == players_.end() ||
+      !players_[texture_id]->event_sink) {
+    return;
+  }
+
+  auto duration = players_[texture_id]->player->GetDuration();
+  auto width = players_[texture_id]->player->GetWidth();
+  auto height = players_[texture_id]->player->GetHeight();
+  flutter::EncodableMap encodables = {
+      {flutter::EncodableValue("event"),
+       flutter::EncodableValue("initialized")},
+      {flutter::EncodableValue("duration"), flutter::EncodableValue(duration)},
+      {flutter::EncodableValue("width"), flutter::EncodableValue(width)},
+      {flutter::EncodableValue("height"), flutter::EncodableValue(height)}};
+  flutter::EncodableValue event(encodables);
   players_[texture_id]->event_sink->Success(event);
 }
 
@@ -629,6 +1592,173 @@ void VideoPlayerPlugin::SendIsPlayingStateUpdate(int64_t texture_id,
   players_[texture_id]->event_sink->Success(event);
 }
 
+void VideoPlayerPlugin::SendBufferingStartEventMessage(int64_t texture_id) {
+  if (players_.find(texture_id) == players_.end() ||
+      !players_[texture_id]->event_sink) {
+    return;
+  }
+
+  flutter::EncodableMap encodables = {
+      {flutter::EncodableValue("event"),
+       flutter::EncodableValue("bufferingStart")}};
+  flutter::EncodableValue event(encodables);
+  players_[texture_id]->event_sink->Success(event);
+}
+
+void VideoPlayerPlugin::SendBufferingUpdateEventMessage(int64_t texture_id,
+                                                        int32_t percent) {
+  if (players_.find(texture_id) == players_.end() ||
+      !players_[texture_id]->event_sink) {
+    return;
+  }
+
+  flutter::EncodableList values;
+  for (const auto& range : players_[texture_id]->player->GetBufferedRanges()) {
+    values.push_back(flutter::EncodableValue(
+        flutter::EncodableList{flutter::EncodableValue(range.first),
+                               flutter::EncodableValue(range.second)}));
+  }
+  flutter::EncodableMap encodables = {
+      {flutter::EncodableValue("event"),
+       flutter::EncodableValue("bufferingUpdate")},
+      {flutter::EncodableValue("values"), flutter::EncodableValue(values)},
+      {flutter::EncodableValue("percent"), flutter::EncodableValue(percent)}};
+  flutter::EncodableValue event(encodables);
+  players_[texture_id]->event_sink->Success(event);
+}
+
+void VideoPlayerPlugin::SendBufferingEndEventMessage(int64_t texture_id) {
+  if (players_.find(texture_id) == players_.end() ||
+      !players_[texture_id]->event_sink) {
+    return;
+  }
+
+  flutter::EncodableMap encodables = {
+      {flutter::EncodableValue("event"),
+       flutter::EncodableValue("bufferingEnd")}};
+  flutter::EncodableValue event(encodables);
+  players_[texture_id]->event_sink->Success(event);
+}
+
+void VideoPlayerPlugin::SendQosUpdateEventMessage(int64_t texture_id,
+                                                  uint64_t processed,
+                                                  uint64_t dropped,
+                                                  int64_t jitter,
+                                                  double proportion) {
+  if (players_.find(texture_id) == players_.end() ||
+      !players_[texture_id]->event_sink) {
+    return;
+  }
+
+  flutter::EncodableMap encodables = {
+      {flutter::EncodableValue("event"), flutter::EncodableValue("qosUpdate")},
+      {flutter::EncodableValue("processed"),
+       flutter::EncodableValue(static_cast<int64_t>(processed))},
+      {flutter::EncodableValue("dropped"),
+       flutter::EncodableValue(static_cast<int64_t>(dropped))},
+      {flutter::EncodableValue("jitter"), flutter::EncodableValue(jitter)},
+      {flutter::EncodableValue("proportion"),
+       flutter::EncodableValue(proportion)}};
+  flutter::EncodableValue event(encodables);
+  players_[texture_id]->event_sink->Success(event);
+}
+
+std::string VideoPlayerPlugin::GetMediaUri(const CreateMessage& meta) {
+  if (!meta.GetAsset().empty()) {
+    // todo: gets propery path of the Flutter project.
+    std::string flutter_project_path = GetExecutableDirectory() + "/data/";
+    return flutter_project_path + "flutter_assets/" + meta.GetAsset();
+  }
+  return meta.GetUri();
+}
+
+std::unique_ptr<VideoPlayerStreamHandler>
+VideoPlayerPlugin::CreateStreamHandler(
+    std::shared_ptr<std::atomic<int64_t>> source_id) {
+  return std::make_unique<VideoPlayerStreamHandlerImpl>(
+      // OnNotifyInitialized
+      [source_id, host = this]() {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendInitializedEventMessage(id);
+        }
+      },
+      // OnNotifyCompleted
+      [source_id, host = this]() {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendPlayCompletedEventMessage(id);
+        }
+      },
+      [source_id, host = this](bool is_playing) {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendIsPlayingStateUpdate(id, is_playing);
+        }
+      },
+      // OnNotifyBufferingStart
+      [source_id, host = this]() {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendBufferingStartEventMessage(id);
+        }
+      },
+      // OnNotifyBufferingUpdate
+      [source_id, host = this](int32_t percent) {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendBufferingUpdateEventMessage(id, percent);
+        }
+      },
+      // OnNotifyBufferingEnd
+      [source_id, host = this]() {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendBufferingEndEventMessage(id);
+        }
+      },
+      // OnNotifyQosUpdate
+      [source_id, host = this](uint64_t processed, uint64_t dropped,
+                               int64_t jitter, double proportion) {
+        for (auto id : host->GetSharedTextureIds(source_id->load())) {
+          host->SendQosUpdateEventMessage(id, processed, dropped, jitter,
+                                          proportion);
+        }
+      });
+}
+
+std::vector<int64_t> VideoPlayerPlugin::GetSharedTextureIds(
+    int64_t source_id) {
+  std::vector<int64_t> texture_ids;
+  // Preloaded players aren't shown on any texture yet, and they notify the
+  // initialization from a background thread.
+  if (source_id < 0) {
+    return texture_ids;
+  }
+  for (const auto& [texture_id, player] : players_) {
+    if (player->source_id == source_id) {
+      texture_ids.push_back(texture_id);
+    }
+  }
+  return texture_ids;
+}
+
+VideoPlayerPlugin::FlutterVideoPlayer* VideoPlayerPlugin::FindSharedPlayer(
+    const std::string& uri) {
+  for (const auto& [texture_id, player] : players_) {
+    if (player->is_initialized->load() && player->output &&
+        player->shared_uri == uri) {
+      return player.get();
+    }
+  }
+  return nullptr;
+}
+
+void VideoPlayerPlugin::DetachPreload(std::future<void> task) {
+  detached_preloads_.erase(
+      std::remove_if(detached_preloads_.begin(), detached_preloads_.end(),
+                     [](const std::future<void>& detached) {
+                       return detached.wait_for(std::chrono::seconds(0)) ==
+                              std::future_status::ready;
+                     }),
+      detached_preloads_.end());
+  detached_preloads_.push_back(std::move(task));
+}
+
 void VideoPlayerPlugin::DisposePlayer(int64_t texture_id) {
   if (players_.find(texture_id) != players_.end()) {
     texture_registrar_->UnregisterTexture(texture_id);
@@ -637,12 +1767,27 @@ void VideoPlayerPlugin::DisposePlayer(int64_t texture_id) {
     if (player->event_channel) {
       player->event_channel->SetStreamHandler(nullptr);
     }
+    // The decode is destroyed with the last player sharing it.
+    if (player->output) {
+      player->player->RemoveOutput(player->output);
+      player->output = nullptr;
+    }
     player->player = nullptr;
     player->buffer = nullptr;
     player->texture = nullptr;
   }
 }
 
+void VideoPlayerPlugin::DisposeCompositor(int64_t texture_id) {
+  if (compositors_.find(texture_id) != compositors_.end()) {
+    texture_registrar_->UnregisterTexture(texture_id);
+    auto* compositor = compositors_[texture_id].get();
+    compositor->compositor = nullptr;
+    compositor->buffer = nullptr;
+    compositor->texture = nullptr;
+  }
+}
+
 flutter::EncodableValue VideoPlayerPlugin::WrapError(
     const std::string& message, const std::string& code,
     const std::string& details) {
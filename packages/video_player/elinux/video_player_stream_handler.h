@@ -5,6 +5,8 @@
 #ifndef PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_VIDEO_PLAYER_STREAM_HANDLER_H_
 #define PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_VIDEO_PLAYER_STREAM_HANDLER_H_
 
+#include <cstdint>
+
 class VideoPlayerStreamHandler {
  public:
   VideoPlayerStreamHandler() = default;
@@ -17,20 +19,39 @@ class VideoPlayerStreamHandler {
   // Notifies the completion of initializing the video player.
   void OnNotifyInitialized() { OnNotifyInitializedInternal(); }
 
-  // Notifies the completion of decoding a video frame.
-  void OnNotifyFrameDecoded() { OnNotifyFrameDecodedInternal(); }
-
   // Notifies the completion of playing a video.
   void OnNotifyCompleted() { OnNotifyCompletedInternal(); }
 
   // Notifies update of playing or pausing a video.
   void OnNotifyPlaying(bool is_playing) { OnNotifyPlayingInternal(is_playing); }
 
+  // Notifies the start of buffering a stream.
+  void OnNotifyBufferingStart() { OnNotifyBufferingStartInternal(); }
+
+  // Notifies the progress of buffering a stream in percent.
+  void OnNotifyBufferingUpdate(int32_t percent) {
+    OnNotifyBufferingUpdateInternal(percent);
+  }
+
+  // Notifies the end of buffering a stream.
+  void OnNotifyBufferingEnd() { OnNotifyBufferingEndInternal(); }
+
+  // Notifies the QoS statistics of the video. |jitter| is in usec.
+  void OnNotifyQosUpdate(uint64_t processed, uint64_t dropped, int64_t jitter,
+                         double proportion) {
+    OnNotifyQosUpdateInternal(processed, dropped, jitter, proportion);
+  }
+
  protected:
   virtual void OnNotifyInitializedInternal() = 0;
-  virtual void OnNotifyFrameDecodedInternal() = 0;
   virtual void OnNotifyCompletedInternal() = 0;
   virtual void OnNotifyPlayingInternal(bool is_playing) = 0;
+  virtual void OnNotifyBufferingStartInternal() = 0;
+  virtual void OnNotifyBufferingUpdateInternal(int32_t percent) = 0;
+  virtual void OnNotifyBufferingEndInternal() = 0;
+  virtual void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                         int64_t jitter,
+                                         double proportion) = 0;
 };
 
 #endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_VIDEO_PLAYER_STREAM_HANDLER_H_
@@ -12,18 +12,28 @@
 class VideoPlayerStreamHandlerImpl : public VideoPlayerStreamHandler {
  public:
   using OnNotifyInitialized = std::function<void()>;
-  using OnNotifyFrameDecoded = std::function<void()>;
   using OnNotifyCompleted = std::function<void()>;
   using OnNotifyPlaying = std::function<void(bool)>;
+  using OnNotifyBufferingStart = std::function<void()>;
+  using OnNotifyBufferingUpdate = std::function<void(int32_t)>;
+  using OnNotifyBufferingEnd = std::function<void()>;
+  using OnNotifyQosUpdate =
+      std::function<void(uint64_t, uint64_t, int64_t, double)>;
 
-  VideoPlayerStreamHandlerImpl(OnNotifyInitialized on_notify_initialized,
-                               OnNotifyFrameDecoded on_notify_frame_decoded,
-                               OnNotifyCompleted on_notify_completed,
-                               OnNotifyPlaying on_notify_playing)
+  VideoPlayerStreamHandlerImpl(
+      OnNotifyInitialized on_notify_initialized,
+      OnNotifyCompleted on_notify_completed, OnNotifyPlaying on_notify_playing,
+      OnNotifyBufferingStart on_notify_buffering_start,
+      OnNotifyBufferingUpdate on_notify_buffering_update,
+      OnNotifyBufferingEnd on_notify_buffering_end,
+      OnNotifyQosUpdate on_notify_qos_update)
       : on_notify_initialized_(on_notify_initialized),
-        on_notify_frame_decoded_(on_notify_frame_decoded),
         on_notify_completed_(on_notify_completed),
-        on_notify_playing_(on_notify_playing) {}
+        on_notify_playing_(on_notify_playing),
+        on_notify_buffering_start_(on_notify_buffering_start),
+        on_notify_buffering_update_(on_notify_buffering_update),
+        on_notify_buffering_end_(on_notify_buffering_end),
+        on_notify_qos_update_(on_notify_qos_update) {}
   virtual ~VideoPlayerStreamHandlerImpl() = default;
 
   // Prevent copying.
@@ -39,13 +49,6 @@ class VideoPlayerStreamHandlerImpl : public VideoPlayerStreamHandler {
     }
   }
 
-  // |VideoPlayerStreamHandler|
-  void OnNotifyFrameDecodedInternal() {
-    if (on_notify_frame_decoded_) {
-      on_notify_frame_decoded_();
-    }
-  }
-
   // |VideoPlayerStreamHandler|
   void OnNotifyCompletedInternal() {
     if (on_notify_completed_) {
@@ -59,10 +62,42 @@ class VideoPlayerStreamHandlerImpl : public VideoPlayerStreamHandler {
     }
   }
 
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingStartInternal() {
+    if (on_notify_buffering_start_) {
+      on_notify_buffering_start_();
+    }
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingUpdateInternal(int32_t percent) {
+    if (on_notify_buffering_update_) {
+      on_notify_buffering_update_(percent);
+    }
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingEndInternal() {
+    if (on_notify_buffering_end_) {
+      on_notify_buffering_end_();
+    }
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                 int64_t jitter, double proportion) {
+    if (on_notify_qos_update_) {
+      on_notify_qos_update_(processed, dropped, jitter, proportion);
+    }
+  }
+
   OnNotifyInitialized on_notify_initialized_;
-  OnNotifyFrameDecoded on_notify_frame_decoded_;
   OnNotifyCompleted on_notify_completed_;
   OnNotifyPlaying on_notify_playing_;
+  OnNotifyBufferingStart on_notify_buffering_start_;
+  OnNotifyBufferingUpdate on_notify_buffering_update_;
+  OnNotifyBufferingEnd on_notify_buffering_end_;
+  OnNotifyQosUpdate on_notify_qos_update_;
 };
 
 #endif  // PACKAGES_VIDEO_PLAYER_VIDEO_PLAYER_ELINUX_VIDEO_PLAYER_STREAM_HANDLER_IMPL_H_
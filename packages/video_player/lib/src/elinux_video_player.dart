@@ -4,6 +4,7 @@
 // found in the LICENSE file.
 
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:flutter/services.dart';
 import 'package:flutter/widgets.dart';
@@ -15,12 +16,29 @@ import 'messages.g.dart';
 /// Pigeon-generated [VideoPlayerApi].
 class ELinuxVideoPlayer extends VideoPlayerPlatform {
   final ELinuxVideoPlayerApi _api = ELinuxVideoPlayerApi();
+  final Map<int, StreamController<VideoQosStats>> _qosControllers =
+      <int, StreamController<VideoQosStats>>{};
 
   /// Registers this class as the default instance of [PathProviderPlatform].
   static void registerWith() {
     VideoPlayerPlatform.instance = ELinuxVideoPlayer();
   }
 
+  /// Whether the players created while this is true share one decode with
+  /// the other shared players of the same data source.
+  ///
+  /// Each player still gets its own texture scaled to its size, which suits
+  /// video walls showing one stream on many tiles. The playback controls of
+  /// the shared players act on the common decode, and it's released when the
+  /// last of them is disposed.
+  bool shareDecoding = false;
+
+  /// The streams rendered by the players created while this is set.
+  ///
+  /// Players of silent, caption-less content such as signage loops can skip
+  /// the audio and the subtitles entirely to save CPU.
+  VideoStreamSelection streamSelection = const VideoStreamSelection();
+
   @override
   Future<void> init() {
     return _api.initialize();
@@ -28,42 +46,13 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
 
   @override
   Future<void> dispose(int textureId) {
+    _qosControllers.remove(textureId)?.close();
     return _api.dispose(TextureMessage(textureId: textureId));
   }
 
   @override
   Future<int?> create(DataSource dataSource) async {
-    String? asset;
-    String? packageName;
-    String? uri;
-    String? formatHint;
-    Map<String, String> httpHeaders = <String, String>{};
-    switch (dataSource.sourceType) {
-      case DataSourceType.asset:
-        asset = dataSource.asset;
-        packageName = dataSource.package;
-        break;
-      case DataSourceType.network:
-        uri = dataSource.uri;
-        formatHint = _videoFormatStringMap[dataSource.formatHint];
-        httpHeaders = dataSource.httpHeaders;
-        break;
-      case DataSourceType.file:
-        uri = dataSource.uri;
-        httpHeaders = dataSource.httpHeaders;
-        break;
-      case DataSourceType.contentUri:
-        uri = dataSource.uri;
-        break;
-    }
-    final CreateMessage message = CreateMessage(
-      asset: asset,
-      packageName: packageName,
-      uri: uri,
-      httpHeaders: httpHeaders,
-      formatHint: formatHint,
-    );
-
+    final CreateMessage message = _toCreateMessage(dataSource);
     final TextureMessage response = await _api.create(message);
     return response.textureId;
   }
@@ -86,6 +75,8 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     return _api.pause(TextureMessage(textureId: textureId));
   }
 
+  /// The audio sink and the conversion in front of it are removed while the
+  /// volume is 0.
   @override
   Future<void> setVolume(int textureId, double volume) {
     return _api.setVolume(VolumeMessage(
@@ -94,9 +85,10 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     ));
   }
 
+  /// Negative speeds play the video backward with the audio muted.
   @override
   Future<void> setPlaybackSpeed(int textureId, double speed) {
-    assert(speed > 0);
+    assert(speed != 0);
 
     return _api.setPlaybackSpeed(PlaybackSpeedMessage(
       textureId: textureId,
@@ -104,6 +96,16 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     ));
   }
 
+  /// Sets whether the audio keeps its pitch at the speeds other than 1.0.
+  /// Disabled by default. While enabled, every speed change flushes the
+  /// pipeline instead of changing the rate instantly. If disabled, or if the
+  /// `scaletempo` element isn't available, the audio is muted at speeds below
+  /// 0.5 or above 2.0.
+  Future<void> setPitchCorrection(int textureId, bool enabled) {
+    return _api.setPitchCorrection(
+        PitchCorrectionMessage(textureId: textureId, enabled: enabled));
+  }
+
   @override
   Future<void> seekTo(int textureId, Duration position) {
     return _api.seekTo(PositionMessage(
@@ -112,6 +114,32 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     ));
   }
 
+  /// Sets whether the quality adapts to the CPU load. Late frames are dropped
+  /// before the color conversion and decoders skip frames to catch up, so
+  /// that playback degrades gracefully instead of drifting out of A/V sync.
+  /// Disabled by default.
+  Future<void> setAdaptiveQuality(int textureId, bool enabled) {
+    return _api.setAdaptiveQuality(
+        AdaptiveQualityMessage(textureId: textureId, enabled: enabled));
+  }
+
+  /// The QoS statistics of the video, updated while frames are dropped or
+  /// late. The updates are delivered through the events of [videoEventsFor],
+  /// which `VideoPlayerController` listens to.
+  Stream<VideoQosStats> qosStatsFor(int textureId) {
+    return _qosControllers
+        .putIfAbsent(
+            textureId, () => StreamController<VideoQosStats>.broadcast())
+        .stream;
+  }
+
+  /// Shows the next frame, or the previous frame if [forward] is false,
+  /// while paused. Does nothing while playing.
+  Future<void> stepFrame(int textureId, {bool forward = true}) {
+    return _api.stepFrame(
+        FrameStepMessage(textureId: textureId, forward: forward));
+  }
+
   @override
   Future<Duration> getPosition(int textureId) async {
     final PositionMessage response =
@@ -154,6 +182,14 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
             eventType: VideoEventType.isPlayingStateUpdate,
             isPlaying: map['isPlaying'] as bool,
           );
+        case 'qosUpdate':
+          _qosControllers[textureId]?.add(VideoQosStats(
+            processed: map['processed'] as int,
+            dropped: map['dropped'] as int,
+            jitter: Duration(microseconds: map['jitter'] as int),
+            proportion: map['proportion'] as double,
+          ));
+          return VideoEvent(eventType: VideoEventType.unknown);
         default:
           return VideoEvent(eventType: VideoEventType.unknown);
       }
@@ -171,6 +207,197 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
         .setMixWithOthers(MixWithOthersMessage(mixWithOthers: mixWithOthers));
   }
 
+  /// Sets the tuning parameters for network streams (HLS/DASH/progressive).
+  /// They are applied to the players created after this call.
+  ///
+  /// [connectionSpeed] is a hint of the network speed in kbps, and
+  /// [minBitrate] / [maxBitrate] limit the variant selection in bps.
+  /// [bufferDuration] and [bufferSize] (in bytes) are the buffering targets.
+  Future<void> setStreamingConfig({
+    int? connectionSpeed,
+    int? minBitrate,
+    int? maxBitrate,
+    Duration? bufferDuration,
+    int? bufferSize,
+  }) {
+    return _api.setStreamingConfig(StreamingConfigMessage(
+      connectionSpeed: connectionSpeed,
+      minBitrate: minBitrate,
+      maxBitrate: maxBitrate,
+      bufferDuration: bufferDuration?.inMilliseconds,
+      bufferSize: bufferSize,
+    ));
+  }
+
+  /// Gets the startup and rebuffering latencies of the player.
+  Future<StreamingStats> getStreamingStats(int textureId) async {
+    final StreamingStatsMessage response =
+        await _api.streamingStats(TextureMessage(textureId: textureId));
+    return StreamingStats(
+      startupLatency: response.startupLatency < 0
+          ? null
+          : Duration(milliseconds: response.startupLatency),
+      rebufferCount: response.rebufferCount,
+      rebufferDuration: Duration(milliseconds: response.rebufferDuration),
+    );
+  }
+
+  /// Enables the on-disk cache of http(s) streams for the players created
+  /// after this call. The cache is disabled if [maxSize] (in bytes) is 0.
+  ///
+  /// If [directory] is null, `$XDG_CACHE_HOME/video_player_elinux` is used.
+  Future<void> setCacheConfig({String? directory, required int maxSize}) {
+    return _api.setCacheConfig(
+        CacheConfigMessage(directory: directory, maxSize: maxSize));
+  }
+
+  /// Gets the hit/miss counters of the on-disk cache.
+  Future<MediaCacheStats> getCacheStats() async {
+    final CacheStatsMessage response = await _api.cacheStats();
+    return MediaCacheStats(
+      hitCount: response.hitCount,
+      missCount: response.missCount,
+      readBytes: response.readBytes,
+      writtenBytes: response.writtenBytes,
+      evictionCount: response.evictionCount,
+      totalSize: response.totalSize,
+    );
+  }
+
+  /// Sets the strategy of the seeks requested by [seekTo] for the player.
+  /// [VideoSeekMode.keyUnit] is used by default.
+  Future<void> setSeekMode(int textureId, VideoSeekMode mode) {
+    return _api.setSeekMode(
+        SeekModeMessage(textureId: textureId, seekMode: mode.index));
+  }
+
+  /// Gets the number and the durations of the seeks of the player.
+  Future<SeekStats> getSeekStats(int textureId) async {
+    final SeekStatsMessage response =
+        await _api.seekStats(TextureMessage(textureId: textureId));
+    return SeekStats(
+      seekCount: response.seekCount,
+      coalescedCount: response.coalescedCount,
+      lastDuration: response.lastDuration < 0
+          ? null
+          : Duration(milliseconds: response.lastDuration),
+      maxDuration: Duration(milliseconds: response.maxDuration),
+      totalDuration: Duration(milliseconds: response.totalDuration),
+    );
+  }
+
+  /// Extracts thumbnails of the video at [positions] without creating a
+  /// player. Either [uri] or [asset] must be given.
+  ///
+  /// The nearest key frames are scaled to [width] x [height]. If one of them
+  /// is 0, it's determined by the aspect ratio of the video. The thumbnails
+  /// are returned in the order of [positions], and the ones that couldn't be
+  /// extracted are null.
+  Future<List<VideoThumbnail?>> getThumbnails({
+    String? uri,
+    String? asset,
+    required List<Duration> positions,
+    int width = 0,
+    int height = 0,
+    VideoThumbnailFormat format = VideoThumbnailFormat.jpeg,
+  }) async {
+    final List<ThumbnailMessage?> response =
+        await _api.thumbnails(ThumbnailRequestMessage(
+      asset: asset,
+      uri: uri,
+      positions: positions
+          .map((Duration position) => position.inMilliseconds)
+          .toList(),
+      width: width,
+      height: height,
+      format: format.name,
+    ));
+    return response
+        .map((ThumbnailMessage? thumbnail) => thumbnail == null
+            ? null
+            : VideoThumbnail(
+                position: Duration(milliseconds: thumbnail.position),
+                width: thumbnail.width,
+                height: thumbnail.height,
+                data: thumbnail.data,
+              ))
+        .toList();
+  }
+
+  /// Gets the memory and the threads held by the pipeline of the player.
+  Future<VideoResourceUsage> getResourceUsage(int textureId) async {
+    final ResourceUsageMessage response =
+        await _api.resourceUsage(TextureMessage(textureId: textureId));
+    return VideoResourceUsage(
+      frameBufferBytes: response.frameBufferBytes,
+      queuedBytes: response.queuedBytes,
+      queuedBuffers: response.queuedBuffers,
+      queueCount: response.queueCount,
+      streamingThreadCount: response.streamingThreadCount,
+      decoder: response.decoder.isEmpty ? null : response.decoder,
+    );
+  }
+
+  /// Builds a player for [dataSource] in the background and prerolls it, so
+  /// that the next [create] for the same source starts immediately with its
+  /// first frame on the texture. Returns the resources held by the prerolled
+  /// player, which are kept until the player is created or the preload is
+  /// cancelled.
+  Future<VideoResourceUsage> preload(DataSource dataSource) async {
+    final ResourceUsageMessage response =
+        await _api.preload(_toCreateMessage(dataSource));
+    return VideoResourceUsage(
+      frameBufferBytes: response.frameBufferBytes,
+      queuedBytes: response.queuedBytes,
+      queuedBuffers: response.queuedBuffers,
+      queueCount: response.queueCount,
+      streamingThreadCount: response.streamingThreadCount,
+      decoder: response.decoder.isEmpty ? null : response.decoder,
+    );
+  }
+
+  /// Releases the player preloaded for [dataSource].
+  Future<void> cancelPreload(DataSource dataSource) {
+    return _api.cancelPreload(_toCreateMessage(dataSource));
+  }
+
+  /// Composites the videos of [uris] into frames of [width] x [height] shown
+  /// on one texture, and starts playing them. Returns the texture id, which
+  /// can be shown with [Texture].
+  ///
+  /// The sources are placed by [layout], where [VideoCompositorRegion.source]
+  /// is an index of [uris]. Sources without a region are hidden. The audio of
+  /// the sources isn't played.
+  Future<int> createCompositor({
+    required List<String> uris,
+    required int width,
+    required int height,
+    required List<VideoCompositorRegion> layout,
+  }) async {
+    final TextureMessage response =
+        await _api.createCompositor(CompositorMessage(
+      uris: uris,
+      width: width,
+      height: height,
+      regions: layout.map(_toCompositorRegionMessage).toList(),
+    ));
+    return response.textureId;
+  }
+
+  /// Changes the layout of the compositor without rebuilding its pipeline.
+  Future<void> setCompositorLayout(
+      int textureId, List<VideoCompositorRegion> layout) {
+    return _api.setCompositorLayout(CompositorLayoutMessage(
+      textureId: textureId,
+      regions: layout.map(_toCompositorRegionMessage).toList(),
+    ));
+  }
+
+  /// Stops the compositor and releases its texture.
+  Future<void> disposeCompositor(int textureId) {
+    return _api.disposeCompositor(TextureMessage(textureId: textureId));
+  }
+
   EventChannel _eventChannelFor(int textureId) {
     return EventChannel('flutter.io/videoPlayer/videoEvents$textureId');
   }
@@ -183,6 +410,56 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     VideoFormat.other: 'other',
   };
 
+  CreateMessage _toCreateMessage(DataSource dataSource) {
+    String? asset;
+    String? packageName;
+    String? uri;
+    String? formatHint;
+    Map<String, String> httpHeaders = <String, String>{};
+    switch (dataSource.sourceType) {
+      case DataSourceType.asset:
+        asset = dataSource.asset;
+        packageName = dataSource.package;
+        break;
+      case DataSourceType.network:
+        uri = dataSource.uri;
+        formatHint = _videoFormatStringMap[dataSource.formatHint];
+        httpHeaders = dataSource.httpHeaders;
+        break;
+      case DataSourceType.file:
+        uri = dataSource.uri;
+        httpHeaders = dataSource.httpHeaders;
+        break;
+      case DataSourceType.contentUri:
+        uri = dataSource.uri;
+        break;
+    }
+    return CreateMessage(
+      asset: asset,
+      packageName: packageName,
+      uri: uri,
+      httpHeaders: httpHeaders,
+      formatHint: formatHint,
+      share: shareDecoding,
+      videoOnly: streamSelection.videoOnly,
+      text: streamSelection.text,
+      nativeVideo: streamSelection.nativeVideo,
+      nativeAudio: streamSelection.nativeAudio,
+    );
+  }
+
+  CompositorRegionMessage _toCompositorRegionMessage(
+      VideoCompositorRegion region) {
+    return CompositorRegionMessage(
+      source: region.source,
+      x: region.x,
+      y: region.y,
+      width: region.width,
+      height: region.height,
+      zOrder: region.zOrder,
+    );
+  }
+
   DurationRange _toDurationRange(dynamic value) {
     final List<dynamic> pair = value as List<dynamic>;
     return DurationRange(
@@ -191,3 +468,255 @@ class ELinuxVideoPlayer extends VideoPlayerPlatform {
     );
   }
 }
+
+/// Streams rendered by the players, set to
+/// [ELinuxVideoPlayer.streamSelection].
+class VideoStreamSelection {
+  /// Creates a [VideoStreamSelection].
+  const VideoStreamSelection({
+    this.videoOnly = false,
+    this.text = true,
+    this.nativeVideo = false,
+    this.nativeAudio = false,
+  });
+
+  /// Whether only the video is rendered. The audio streams aren't decoded,
+  /// and [ELinuxVideoPlayer.setVolume] has no effect.
+  final bool videoOnly;
+
+  /// Whether subtitles are rendered over the video.
+  final bool text;
+
+  /// Whether the color conversion and the scaling in front of the video sink
+  /// are skipped when the sink accepts the decoded formats.
+  final bool nativeVideo;
+
+  /// Whether the audio conversion and the resampling in front of the audio
+  /// sink are skipped when the sink accepts the decoded formats.
+  final bool nativeAudio;
+}
+
+/// QoS statistics of the video reported by [ELinuxVideoPlayer.qosStatsFor].
+class VideoQosStats {
+  /// Creates a [VideoQosStats].
+  const VideoQosStats({
+    required this.processed,
+    required this.dropped,
+    required this.jitter,
+    required this.proportion,
+  });
+
+  /// The number of frames passed through the video output.
+  final int processed;
+
+  /// The number of frames dropped by the decoder, the converters and the
+  /// sink for being late.
+  final int dropped;
+
+  /// The lateness of the last frame at the sink. Negative if early.
+  final Duration jitter;
+
+  /// The processing rate requested to the decoder relative to real time.
+  /// Larger than 1.0 while the player can't keep up.
+  final double proportion;
+}
+
+/// Latencies of a playback session reported by
+/// [ELinuxVideoPlayer.getStreamingStats].
+class StreamingStats {
+  /// Creates a [StreamingStats].
+  const StreamingStats({
+    this.startupLatency,
+    required this.rebufferCount,
+    required this.rebufferDuration,
+  });
+
+  /// The time from creating the player to the first decoded frame, or null if
+  /// no frame has been decoded yet.
+  final Duration? startupLatency;
+
+  /// The number of times the playback stalled to refill the buffer.
+  final int rebufferCount;
+
+  /// The total time spent in rebuffering.
+  final Duration rebufferDuration;
+}
+
+/// Counters of the on-disk cache reported by
+/// [ELinuxVideoPlayer.getCacheStats].
+class MediaCacheStats {
+  /// Creates a [MediaCacheStats].
+  const MediaCacheStats({
+    required this.hitCount,
+    required this.missCount,
+    required this.readBytes,
+    required this.writtenBytes,
+    required this.evictionCount,
+    required this.totalSize,
+  });
+
+  /// The number of streams served from the cache.
+  final int hitCount;
+
+  /// The number of streams not found in the cache.
+  final int missCount;
+
+  /// The bytes served from the cache.
+  final int readBytes;
+
+  /// The downloaded bytes stored to the cache.
+  final int writtenBytes;
+
+  /// The number of entries evicted to keep the size limit.
+  final int evictionCount;
+
+  /// The total size of the cached entries in bytes.
+  final int totalSize;
+}
+
+/// Strategies of seeking set by [ELinuxVideoPlayer.setSeekMode].
+enum VideoSeekMode {
+  /// Seeks to the nearest key frame. Fast, but may land far from the target
+  /// on content with long GOPs.
+  keyUnit,
+
+  /// Seeks to the key frame at or before the target.
+  keyUnitSnapBefore,
+
+  /// Seeks to the key frame at or after the target.
+  keyUnitSnapAfter,
+
+  /// Decodes from the previous key frame up to the exact target.
+  accurate,
+
+  /// Decodes only key frames. Suitable for scrubbing. The player returns to
+  /// the normal decoding when the playback is resumed.
+  trickMode,
+}
+
+/// Seek durations reported by [ELinuxVideoPlayer.getSeekStats].
+class SeekStats {
+  /// Creates a [SeekStats].
+  const SeekStats({
+    required this.seekCount,
+    required this.coalescedCount,
+    this.lastDuration,
+    required this.maxDuration,
+    required this.totalDuration,
+  });
+
+  /// The number of completed seeks.
+  final int seekCount;
+
+  /// The number of seeks skipped because a later seek replaced them while
+  /// another seek was in progress.
+  final int coalescedCount;
+
+  /// The time from the request to the completion of the last seek, or null if
+  /// no seek has completed yet.
+  final Duration? lastDuration;
+
+  /// The longest seek duration.
+  final Duration maxDuration;
+
+  /// The sum of the seek durations.
+  final Duration totalDuration;
+}
+
+/// Image formats of [VideoThumbnail].
+enum VideoThumbnailFormat {
+  /// JPEG.
+  jpeg,
+
+  /// PNG.
+  png,
+}
+
+/// An encoded thumbnail returned by [ELinuxVideoPlayer.getThumbnails].
+class VideoThumbnail {
+  /// Creates a [VideoThumbnail].
+  const VideoThumbnail({
+    required this.position,
+    required this.width,
+    required this.height,
+    required this.data,
+  });
+
+  /// The timestamp of the extracted key frame.
+  final Duration position;
+
+  /// The width of the image.
+  final int width;
+
+  /// The height of the image.
+  final int height;
+
+  /// The encoded image, which can be shown with [Image.memory].
+  final Uint8List data;
+}
+
+/// Resources held by a player reported by
+/// [ELinuxVideoPlayer.getResourceUsage].
+class VideoResourceUsage {
+  /// Creates a [VideoResourceUsage].
+  const VideoResourceUsage({
+    required this.frameBufferBytes,
+    required this.queuedBytes,
+    required this.queuedBuffers,
+    required this.queueCount,
+    required this.streamingThreadCount,
+    this.decoder,
+  });
+
+  /// The bytes of the converted frame and the decoded frame referenced by the
+  /// player.
+  final int frameBufferBytes;
+
+  /// The bytes waiting in the queues of the pipeline.
+  final int queuedBytes;
+
+  /// The number of buffers waiting in the queues of the pipeline.
+  final int queuedBuffers;
+
+  /// The number of queues whose levels are accounted.
+  final int queueCount;
+
+  /// The number of running streaming threads of the pipeline.
+  final int streamingThreadCount;
+
+  /// The GStreamer element name of the video decoder, such as `avdec_h264`,
+  /// or null if no decoder has been plugged yet.
+  final String? decoder;
+}
+
+/// Placement of a source of [ELinuxVideoPlayer.createCompositor] in the
+/// composited frame in pixels.
+class VideoCompositorRegion {
+  /// Creates a [VideoCompositorRegion].
+  const VideoCompositorRegion({
+    required this.source,
+    required this.x,
+    required this.y,
+    required this.width,
+    required this.height,
+    this.zOrder = 0,
+  });
+
+  /// The index of the source in the uris of the compositor.
+  final int source;
+
+  /// The left edge of the region.
+  final int x;
+
+  /// The top edge of the region.
+  final int y;
+
+  /// The width the source is scaled to.
+  final int width;
+
+  /// The height the source is scaled to.
+  final int height;
+
+  /// Regions with larger values are drawn on top.
+  final int zOrder;
+}
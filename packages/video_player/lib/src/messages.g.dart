@@ -40,6 +40,11 @@ class CreateMessage {
     this.packageName,
     this.formatHint,
     required this.httpHeaders,
+    this.share = false,
+    this.videoOnly = false,
+    this.text = true,
+    this.nativeVideo = false,
+    this.nativeAudio = false,
   });
 
   String? asset;
@@ -47,6 +52,11 @@ class CreateMessage {
   String? packageName;
   String? formatHint;
   Map<String?, String?> httpHeaders;
+  bool share;
+  bool videoOnly;
+  bool text;
+  bool nativeVideo;
+  bool nativeAudio;
 
   Object encode() {
     final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
@@ -55,6 +65,11 @@ class CreateMessage {
     pigeonMap['packageName'] = packageName;
     pigeonMap['formatHint'] = formatHint;
     pigeonMap['httpHeaders'] = httpHeaders;
+    pigeonMap['share'] = share;
+    pigeonMap['videoOnly'] = videoOnly;
+    pigeonMap['text'] = text;
+    pigeonMap['nativeVideo'] = nativeVideo;
+    pigeonMap['nativeAudio'] = nativeAudio;
     return pigeonMap;
   }
 
@@ -66,6 +81,11 @@ class CreateMessage {
       packageName: pigeonMap['packageName'] as String?,
       formatHint: pigeonMap['formatHint'] as String?,
       httpHeaders: pigeonMap['httpHeaders'] as Map<String?, String?>,
+      share: pigeonMap['share'] as bool? ?? false,
+      videoOnly: pigeonMap['videoOnly'] as bool? ?? false,
+      text: pigeonMap['text'] as bool? ?? true,
+      nativeVideo: pigeonMap['nativeVideo'] as bool? ?? false,
+      nativeAudio: pigeonMap['nativeAudio'] as bool? ?? false,
     );
   }
 }
@@ -145,6 +165,31 @@ class PlaybackSpeedMessage {
   }
 }
 
+class PitchCorrectionMessage {
+  PitchCorrectionMessage({
+    required this.textureId,
+    required this.enabled,
+  });
+
+  int textureId;
+  bool enabled;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['enabled'] = enabled;
+    return pigeonMap;
+  }
+
+  static PitchCorrectionMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return PitchCorrectionMessage(
+      textureId: pigeonMap['textureId'] as int,
+      enabled: pigeonMap['enabled'] as bool,
+    );
+  }
+}
+
 class PositionMessage {
   PositionMessage({
     required this.textureId,
@@ -170,6 +215,56 @@ class PositionMessage {
   }
 }
 
+class FrameStepMessage {
+  FrameStepMessage({
+    required this.textureId,
+    required this.forward,
+  });
+
+  int textureId;
+  bool forward;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['forward'] = forward;
+    return pigeonMap;
+  }
+
+  static FrameStepMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return FrameStepMessage(
+      textureId: pigeonMap['textureId'] as int,
+      forward: pigeonMap['forward'] as bool,
+    );
+  }
+}
+
+class AdaptiveQualityMessage {
+  AdaptiveQualityMessage({
+    required this.textureId,
+    required this.enabled,
+  });
+
+  int textureId;
+  bool enabled;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['enabled'] = enabled;
+    return pigeonMap;
+  }
+
+  static AdaptiveQualityMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return AdaptiveQualityMessage(
+      textureId: pigeonMap['textureId'] as int,
+      enabled: pigeonMap['enabled'] as bool,
+    );
+  }
+}
+
 class MixWithOthersMessage {
   MixWithOthersMessage({
     required this.mixWithOthers,
@@ -191,7 +286,437 @@ class MixWithOthersMessage {
   }
 }
 
+class StreamingConfigMessage {
+  StreamingConfigMessage({
+    this.connectionSpeed,
+    this.minBitrate,
+    this.maxBitrate,
+    this.bufferDuration,
+    this.bufferSize,
+  });
+
+  int? connectionSpeed;
+  int? minBitrate;
+  int? maxBitrate;
+  int? bufferDuration;
+  int? bufferSize;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['connectionSpeed'] = connectionSpeed;
+    pigeonMap['minBitrate'] = minBitrate;
+    pigeonMap['maxBitrate'] = maxBitrate;
+    pigeonMap['bufferDuration'] = bufferDuration;
+    pigeonMap['bufferSize'] = bufferSize;
+    return pigeonMap;
+  }
+
+  static StreamingConfigMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return StreamingConfigMessage(
+      connectionSpeed: pigeonMap['connectionSpeed'] as int?,
+      minBitrate: pigeonMap['minBitrate'] as int?,
+      maxBitrate: pigeonMap['maxBitrate'] as int?,
+      bufferDuration: pigeonMap['bufferDuration'] as int?,
+      bufferSize: pigeonMap['bufferSize'] as int?,
+    );
+  }
+}
+
+class StreamingStatsMessage {
+  StreamingStatsMessage({
+    required this.textureId,
+    required this.startupLatency,
+    required this.rebufferCount,
+    required this.rebufferDuration,
+  });
+
+  int textureId;
+  int startupLatency;
+  int rebufferCount;
+  int rebufferDuration;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['startupLatency'] = startupLatency;
+    pigeonMap['rebufferCount'] = rebufferCount;
+    pigeonMap['rebufferDuration'] = rebufferDuration;
+    return pigeonMap;
+  }
+
+  static StreamingStatsMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return StreamingStatsMessage(
+      textureId: pigeonMap['textureId'] as int,
+      startupLatency: pigeonMap['startupLatency'] as int,
+      rebufferCount: pigeonMap['rebufferCount'] as int,
+      rebufferDuration: pigeonMap['rebufferDuration'] as int,
+    );
+  }
+}
+
+class CacheConfigMessage {
+  CacheConfigMessage({
+    this.directory,
+    required this.maxSize,
+  });
+
+  String? directory;
+  int maxSize;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['directory'] = directory;
+    pigeonMap['maxSize'] = maxSize;
+    return pigeonMap;
+  }
+
+  static CacheConfigMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return CacheConfigMessage(
+      directory: pigeonMap['directory'] as String?,
+      maxSize: pigeonMap['maxSize'] as int,
+    );
+  }
+}
+
+class CacheStatsMessage {
+  CacheStatsMessage({
+    required this.hitCount,
+    required this.missCount,
+    required this.readBytes,
+    required this.writtenBytes,
+    required this.evictionCount,
+    required this.totalSize,
+  });
+
+  int hitCount;
+  int missCount;
+  int readBytes;
+  int writtenBytes;
+  int evictionCount;
+  int totalSize;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['hitCount'] = hitCount;
+    pigeonMap['missCount'] = missCount;
+    pigeonMap['readBytes'] = readBytes;
+    pigeonMap['writtenBytes'] = writtenBytes;
+    pigeonMap['evictionCount'] = evictionCount;
+    pigeonMap['totalSize'] = totalSize;
+    return pigeonMap;
+  }
+
+  static CacheStatsMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return CacheStatsMessage(
+      hitCount: pigeonMap['hitCount'] as int,
+      missCount: pigeonMap['missCount'] as int,
+      readBytes: pigeonMap['readBytes'] as int,
+      writtenBytes: pigeonMap['writtenBytes'] as int,
+      evictionCount: pigeonMap['evictionCount'] as int,
+      totalSize: pigeonMap['totalSize'] as int,
+    );
+  }
+}
+
+class SeekModeMessage {
+  SeekModeMessage({
+    required this.textureId,
+    required this.seekMode,
+  });
+
+  int textureId;
+  int seekMode;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['seekMode'] = seekMode;
+    return pigeonMap;
+  }
+
+  static SeekModeMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return SeekModeMessage(
+      textureId: pigeonMap['textureId'] as int,
+      seekMode: pigeonMap['seekMode'] as int,
+    );
+  }
+}
+
+class SeekStatsMessage {
+  SeekStatsMessage({
+    required this.textureId,
+    required this.seekCount,
+    required this.coalescedCount,
+    required this.lastDuration,
+    required this.maxDuration,
+    required this.totalDuration,
+  });
+
+  int textureId;
+  int seekCount;
+  int coalescedCount;
+  int lastDuration;
+  int maxDuration;
+  int totalDuration;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['seekCount'] = seekCount;
+    pigeonMap['coalescedCount'] = coalescedCount;
+    pigeonMap['lastDuration'] = lastDuration;
+    pigeonMap['maxDuration'] = maxDuration;
+    pigeonMap['totalDuration'] = totalDuration;
+    return pigeonMap;
+  }
+
+  static SeekStatsMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return SeekStatsMessage(
+      textureId: pigeonMap['textureId'] as int,
+      seekCount: pigeonMap['seekCount'] as int,
+      coalescedCount: pigeonMap['coalescedCount'] as int,
+      lastDuration: pigeonMap['lastDuration'] as int,
+      maxDuration: pigeonMap['maxDuration'] as int,
+      totalDuration: pigeonMap['totalDuration'] as int,
+    );
+  }
+}
+
+class ThumbnailRequestMessage {
+  ThumbnailRequestMessage({
+    this.asset,
+    this.uri,
+    required this.positions,
+    required this.width,
+    required this.height,
+    required this.format,
+  });
+
+  String? asset;
+  String? uri;
+  List<int?> positions;
+  int width;
+  int height;
+  String format;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['asset'] = asset;
+    pigeonMap['uri'] = uri;
+    pigeonMap['positions'] = positions;
+    pigeonMap['width'] = width;
+    pigeonMap['height'] = height;
+    pigeonMap['format'] = format;
+    return pigeonMap;
+  }
+
+  static ThumbnailRequestMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return ThumbnailRequestMessage(
+      asset: pigeonMap['asset'] as String?,
+      uri: pigeonMap['uri'] as String?,
+      positions: (pigeonMap['positions'] as List<Object?>?)!.cast<int?>(),
+      width: pigeonMap['width'] as int,
+      height: pigeonMap['height'] as int,
+      format: pigeonMap['format'] as String,
+    );
+  }
+}
+
+class ThumbnailMessage {
+  ThumbnailMessage({
+    required this.position,
+    required this.width,
+    required this.height,
+    required this.data,
+  });
+
+  int position;
+  int width;
+  int height;
+  Uint8List data;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['position'] = position;
+    pigeonMap['width'] = width;
+    pigeonMap['height'] = height;
+    pigeonMap['data'] = data;
+    return pigeonMap;
+  }
+
+  static ThumbnailMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return ThumbnailMessage(
+      position: pigeonMap['position'] as int,
+      width: pigeonMap['width'] as int,
+      height: pigeonMap['height'] as int,
+      data: pigeonMap['data'] as Uint8List,
+    );
+  }
+}
+
+class ResourceUsageMessage {
+  ResourceUsageMessage({
+    required this.textureId,
+    required this.frameBufferBytes,
+    required this.queuedBytes,
+    required this.queuedBuffers,
+    required this.queueCount,
+    required this.streamingThreadCount,
+    required this.decoder,
+  });
+
+  int textureId;
+  int frameBufferBytes;
+  int queuedBytes;
+  int queuedBuffers;
+  int queueCount;
+  int streamingThreadCount;
+  String decoder;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['frameBufferBytes'] = frameBufferBytes;
+    pigeonMap['queuedBytes'] = queuedBytes;
+    pigeonMap['queuedBuffers'] = queuedBuffers;
+    pigeonMap['queueCount'] = queueCount;
+    pigeonMap['streamingThreadCount'] = streamingThreadCount;
+    pigeonMap['decoder'] = decoder;
+    return pigeonMap;
+  }
+
+  static ResourceUsageMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return ResourceUsageMessage(
+      textureId: pigeonMap['textureId'] as int,
+      frameBufferBytes: pigeonMap['frameBufferBytes'] as int,
+      queuedBytes: pigeonMap['queuedBytes'] as int,
+      queuedBuffers: pigeonMap['queuedBuffers'] as int,
+      queueCount: pigeonMap['queueCount'] as int,
+      streamingThreadCount: pigeonMap['streamingThreadCount'] as int,
+      decoder: pigeonMap['decoder'] as String,
+    );
+  }
+}
+
 /// [VideoPlayerApi] in 
+class CompositorRegionMessage {
+  CompositorRegionMessage({
+    required this.source,
+    required this.x,
+    required this.y,
+    required this.width,
+    required this.height,
+    required this.zOrder,
+  });
+
+  int source;
+  int x;
+  int y;
+  int width;
+  int height;
+  int zOrder;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['source'] = source;
+    pigeonMap['x'] = x;
+    pigeonMap['y'] = y;
+    pigeonMap['width'] = width;
+    pigeonMap['height'] = height;
+    pigeonMap['zOrder'] = zOrder;
+    return pigeonMap;
+  }
+
+  static CompositorRegionMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return CompositorRegionMessage(
+      source: pigeonMap['source'] as int,
+      x: pigeonMap['x'] as int,
+      y: pigeonMap['y'] as int,
+      width: pigeonMap['width'] as int,
+      height: pigeonMap['height'] as int,
+      zOrder: pigeonMap['zOrder'] as int,
+    );
+  }
+}
+
+class CompositorMessage {
+  CompositorMessage({
+    required this.uris,
+    required this.width,
+    required this.height,
+    required this.regions,
+  });
+
+  List<String?> uris;
+  int width;
+  int height;
+  List<CompositorRegionMessage?> regions;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['uris'] = uris;
+    pigeonMap['width'] = width;
+    pigeonMap['height'] = height;
+    pigeonMap['regions'] = regions
+        .map((CompositorRegionMessage? region) => region?.encode())
+        .toList();
+    return pigeonMap;
+  }
+
+  static CompositorMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return CompositorMessage(
+      uris: (pigeonMap['uris'] as List<Object?>?)!.cast<String?>(),
+      width: pigeonMap['width'] as int,
+      height: pigeonMap['height'] as int,
+      regions: (pigeonMap['regions'] as List<Object?>?)!
+          .map((Object? region) =>
+              region == null ? null : CompositorRegionMessage.decode(region))
+          .toList(),
+    );
+  }
+}
+
+class CompositorLayoutMessage {
+  CompositorLayoutMessage({
+    required this.textureId,
+    required this.regions,
+  });
+
+  int textureId;
+  List<CompositorRegionMessage?> regions;
+
+  Object encode() {
+    final Map<Object?, Object?> pigeonMap = <Object?, Object?>{};
+    pigeonMap['textureId'] = textureId;
+    pigeonMap['regions'] = regions
+        .map((CompositorRegionMessage? region) => region?.encode())
+        .toList();
+    return pigeonMap;
+  }
+
+  static CompositorLayoutMessage decode(Object message) {
+    final Map<Object?, Object?> pigeonMap = message as Map<Object?, Object?>;
+    return CompositorLayoutMessage(
+      textureId: pigeonMap['textureId'] as int,
+      regions: (pigeonMap['regions'] as List<Object?>?)!
+          .map((Object? region) =>
+              region == null ? null : CompositorRegionMessage.decode(region))
+          .toList(),
+    );
+  }
+}
+
 class ELinuxVideoPlayerApi {
   Future<void> initialize() async {
     const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
@@ -317,10 +842,10 @@ class ELinuxVideoPlayerApi {
     }
   }
 
-  Future<void> setPlaybackSpeed(PlaybackSpeedMessage arg) async {
+  Future<void> setPitchCorrection(PitchCorrectionMessage arg) async {
     final Object encoded = arg.encode();
     const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
-        'dev.flutter.pigeon.VideoPlayerApi.setPlaybackSpeed',
+        'dev.flutter.pigeon.VideoPlayerApi.setPitchCorrection',
         StandardMessageCodec());
     final Map<Object?, Object?>? replyMap =
         await channel.send(encoded) as Map<Object?, Object?>?;
@@ -343,10 +868,11 @@ class ELinuxVideoPlayerApi {
     }
   }
 
-  Future<void> play(TextureMessage arg) async {
+  Future<void> setPlaybackSpeed(PlaybackSpeedMessage arg) async {
     final Object encoded = arg.encode();
     const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
-        'dev.flutter.pigeon.VideoPlayerApi.play', StandardMessageCodec());
+        'dev.flutter.pigeon.VideoPlayerApi.setPlaybackSpeed',
+        StandardMessageCodec());
     final Map<Object?, Object?>? replyMap =
         await channel.send(encoded) as Map<Object?, Object?>?;
     if (replyMap == null) {
@@ -368,10 +894,10 @@ class ELinuxVideoPlayerApi {
     }
   }
 
-  Future<PositionMessage> position(TextureMessage arg) async {
+  Future<void> play(TextureMessage arg) async {
     final Object encoded = arg.encode();
     const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
-        'dev.flutter.pigeon.VideoPlayerApi.position', StandardMessageCodec());
+        'dev.flutter.pigeon.VideoPlayerApi.play', StandardMessageCodec());
     final Map<Object?, Object?>? replyMap =
         await channel.send(encoded) as Map<Object?, Object?>?;
     if (replyMap == null) {
@@ -389,14 +915,90 @@ class ELinuxVideoPlayerApi {
         details: error['details'],
       );
     } else {
-      return PositionMessage.decode(replyMap['result']!);
+      // noop
     }
   }
 
-  Future<void> seekTo(PositionMessage arg) async {
+  Future<PositionMessage> position(TextureMessage arg) async {
     final Object encoded = arg.encode();
     const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
-        'dev.flutter.pigeon.VideoPlayerApi.seekTo', StandardMessageCodec());
+        'dev.flutter.pigeon.VideoPlayerApi.position', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return PositionMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<void> seekTo(PositionMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.seekTo', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<void> stepFrame(FrameStepMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.stepFrame', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<void> setAdaptiveQuality(AdaptiveQualityMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.setAdaptiveQuality',
+        StandardMessageCodec());
     final Map<Object?, Object?>? replyMap =
         await channel.send(encoded) as Map<Object?, Object?>?;
     if (replyMap == null) {
@@ -468,4 +1070,343 @@ class ELinuxVideoPlayerApi {
       // noop
     }
   }
+
+  Future<void> setStreamingConfig(StreamingConfigMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.setStreamingConfig',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<StreamingStatsMessage> streamingStats(TextureMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.streamingStats',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return StreamingStatsMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<void> setCacheConfig(CacheConfigMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.setCacheConfig',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<CacheStatsMessage> cacheStats() async {
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.cacheStats', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(null) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return CacheStatsMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<void> setSeekMode(SeekModeMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.setSeekMode',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<SeekStatsMessage> seekStats(TextureMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.seekStats', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return SeekStatsMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<List<ThumbnailMessage?>> thumbnails(
+      ThumbnailRequestMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.thumbnails', StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return (replyMap['result'] as List<Object?>)
+          .map((Object? thumbnail) => thumbnail == null
+              ? null
+              : ThumbnailMessage.decode(thumbnail))
+          .toList();
+    }
+  }
+
+  Future<ResourceUsageMessage> resourceUsage(TextureMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.resourceUsage',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return ResourceUsageMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<ResourceUsageMessage> preload(CreateMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.preload',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return ResourceUsageMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<void> cancelPreload(CreateMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.cancelPreload',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<TextureMessage> createCompositor(CompositorMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.createCompositor',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      return TextureMessage.decode(replyMap['result']!);
+    }
+  }
+
+  Future<void> setCompositorLayout(CompositorLayoutMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.setCompositorLayout',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
+
+  Future<void> disposeCompositor(TextureMessage arg) async {
+    final Object encoded = arg.encode();
+    const BasicMessageChannel<Object?> channel = BasicMessageChannel<Object?>(
+        'dev.flutter.pigeon.VideoPlayerApi.disposeCompositor',
+        StandardMessageCodec());
+    final Map<Object?, Object?>? replyMap =
+        await channel.send(encoded) as Map<Object?, Object?>?;
+    if (replyMap == null) {
+      throw PlatformException(
+        code: 'channel-error',
+        message: 'Unable to establish connection on channel.',
+        details: null,
+      );
+    } else if (replyMap['error'] != null) {
+      final Map<Object?, Object?> error =
+          replyMap['error'] as Map<Object?, Object?>;
+      throw PlatformException(
+        code: error['code'] as String,
+        message: error['message'] as String?,
+        details: error['details'],
+      );
+    } else {
+      // noop
+    }
+  }
 }
@@ -0,0 +1,444 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Checks the streaming config and the buffering events of the video player
+// against a local HLS ladder. A ladder of three variants (240p at 400 kbps,
+// 480p at 1200 kbps and 720p at 2500 kbps) is generated once with x264enc
+// and hlssink2, and served by an HTTP server in this process whose total
+// bandwidth is throttled. The master playlist is played by GstVideoPlayer
+// with the max bitrate in its streaming config, and the buffering events
+// notified to its stream handler are printed. The events are dispatched
+// while the position is polled, as the plugin does. The variants of the
+// requested segments are reported to check the bitrate cap.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o hls_ladder_check hls_ladder_check.cc
+//       ../elinux/gst_video_player.cc ../elinux/gst_video_output.cc
+//       ../elinux/media_cache.cc
+//       $(pkg-config --cflags --libs gstreamer-1.0 gstreamer-app-1.0
+//         gstreamer-video-1.0) -lpthread
+//   (in one line)
+//   $ ./hls_ladder_check <ladder dir> [max bitrate in bps] [bandwidth in kbps]
+//
+// The ladder is generated in the directory if it doesn't have master.m3u8.
+// By default, the max bitrate (1500000) excludes the 720p variant and the
+// bandwidth (1000 kbps) is below the 480p variant, so that the playback
+// rebuffers. 0 means no limit.
+
+#include <arpa/inet.h>
+#include <gst/gst.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gst_video_player.h"
+#include "video_player_stream_handler.h"
+
+namespace {
+constexpr uint32_t kDefaultMaxBitrate = 1500000;
+constexpr int kDefaultBandwidth = 1000;
+constexpr int kLadderDurationSec = 60;
+constexpr int kSegmentDurationSec = 2;
+constexpr int kFrameRate = 30;
+constexpr auto kPlayDuration = std::chrono::seconds(40);
+constexpr auto kPositionPollInterval = std::chrono::milliseconds(100);
+constexpr size_t kSendChunkSize = 4096;
+
+struct Variant {
+  const char* name;
+  int width;
+  int height;
+  int bitrate;  // kbps
+};
+
+constexpr Variant kVariants[] = {
+    {"240p", 426, 240, 400},
+    {"480p", 854, 480, 1200},
+    {"720p", 1280, 720, 2500},
+};
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedSec(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+bool GenerateVariant(const std::string& dir, const Variant& variant) {
+  auto* description = g_strdup_printf(
+      "videotestsrc num-buffers=%d pattern=ball ! "
+      "video/x-raw,width=%d,height=%d,framerate=%d/1 ! "
+      "x264enc bitrate=%d key-int-max=%d speed-preset=ultrafast ! h264parse ! "
+      "hlssink2 target-duration=%d playlist-length=0 max-files=0 "
+      "location=%s/%s_%%05d.ts playlist-location=%s/%s.m3u8",
+      kLadderDurationSec * kFrameRate, variant.width, variant.height,
+      kFrameRate, variant.bitrate, kSegmentDurationSec * kFrameRate,
+      kSegmentDurationSec, dir.c_str(), variant.name, dir.c_str(),
+      variant.name);
+  GError* error = NULL;
+  auto* pipeline = gst_parse_launch(description, &error);
+  g_free(description);
+  if (!pipeline) {
+    fprintf(stderr, "Failed to create the %s pipeline: %s\n", variant.name,
+            error ? error->message : "unknown error");
+    g_clear_error(&error);
+    return false;
+  }
+
+  gst_element_set_state(pipeline, GST_STATE_PLAYING);
+  auto* bus = gst_element_get_bus(pipeline);
+  auto* message = gst_bus_timed_pop_filtered(
+      bus, GST_CLOCK_TIME_NONE,
+      static_cast<GstMessageType>(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  const bool result = GST_MESSAGE_TYPE(message) == GST_MESSAGE_EOS;
+  if (!result) {
+    fprintf(stderr, "Failed to encode the %s variant\n", variant.name);
+  }
+  gst_message_unref(message);
+  gst_object_unref(bus);
+  gst_element_set_state(pipeline, GST_STATE_NULL);
+  gst_object_unref(pipeline);
+  return result;
+}
+
+bool GenerateLadder(const std::string& dir) {
+  const auto master_path = dir + "/master.m3u8";
+  if (access(master_path.c_str(), R_OK) == 0) {
+    return true;
+  }
+  mkdir(dir.c_str(), 0755);
+
+  std::ostringstream master;
+  master << "#EXTM3U\n";
+  for (const auto& variant : kVariants) {
+    printf("Generating the %s variant...\n", variant.name);
+    if (!GenerateVariant(dir, variant)) {
+      return false;
+    }
+    master << "#EXT-X-STREAM-INF:BANDWIDTH=" << variant.bitrate * 1000
+           << ",RESOLUTION=" << variant.width << "x" << variant.height << "\n"
+           << variant.name << ".m3u8\n";
+  }
+  std::ofstream file(master_path);
+  file << master.str();
+  return file.good();
+}
+
+// Serves the files of the ladder over HTTP/1.0. The bandwidth is shared by
+// all the connections, like a slow network link.
+class LadderServer {
+ public:
+  LadderServer(const std::string& root, int bandwidth)
+      : root_(root), bandwidth_(bandwidth) {}
+
+  bool Start() {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      return false;
+    }
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        listen(listen_fd_, 16) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+                    &length) != 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+      return false;
+    }
+    port_ = ntohs(address.sin_port);
+    start_time_ = Clock::now();
+    accept_thread_ = std::thread(&LadderServer::AcceptLoop, this);
+    return true;
+  }
+
+  void Stop() {
+    is_stopping_ = true;
+    if (accept_thread_.joinable()) {
+      accept_thread_.join();
+    }
+    for (auto& thread : connection_threads_) {
+      thread.join();
+    }
+    connection_threads_.clear();
+    if (listen_fd_ >= 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+    }
+  }
+
+  int port() const { return port_; }
+
+  // Number of the segments requested for each variant.
+  std::map<std::string, int> GetSegmentCounts() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segment_counts_;
+  }
+
+ private:
+  void AcceptLoop() {
+    while (!is_stopping_) {
+      pollfd fds = {listen_fd_, POLLIN, 0};
+      if (poll(&fds, 1, 100) <= 0) {
+        continue;
+      }
+      const int fd = accept(listen_fd_, NULL, NULL);
+      if (fd >= 0) {
+        connection_threads_.emplace_back(&LadderServer::Serve, this, fd);
+      }
+    }
+  }
+
+  void Serve(int fd) {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos &&
+           request.size() < 8192) {
+      const auto size = recv(fd, buffer, sizeof(buffer), 0);
+      if (size <= 0) {
+        close(fd);
+        return;
+      }
+      request.append(buffer, size);
+    }
+
+    std::string method, path;
+    std::istringstream(request) >> method >> path;
+    path = path.substr(0, path.find('?'));
+    std::ifstream file;
+    if (method == "GET" && path.find("..") == std::string::npos) {
+      file.open(root_ + path, std::ios::binary);
+    }
+    if (!file.is_open()) {
+      SendAll(fd, "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n",
+              false);
+      close(fd);
+      return;
+    }
+    RecordRequest(path);
+
+    std::ostringstream body;
+    body << file.rdbuf();
+    const auto content = body.str();
+    const bool is_playlist =
+        path.size() > 5 && path.compare(path.size() - 5, 5, ".m3u8") == 0;
+    std::ostringstream header;
+    header << "HTTP/1.0 200 OK\r\n"
+           << "Content-Type: "
+           << (is_playlist ? "application/vnd.apple.mpegurl" : "video/mp2t")
+           << "\r\nContent-Length: " << content.size()
+           << "\r\nConnection: close\r\n\r\n";
+    if (SendAll(fd, header.str(), false)) {
+      SendAll(fd, content, true);
+    }
+    close(fd);
+  }
+
+  bool SendAll(int fd, const std::string& data, bool is_throttled) {
+    size_t offset = 0;
+    while (offset < data.size() && !is_stopping_) {
+      const auto size = std::min(kSendChunkSize, data.size() - offset);
+      if (is_throttled && bandwidth_ > 0) {
+        std::this_thread::sleep_until(ReserveSendTime(size));
+      }
+      const auto sent = send(fd, data.data() + offset, size, MSG_NOSIGNAL);
+      if (sent <= 0) {
+        return false;
+      }
+      offset += sent;
+    }
+    return offset == data.size();
+  }
+
+  Clock::time_point ReserveSendTime(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = Clock::now();
+    if (next_send_time_ < now) {
+      next_send_time_ = now;
+    }
+    const auto send_time = next_send_time_;
+    next_send_time_ += std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(size * 8.0 / (bandwidth_ * 1000.0)));
+    return send_time;
+  }
+
+  void RecordRequest(const std::string& path) {
+    for (const auto& variant : kVariants) {
+      const auto prefix = std::string("/") + variant.name + "_";
+      if (path.compare(0, prefix.size(), prefix) != 0) {
+        continue;
+      }
+      std::lock_guard<std::mutex> lock(mutex_);
+      segment_counts_[variant.name]++;
+      if (last_variant_ != variant.name) {
+        last_variant_ = variant.name;
+        printf("[%6.2f s] variant %s\n", ElapsedSec(start_time_),
+               variant.name);
+      }
+    }
+  }
+
+  const std::string root_;
+  const int bandwidth_;
+  int listen_fd_ = -1;
+  int port_ = 0;
+  std::atomic<bool> is_stopping_{false};
+  std::thread accept_thread_;
+  // Touched only by the accept thread until it's joined.
+  std::vector<std::thread> connection_threads_;
+  Clock::time_point start_time_;
+  Clock::time_point next_send_time_;
+  std::map<std::string, int> segment_counts_;
+  std::string last_variant_;
+  std::mutex mutex_;
+};
+
+// Prints the events of the player as the plugin sends them to Dart.
+class LoggingStreamHandler : public VideoPlayerStreamHandler {
+ public:
+  explicit LoggingStreamHandler(Clock::time_point start_time)
+      : start_time_(start_time) {}
+
+  bool IsCompleted() const { return is_completed_; }
+
+ protected:
+  // |VideoPlayerStreamHandler|
+  void OnNotifyInitializedInternal() override { Log("initialized"); }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyCompletedInternal() override {
+    Log("completed");
+    is_completed_ = true;
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyPlayingInternal(bool is_playing) override {
+    Log(is_playing ? "playing" : "paused");
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingStartInternal() override { Log("bufferingStart"); }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingUpdateInternal(int32_t percent) override {
+    printf("[%6.2f s] bufferingUpdate %d%%\n", ElapsedSec(start_time_),
+           percent);
+  }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyBufferingEndInternal() override { Log("bufferingEnd"); }
+
+  // |VideoPlayerStreamHandler|
+  void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                 int64_t jitter, double proportion) override {}
+
+ private:
+  void Log(const char* event) {
+    printf("[%6.2f s] %s\n", ElapsedSec(start_time_), event);
+  }
+
+  const Clock::time_point start_time_;
+  bool is_completed_ = false;
+};
+
+bool Play(const std::string& uri, uint32_t max_bitrate) {
+  const auto start_time = Clock::now();
+  auto handler = std::make_unique<LoggingStreamHandler>(start_time);
+  auto* handler_pointer = handler.get();
+  GstVideoPlayer player(uri, std::move(handler));
+  GstVideoPlayer::StreamingConfig config;
+  config.max_bitrate = max_bitrate;
+  player.SetStreamingConfig(config);
+  if (!player.AddOutput(nullptr) || !player.Init() || !player.Play()) {
+    fprintf(stderr, "Failed to play %s\n", uri.c_str());
+    return false;
+  }
+
+  while (!handler_pointer->IsCompleted() &&
+         Clock::now() - start_time < kPlayDuration) {
+    player.GetCurrentPosition();
+    std::this_thread::sleep_for(kPositionPollInterval);
+  }
+
+  // Buffering before the first frame is a part of the startup latency.
+  const auto stats = player.GetStreamingStats();
+  printf("startup latency: %.2f s, rebuffering: %d times, %.2f s\n",
+         stats.startup_latency / 1000.0, stats.rebuffer_count,
+         stats.rebuffer_duration / 1000.0);
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr,
+            "Usage: %s <ladder dir> [max bitrate in bps] [bandwidth in kbps]\n",
+            argv[0]);
+    return 1;
+  }
+  const std::string dir = argv[1];
+  const uint32_t max_bitrate =
+      argc > 2 ? strtoul(argv[2], NULL, 10) : kDefaultMaxBitrate;
+  const int bandwidth = argc > 3 ? atoi(argv[3]) : kDefaultBandwidth;
+
+  gst_init(&argc, &argv);
+  auto* version = gst_version_string();
+  printf("%s\n", version);
+  g_free(version);
+  if (!GenerateLadder(dir)) {
+    gst_deinit();
+    return 1;
+  }
+
+  LadderServer server(dir, bandwidth);
+  if (!server.Start()) {
+    fprintf(stderr, "Failed to start the HTTP server\n");
+    gst_deinit();
+    return 1;
+  }
+  const auto uri =
+      "http://127.0.0.1:" + std::to_string(server.port()) + "/master.m3u8";
+  printf("Playing %s (max bitrate %u bps, bandwidth %d kbps)\n", uri.c_str(),
+         max_bitrate, bandwidth);
+  const bool result = Play(uri, max_bitrate);
+  server.Stop();
+
+  // The cap is respected if no segment above it was requested.
+  bool is_capped = true;
+  const auto segment_counts = server.GetSegmentCounts();
+  for (const auto& variant : kVariants) {
+    auto itr = segment_counts.find(variant.name);
+    const int count = itr != segment_counts.end() ? itr->second : 0;
+    printf("%s (%d kbps): %d segments\n", variant.name, variant.bitrate,
+           count);
+    if (max_bitrate > 0 && variant.bitrate * 1000u > max_bitrate &&
+        count > 0) {
+      is_capped = false;
+    }
+  }
+  if (max_bitrate > 0) {
+    printf("bitrate cap: %s\n", is_capped ? "respected" : "exceeded");
+  }
+  gst_deinit();
+  return result && is_capped ? 0 : 1;
+}
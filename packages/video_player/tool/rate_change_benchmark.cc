@@ -0,0 +1,173 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the time to apply a playback rate change while playing with
+// GstVideoPlayer::SetPlaybackRate(). It uses an instant rate change
+// (GST_SEEK_FLAG_INSTANT_RATE_CHANGE) if possible, and a flushing seek with
+// pitch correction enabled on a stream with audio, since scaletempo follows
+// only the rate of the segment. The rate is switched between 1.0 and 1.5,
+// and the time from the call to the next frame of the video output and the
+// longest gap between the frames around the change are reported.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o rate_change_benchmark
+//       rate_change_benchmark.cc ../elinux/gst_video_player.cc
+//       ../elinux/gst_video_output.cc ../elinux/media_cache.cc
+//       $(pkg-config --cflags --libs gstreamer-1.0 gstreamer-app-1.0
+//         gstreamer-video-1.0) -lpthread
+//   (in one line)
+//   $ ./rate_change_benchmark <uri> [iterations]
+
+#include <gst/gst.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "gst_video_player.h"
+#include "video_player_stream_handler.h"
+
+namespace {
+constexpr int kDefaultIterations = 20;
+// Interval between the rate changes, in which the gaps between the frames
+// are observed.
+constexpr auto kChangeInterval = std::chrono::milliseconds(1000);
+
+using Clock = std::chrono::steady_clock;
+
+struct FrameMonitor {
+  std::mutex mutex;
+  std::condition_variable cond;
+  int64_t frame_count = 0;
+  Clock::time_point last_frame_time;
+  Clock::duration max_gap{0};
+};
+
+struct Result {
+  int count = 0;
+  int failed = 0;
+  double total_apply_ms = 0;
+  double max_apply_ms = 0;
+  double max_gap_ms = 0;
+};
+
+// The events of the player aren't measured.
+class NullStreamHandler : public VideoPlayerStreamHandler {
+ protected:
+  // |VideoPlayerStreamHandler|
+  void OnNotifyInitializedInternal() override {}
+  void OnNotifyCompletedInternal() override {}
+  void OnNotifyPlayingInternal(bool is_playing) override {}
+  void OnNotifyBufferingStartInternal() override {}
+  void OnNotifyBufferingUpdateInternal(int32_t percent) override {}
+  void OnNotifyBufferingEndInternal() override {}
+  void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                 int64_t jitter, double proportion) override {}
+};
+
+void OnFrameDecoded(FrameMonitor* monitor) {
+  std::lock_guard<std::mutex> lock(monitor->mutex);
+  const auto now = Clock::now();
+  if (monitor->frame_count > 0) {
+    monitor->max_gap =
+        std::max(monitor->max_gap, now - monitor->last_frame_time);
+  }
+  monitor->last_frame_time = now;
+  monitor->frame_count++;
+  monitor->cond.notify_all();
+}
+
+Result Measure(const char* uri, int iterations, bool pitch_correction) {
+  Result result;
+  FrameMonitor monitor;
+  GstVideoPlayer player(uri, std::make_unique<NullStreamHandler>());
+  player.SetPitchCorrection(pitch_correction);
+  if (!player.AddOutput([&monitor]() { OnFrameDecoded(&monitor); }) ||
+      !player.Init() || !player.Play()) {
+    fprintf(stderr, "Failed to play %s\n", uri);
+    result.failed = iterations;
+    return result;
+  }
+  std::this_thread::sleep_for(kChangeInterval);
+
+  for (int i = 0; i < iterations; i++) {
+    const double rate = (i % 2 == 0) ? 1.5 : 1.0;
+    int64_t frame_count;
+    {
+      std::lock_guard<std::mutex> lock(monitor.mutex);
+      frame_count = monitor.frame_count;
+      monitor.max_gap = Clock::duration::zero();
+    }
+
+    const auto start = Clock::now();
+    if (!player.SetPlaybackRate(rate)) {
+      result.failed++;
+      std::this_thread::sleep_for(kChangeInterval);
+      continue;
+    }
+    {
+      std::unique_lock<std::mutex> lock(monitor.mutex);
+      if (!monitor.cond.wait_for(lock, kChangeInterval, [&] {
+            return monitor.frame_count > frame_count;
+          })) {
+        result.failed++;
+        continue;
+      }
+      const double apply_ms =
+          std::chrono::duration<double, std::milli>(monitor.last_frame_time -
+                                                    start)
+              .count();
+      result.count++;
+      result.total_apply_ms += apply_ms;
+      result.max_apply_ms = std::max(result.max_apply_ms, apply_ms);
+    }
+
+    std::this_thread::sleep_for(kChangeInterval);
+    // Dispatches the events queued by the player as the plugin does.
+    player.GetCurrentPosition();
+    std::lock_guard<std::mutex> lock(monitor.mutex);
+    result.max_gap_ms = std::max(
+        result.max_gap_ms,
+        std::chrono::duration<double, std::milli>(monitor.max_gap).count());
+  }
+  return result;
+}
+
+void PrintResult(const char* name, const Result& result) {
+  if (result.count == 0) {
+    printf("%s: not supported (%d failed)\n", name, result.failed);
+    return;
+  }
+  printf("%s: apply avg %.1f ms, max %.1f ms, max frame gap %.1f ms", name,
+         result.total_apply_ms / result.count, result.max_apply_ms,
+         result.max_gap_ms);
+  if (result.failed > 0) {
+    printf(" (%d failed)", result.failed);
+  }
+  printf("\n");
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <uri> [iterations]\n", argv[0]);
+    return 1;
+  }
+  const int iterations = argc > 2 ? atoi(argv[2]) : kDefaultIterations;
+
+  gst_init(&argc, &argv);
+  auto* version = gst_version_string();
+  printf("%s\n", version);
+  g_free(version);
+  PrintResult("instant rate change", Measure(argv[1], iterations, false));
+  PrintResult("flushing seek (pitch correction)",
+              Measure(argv[1], iterations, true));
+  gst_deinit();
+  return 0;
+}
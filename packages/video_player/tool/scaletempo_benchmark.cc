@@ -0,0 +1,119 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the CPU cost of the pitch correction of GstVideoPlayer. A media
+// with audio is played for a while at several rates with and without pitch
+// correction, and the CPU time of the process per second of the played media
+// is reported. The video is decoded in both cases, so the difference is the
+// cost of scaletempo. At 1.0x, the player doesn't link scaletempo. The rates
+// are kept within 0.5x to 2.0x, where the audio isn't muted without pitch
+// correction.
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o scaletempo_benchmark
+//       scaletempo_benchmark.cc ../elinux/gst_video_player.cc
+//       ../elinux/gst_video_output.cc ../elinux/media_cache.cc
+//       $(pkg-config --cflags --libs gstreamer-1.0 gstreamer-app-1.0
+//         gstreamer-video-1.0) -lpthread
+//   (in one line)
+//   $ ./scaletempo_benchmark <uri> [seconds per rate]
+
+#include <gst/gst.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gst_video_player.h"
+#include "video_player_stream_handler.h"
+
+namespace {
+constexpr int kDefaultSeconds = 10;
+constexpr auto kPositionPollInterval = std::chrono::milliseconds(100);
+
+// The events of the player aren't measured.
+class NullStreamHandler : public VideoPlayerStreamHandler {
+ protected:
+  // |VideoPlayerStreamHandler|
+  void OnNotifyInitializedInternal() override {}
+  void OnNotifyCompletedInternal() override {}
+  void OnNotifyPlayingInternal(bool is_playing) override {}
+  void OnNotifyBufferingStartInternal() override {}
+  void OnNotifyBufferingUpdateInternal(int32_t percent) override {}
+  void OnNotifyBufferingEndInternal() override {}
+  void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                 int64_t jitter, double proportion) override {}
+};
+
+double GetProcessCpuTimeMs() {
+  struct timespec time;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+// Returns the CPU time in msec per second of the played media, or a
+// negative value on errors.
+double Measure(const char* uri, int seconds, double rate,
+               bool pitch_correction) {
+  GstVideoPlayer player(uri, std::make_unique<NullStreamHandler>());
+  player.SetPitchCorrection(pitch_correction);
+  if (!player.AddOutput(nullptr) || !player.Init() ||
+      !player.SetPlaybackRate(rate) || !player.Play()) {
+    fprintf(stderr, "Failed to play %s at the rate %.2f\n", uri, rate);
+    return -1;
+  }
+
+  // The position is polled as the plugin does, which also dispatches the
+  // events of the player.
+  const int64_t start_position = player.GetCurrentPosition();
+  const double start = GetProcessCpuTimeMs();
+  const auto end_time = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(seconds);
+  int64_t position = start_position;
+  while (std::chrono::steady_clock::now() < end_time) {
+    std::this_thread::sleep_for(kPositionPollInterval);
+    const auto current = player.GetCurrentPosition();
+    if (current < position) {
+      // Reached the end.
+      break;
+    }
+    position = current;
+  }
+  const double elapsed = GetProcessCpuTimeMs() - start;
+
+  if (start_position < 0 || position <= start_position) {
+    fprintf(stderr, "Failed to play %s at the rate %.2f\n", uri, rate);
+    return -1;
+  }
+  return elapsed * 1000.0 / (position - start_position);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <uri> [seconds per rate]\n", argv[0]);
+    return 1;
+  }
+  const int seconds = argc > 2 ? atoi(argv[2]) : kDefaultSeconds;
+  if (seconds <= 0) {
+    fprintf(stderr, "Usage: %s <uri> [seconds per rate]\n", argv[0]);
+    return 1;
+  }
+
+  GstVideoPlayer::GstLibraryLoad();
+  printf("CPU time per second of media:\n");
+  printf("  bypassed (1.00x): %.2f ms\n",
+         Measure(argv[1], seconds, 1.0, true));
+  for (const double rate : {0.5, 0.75, 1.5, 2.0}) {
+    const double without = Measure(argv[1], seconds, rate, false);
+    const double with = Measure(argv[1], seconds, rate, true);
+    printf("  %.2fx: %.2f ms, with scaletempo: %.2f ms\n", rate, without,
+           with);
+  }
+  GstVideoPlayer::GstLibraryUnload();
+  return 0;
+}
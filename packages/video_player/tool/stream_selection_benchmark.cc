@@ -0,0 +1,143 @@
+// Copyright 2026 Sony Group Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the CPU cost of the streams rendered by GstVideoPlayer. A media
+// file is played for a while with each stream selection, and the CPU time of
+// the process per second of the played media is reported.
+//   default:      StreamSelection defaults (video, audio, text)
+//   no text:      StreamSelection::text = false
+//   native:       StreamSelection::native_video/native_audio = true
+//   volume 0:     the audio branch removed by SetVolume(0)
+//   video only:   StreamSelection::video_only = true, which also skips
+//                 decoding the audio
+//
+// Build and run:
+//   $ g++ -std=c++17 -O2 -I../elinux -o stream_selection_benchmark
+//       stream_selection_benchmark.cc ../elinux/gst_video_player.cc
+//       ../elinux/gst_video_output.cc ../elinux/media_cache.cc
+//       $(pkg-config --cflags --libs gstreamer-1.0 gstreamer-app-1.0
+//         gstreamer-video-1.0) -lpthread
+//   (in one line)
+//   $ ./stream_selection_benchmark <uri> [seconds per selection]
+
+#include <gst/gst.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gst_video_player.h"
+#include "video_player_stream_handler.h"
+
+namespace {
+constexpr int kDefaultSeconds = 10;
+constexpr auto kPositionPollInterval = std::chrono::milliseconds(100);
+
+struct Selection {
+  const char* name;
+  GstVideoPlayer::StreamSelection stream_selection;
+  double volume;
+};
+
+// The events of the player aren't measured.
+class NullStreamHandler : public VideoPlayerStreamHandler {
+ protected:
+  // |VideoPlayerStreamHandler|
+  void OnNotifyInitializedInternal() override {}
+  void OnNotifyCompletedInternal() override {}
+  void OnNotifyPlayingInternal(bool is_playing) override {}
+  void OnNotifyBufferingStartInternal() override {}
+  void OnNotifyBufferingUpdateInternal(int32_t percent) override {}
+  void OnNotifyBufferingEndInternal() override {}
+  void OnNotifyQosUpdateInternal(uint64_t processed, uint64_t dropped,
+                                 int64_t jitter, double proportion) override {}
+};
+
+double GetProcessCpuTimeMs() {
+  struct timespec time;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+  return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+// Returns the CPU time in msec per second of the played media, or a
+// negative value on errors.
+double Measure(const char* uri, int seconds, const Selection& selection) {
+  GstVideoPlayer player(uri, std::make_unique<NullStreamHandler>());
+  player.SetStreamSelection(selection.stream_selection);
+  if (!player.AddOutput(nullptr) || !player.Init() ||
+      !player.SetVolume(selection.volume) || !player.Play()) {
+    fprintf(stderr, "Failed to play %s with %s\n", uri, selection.name);
+    return -1;
+  }
+
+  // The position is polled as the plugin does, which also dispatches the
+  // events of the player.
+  const int64_t start_position = player.GetCurrentPosition();
+  const double start = GetProcessCpuTimeMs();
+  const auto end_time = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(seconds);
+  int64_t position = start_position;
+  while (std::chrono::steady_clock::now() < end_time) {
+    std::this_thread::sleep_for(kPositionPollInterval);
+    const auto current = player.GetCurrentPosition();
+    if (current < position) {
+      // Reached the end.
+      break;
+    }
+    position = current;
+  }
+  const double elapsed = GetProcessCpuTimeMs() - start;
+
+  if (start_position < 0 || position <= start_position) {
+    fprintf(stderr, "Failed to play %s with %s\n", uri, selection.name);
+    return -1;
+  }
+  return elapsed * 1000.0 / (position - start_position);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <uri> [seconds per selection]\n", argv[0]);
+    return 1;
+  }
+  const int seconds = argc > 2 ? atoi(argv[2]) : kDefaultSeconds;
+  if (seconds <= 0) {
+    fprintf(stderr, "Usage: %s <uri> [seconds per selection]\n", argv[0]);
+    return 1;
+  }
+
+  GstVideoPlayer::GstLibraryLoad();
+  GstVideoPlayer::StreamSelection no_text;
+  no_text.text = false;
+  GstVideoPlayer::StreamSelection native;
+  native.native_video = true;
+  native.native_audio = true;
+  GstVideoPlayer::StreamSelection video_only;
+  video_only.video_only = true;
+  const Selection selections[] = {
+      {"default", GstVideoPlayer::StreamSelection(), 1.0},
+      {"no text", no_text, 1.0},
+      {"native", native, 1.0},
+      {"volume 0", GstVideoPlayer::StreamSelection(), 0.0},
+      {"video only", video_only, 1.0},
+  };
+  printf("CPU time per second of media:\n");
+  const double baseline = Measure(argv[1], seconds, selections[0]);
+  printf("  %-10s: %.2f ms\n", selections[0].name, baseline);
+  for (size_t i = 1; i < G_N_ELEMENTS(selections); i++) {
+    const double cost = Measure(argv[1], seconds, selections[i]);
+    if (cost < 0 || baseline <= 0) {
+      printf("  %-10s: %.2f ms\n", selections[i].name, cost);
+      continue;
+    }
+    printf("  %-10s: %.2f ms (%.1f%% saved)\n", selections[i].name, cost,
+           (baseline - cost) * 100 / baseline);
+  }
+  GstVideoPlayer::GstLibraryUnload();
+  return 0;
+}